@@ -17,6 +17,8 @@
 #define BOOST_TEST_MODULE color
 
 #include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <iterator>
 #include <string>
 #include <fstream>
 #include <sstream>
@@ -457,3 +459,54 @@ BOOST_AUTO_TEST_CASE(SubtractionErrorUnfoldingNonEmptyMarking, * utf::timeout(2)
     );
 }
 
+
+// the places and unfolded transitions, with the names of their places, which do not depend on the indexes;
+// a multiset so an element unfolded twice is not hidden
+std::multiset<std::string> unfoldedNet(const char* model, uint32_t threads, bool lazy) {
+    shared_string_set sset;
+    ColoredPetriNetBuilder cpnBuilder(sset);
+    auto f = loadFile(model);
+    cpnBuilder.parse_model(f);
+    auto [builder, trans_names, place_names] = unfold(cpnBuilder, true, true, true, std::cerr,
+        5, 500, 5, 10, false, false, threads, lazy);
+    std::unique_ptr<PetriNet> net{builder.makePetriNet(false)};
+    std::multiset<std::string> lines;
+    for (uint32_t p = 0; p < net->numberOfPlaces(); ++p)
+        lines.insert(*net->placeNames()[p] + " " + std::to_string(net->initial(p)));
+    for (uint32_t t = 0; t < net->numberOfTransitions(); ++t) {
+        std::multiset<std::string> pre, post;
+        for (auto [it, end] = net->preset(t); it != end; ++it)
+            pre.insert(*net->placeNames()[it->place] + "/" + std::to_string(it->tokens) + (it->inhibitor ? "o" : ""));
+        for (auto [it, end] = net->postset(t); it != end; ++it)
+            post.insert(*net->placeNames()[it->place] + "/" + std::to_string(it->tokens));
+        std::string line = *net->transitionNames()[t] + ":";
+        for (auto& a : pre) line += " " + a;
+        line += " ->";
+        for (auto& a : post) line += " " + a;
+        lines.insert(line);
+    }
+    return lines;
+}
+
+BOOST_AUTO_TEST_CASE(ParallelUnfolding, * utf::timeout(60)) {
+    auto sequential = unfoldedNet("/models/Peterson-COL-2/model.pnml", 1, false);
+    BOOST_REQUIRE(!sequential.empty());
+    BOOST_REQUIRE(sequential == unfoldedNet("/models/Peterson-COL-2/model.pnml", 4, false));
+}
+
+BOOST_AUTO_TEST_CASE(LazyUnfolding, * utf::timeout(60)) {
+    // the lazy unfolding leaves out the two transitions reading a place which is never marked,
+    // and that place, which no transition is left to use
+    auto full = unfoldedNet("/models/NeoElection-COL-3/model.pnml", 1, false);
+    auto lazy = unfoldedNet("/models/NeoElection-COL-3/model.pnml", 1, true);
+    BOOST_REQUIRE(std::includes(full.begin(), full.end(), lazy.begin(), lazy.end()));
+    std::vector<std::string> missing;
+    std::set_difference(full.begin(), full.end(), lazy.begin(), lazy.end(), std::back_inserter(missing));
+    std::vector<std::string> expected{
+        "P-masterState_3 0",
+        "T-poll__handleAskP_10: P-masterState_3/1 P-network_11/1 P-poll__handlingMessage_3/1 -> "
+        "P-masterState_3/1 P-network_30/1 P-poll__pollEnd_3/1",
+        "T-poll__handleAskP_8: P-masterState_3/1 P-network_7/1 P-poll__handlingMessage_3/1 -> "
+        "P-masterState_3/1 P-network_29/1 P-poll__pollEnd_3/1"};
+    BOOST_REQUIRE_EQUAL_COLLECTIONS(missing.begin(), missing.end(), expected.begin(), expected.end());
+}
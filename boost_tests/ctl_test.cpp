@@ -0,0 +1,122 @@
+/* Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE ctl
+
+#include <boost/test/unit_test.hpp>
+#include <string>
+#include <fstream>
+#include <sstream>
+
+#include "utils.h"
+#include "CTL/CTLResult.h"
+#include "CTL/CTLEngine.h"
+
+using namespace PetriEngine;
+using namespace PetriEngine::PQL;
+namespace utf = boost::unit_test;
+
+BOOST_AUTO_TEST_CASE(DirectoryTest) {
+    BOOST_REQUIRE(getenv("TEST_FILES"));
+}
+
+BOOST_AUTO_TEST_CASE(AngiogenesisPT01ParallelCTL, * utf::timeout(300)) {
+
+    const std::set<size_t> qnums{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    for (auto queries : {"/models/Angiogenesis-PT-01/CTLCardinality.xml", "/models/Angiogenesis-PT-01/CTLFireability.xml"}) {
+        auto [pn, conditions, qstrings] = load_pn("/models/Angiogenesis-PT-01/model.pnml",
+            queries, qnums, TemporalLogic::CTL);
+
+        for (size_t i = 0; i < conditions.size(); ++i) {
+            AsCTL v;
+            Visitor::visit(v, conditions[i]);
+            auto q = pushNegation(v._ctl_query);
+            for (auto strategy : {Strategy::DFS, Strategy::BFS}) {
+                std::cerr << queries << " Q[" << i << "] strategy=" << to_underlying(strategy) << std::endl;
+                CTLResult sequential(q);
+                CTLResult parallel(q);
+                auto expected = CTLSingleSolve(q.get(), pn.get(), CTL::CZero, strategy, false, sequential);
+                auto result = CTLSingleSolve(q.get(), pn.get(), CTL::CZero, strategy, false, parallel, 4);
+                BOOST_REQUIRE_EQUAL(expected, result);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(AngiogenesisPT01SharedMarkings, * utf::timeout(300)) {
+
+    const std::set<size_t> qnums{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    for (auto queries : {"/models/Angiogenesis-PT-01/CTLCardinality.xml", "/models/Angiogenesis-PT-01/CTLFireability.xml"}) {
+        auto [pn, conditions, qstrings] = load_pn("/models/Angiogenesis-PT-01/model.pnml",
+            queries, qnums, TemporalLogic::CTL);
+
+        // one store for all queries, as CTLMain does
+        auto markings = std::make_shared<Structures::MarkingStore>(4 * 64);
+        for (size_t i = 0; i < conditions.size(); ++i) {
+            AsCTL v;
+            Visitor::visit(v, conditions[i]);
+            auto q = pushNegation(v._ctl_query);
+            std::cerr << queries << " Q[" << i << "]" << std::endl;
+            CTLResult own(q);
+            CTLResult shared(q);
+            auto expected = CTLSingleSolve(q.get(), pn.get(), CTL::CZero, Strategy::DFS, false, own);
+            auto result = CTLSingleSolve(q.get(), pn.get(), CTL::CZero, Strategy::DFS, false, shared, 4, markings);
+            BOOST_REQUIRE_EQUAL(expected, result);
+        }
+        BOOST_REQUIRE_GT(markings->size(), 0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(AngiogenesisPT01CTLMainSharedMarkings, * utf::timeout(300)) {
+    // CTLMain shares its marking store with the reachability searches of recursiveSolve and solveLogicalCondition
+    const std::set<size_t> qnums{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    for (auto queries : {"/models/Angiogenesis-PT-01/CTLCardinality.xml", "/models/Angiogenesis-PT-01/CTLFireability.xml"}) {
+        auto [pn, conditions, qstrings] = load_pn("/models/Angiogenesis-PT-01/model.pnml",
+            queries, qnums, TemporalLogic::CTL);
+
+        std::vector<Condition_ptr> ctl;
+        std::vector<std::string> names;
+        std::vector<size_t> numbers;
+        std::map<std::string, bool> expected;
+        for (size_t i = 0; i < conditions.size(); ++i) {
+            AsCTL v;
+            Visitor::visit(v, conditions[i]);
+            ctl.push_back(pushNegation(v._ctl_query));
+            names.push_back("Q" + std::to_string(i));
+            numbers.push_back(i);
+            CTLResult own(ctl.back());
+            expected[names.back()] = CTLSingleSolve(ctl.back().get(), pn.get(), CTL::CZero, Strategy::DFS, false, own);
+        }
+
+        for (uint32_t cores : {1, 4}) {
+            options_t options;
+            options.cores = cores;
+            options.strategy = Strategy::DFS;
+            std::stringstream out;
+            auto* cout = std::cout.rdbuf(out.rdbuf());
+            CTLMain(pn.get(), CTL::CZero, Strategy::DFS, StatisticsLevel::None, false, names, ctl, numbers, options);
+            std::cout.rdbuf(cout);
+
+            std::map<std::string, bool> results;
+            std::string word, name, answer;
+            while (out >> word) {
+                if (word == "FORMULA" && out >> name >> answer)
+                    results[name] = answer == "TRUE";
+            }
+            BOOST_REQUIRE(expected == results);
+        }
+    }
+}
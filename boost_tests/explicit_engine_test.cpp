@@ -37,3 +37,54 @@ BOOST_AUTO_TEST_CASE(SubtractionWithVars, * utf::timeout(5)) {
 BOOST_AUTO_TEST_CASE(ReferendumColoredSubtraction, * utf::timeout(5)) {
     test_explicit_engine("referendum_colored_subtraction", ExplicitColoredModelChecker::Result::SATISFIED);
 }
+
+BOOST_AUTO_TEST_CASE(BatchOfQueries, * utf::timeout(60)) {
+    std::set<size_t> qnums{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    auto [queries, querynames, sset, options] = load_explicit(
+        "/models/Peterson-COL-2/model.pnml", "/models/Peterson-COL-2/ReachabilityCardinality.xml", qnums);
+
+    ExplicitColoredModelChecker checker(sset, std::cout);
+    // The heuristic search is guided by the next undecided query once the first one is decided
+    for (const auto strategy : {Strategy::DFS, Strategy::HEUR}) {
+        options.strategy = strategy;
+        auto results = checker.checkQueries(queries, options);
+
+        BOOST_REQUIRE_EQUAL(queries.size(), results.size());
+        for (size_t i = 0; i < queries.size(); ++i) {
+            BOOST_REQUIRE_EQUAL(checker.checkQuery(queries[i], options), results[i]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(EncodedWaitingList, * utf::timeout(60)) {
+    std::set<size_t> qnums{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    auto [queries, querynames, sset, options] = load_explicit(
+        "/models/Peterson-COL-2/model.pnml", "/models/Peterson-COL-2/ReachabilityCardinality.xml", qnums);
+
+    ExplicitColoredModelChecker checker(sset, std::cout);
+    for (const auto strategy : {Strategy::BFS, Strategy::DFS, Strategy::RDFS, Strategy::HEUR}) {
+        options.strategy = strategy;
+        options.colored_encoded_waiting_list = false;
+        auto expected = checker.checkQueries(queries, options);
+        options.colored_encoded_waiting_list = true;
+        auto results = checker.checkQueries(queries, options);
+        BOOST_REQUIRE(expected == results);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(EncodedWaitingListTooBigToEncode, * utf::timeout(60)) {
+    // Filling ten places of 1700 colours with 66000 tokens each gives a state above the 16-bit encoding limit,
+    // it must still be expanded with its full marking for Done to be reachable
+    std::set<size_t> qnums{0};
+    auto [queries, querynames, sset, options] = load_explicit(
+        "/models/explicit-engine/big_encoding.pnml", "/models/explicit-engine/big_encoding.xml", qnums);
+
+    ExplicitColoredModelChecker checker(sset, std::cout);
+    for (const auto strategy : {Strategy::BFS, Strategy::DFS}) {
+        options.strategy = strategy;
+        options.colored_encoded_waiting_list = false;
+        BOOST_REQUIRE_EQUAL(checker.checkQuery(queries[0], options), ExplicitColoredModelChecker::Result::SATISFIED);
+        options.colored_encoded_waiting_list = true;
+        BOOST_REQUIRE_EQUAL(checker.checkQuery(queries[0], options), ExplicitColoredModelChecker::Result::SATISFIED);
+    }
+}
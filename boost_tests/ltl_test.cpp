@@ -20,9 +20,14 @@
 #include <string>
 #include <fstream>
 #include <sstream>
+#include <set>
+#include <vector>
 
 #include "utils.h"
 #include "LTL/LTLSearch.h"
+#include "LTL/LTLToBuchi.h"
+#include "LTL/SuccessorGeneration/BuchiSuccessorGenerator.h"
+#include "PetriEngine/SuccessorGenerator.h"
 #include "CTL/SearchStrategy/HeuristicSearch.h"
 
 using namespace PetriEngine;
@@ -137,4 +142,171 @@ BOOST_AUTO_TEST_CASE(AngiogenesisPT01LTLFireability, * utf::timeout(300)) {
             }
         }
     }
-}
\ No newline at end of file
+}
+BOOST_AUTO_TEST_CASE(AngiogenesisPT01ParallelLTLCardinality, * utf::timeout(300)) {
+
+    const std::set<size_t> qnums{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    const std::vector<Reachability::ResultPrinter::Result> expected{
+        ResultPrinter::NotSatisfied,
+        ResultPrinter::NotSatisfied,
+        ResultPrinter::NotSatisfied,
+        ResultPrinter::NotSatisfied,
+        ResultPrinter::Satisfied,
+        ResultPrinter::Satisfied,
+        ResultPrinter::Satisfied,
+        ResultPrinter::NotSatisfied,
+        ResultPrinter::NotSatisfied,
+        ResultPrinter::NotSatisfied,
+        ResultPrinter::NotSatisfied,
+        ResultPrinter::NotSatisfied,
+        ResultPrinter::NotSatisfied,
+        ResultPrinter::NotSatisfied,
+        ResultPrinter::NotSatisfied,
+        ResultPrinter::NotSatisfied};
+
+    auto [pn, conditions, qstrings] = load_pn("/models/Angiogenesis-PT-01/model.pnml",
+        "/models/Angiogenesis-PT-01/LTLCardinality.xml", qnums, TemporalLogic::LTL);
+
+    for (auto i : qnums) {
+        for (bool trace :{false, true}) {
+            for(auto alg : { LTL::Algorithm::NDFS, LTL::Algorithm::Tarjan})
+            {
+                for(auto por : { LTL::LTLPartialOrder::None, LTL::LTLPartialOrder::Liebke,
+                    LTL::LTLPartialOrder::Visible, LTL::LTLPartialOrder::Automaton})
+                {
+                    if(alg == LTL::Algorithm::NDFS && por != LTL::LTLPartialOrder::None)
+                        continue;
+                    for(auto heur : { LTL::LTLHeuristic::DFS, LTL::LTLHeuristic::Automaton})
+                    {
+                        std::cerr << "Q[" << i << "] trace=" << std::boolalpha << trace
+                            << " por=" << to_underlying(por) << " alg=" << to_underlying(alg) << " heur=" << to_underlying(heur) << std::endl;
+                        Strategy strategy = heur == LTL::LTLHeuristic::DFS ? Strategy::DFS : Strategy::HEUR;
+                        LTL::LTLSearch search(*pn, conditions[i], LTL::BuchiOptimization::Low, LTL::APCompression::None);
+                        auto r = search.solve(trace, 0, alg, por, strategy, heur, true, 0, 4);
+                        auto result = r ? ResultPrinter::Satisfied : ResultPrinter::NotSatisfied;
+                        BOOST_REQUIRE_EQUAL(expected[i], result);
+                    }
+                }
+            }
+        }
+    }
+}
+
+namespace {
+    // the path formula of an LTL query, which the Büchi automaton is built from
+    PQL::Condition_ptr path_formula(const PQL::Condition_ptr& query)
+    {
+        if (auto a = std::dynamic_pointer_cast<PQL::ACondition>(query))
+            return (*a)[0];
+        if (auto e = std::dynamic_pointer_cast<PQL::ECondition>(query))
+            return (*e)[0];
+        return query;
+    }
+
+    // the first markings reached by breadth-first search from the initial marking
+    std::vector<std::vector<MarkVal>> reachable_markings(const PetriNet& net, size_t max)
+    {
+        std::vector<std::vector<MarkVal>> markings;
+        std::set<std::vector<MarkVal>> seen;
+        SuccessorGenerator generator(net);
+        Structures::State state(net.makeInitialMarking());
+        Structures::State working(net.makeInitialMarking());
+        markings.emplace_back(state.marking(), state.marking() + net.numberOfPlaces());
+        seen.insert(markings.back());
+        for (size_t i = 0; i < markings.size() && markings.size() < max; ++i) {
+            std::copy(markings[i].begin(), markings[i].end(), state.marking());
+            generator.prepare(state);
+            while (generator.next(working) && markings.size() < max) {
+                std::vector<MarkVal> m(working.marking(), working.marking() + net.numberOfPlaces());
+                if (seen.insert(m).second)
+                    markings.push_back(std::move(m));
+            }
+        }
+        return markings;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(AngiogenesisPT01BuchiGuardCubes, * utf::timeout(300)) {
+
+    const std::set<size_t> qnums{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    size_t multi_cube_guards = 0;
+    for (auto queries : {"/models/Angiogenesis-PT-01/LTLCardinality.xml",
+                         "/models/Angiogenesis-PT-01/LTLFireability.xml"}) {
+        auto [pn, conditions, qstrings] = load_pn("/models/Angiogenesis-PT-01/model.pnml",
+            queries, qnums, TemporalLogic::LTL);
+        const auto markings = reachable_markings(*pn, 500);
+
+        for (auto i : qnums) {
+            for (auto compression : {LTL::APCompression::None, LTL::APCompression::Full}) {
+                LTL::BuchiSuccessorGenerator generator(LTL::make_buchi_automaton(
+                    path_formula(conditions[i]), LTL::BuchiOptimization::Low, compression));
+                const auto& automaton = generator.automaton();
+                for (auto& marking : markings) {
+                    PQL::EvaluationContext ctx{marking.data(), pn.get()};
+                    for (size_t state = 0; state < automaton.buchi().num_states(); ++state) {
+                        generator.prepare(state);
+                        size_t dst;
+                        const bdd* cond;
+                        while (generator.next(dst, cond)) {
+                            if (&marking == &markings.front() && bdd_pathcount(*cond) > 1)
+                                ++multi_cube_guards;
+                            // the compiled cubes must agree with walking the BDD of the guard
+                            BOOST_REQUIRE_EQUAL(automaton.guard_valid(ctx, *cond),
+                                                generator.guard_valid(*pn, marking.data()));
+                        }
+                    }
+                }
+            }
+        }
+    }
+    // guards with several cubes, where the valuation is shared between cubes, must be covered
+    BOOST_REQUIRE_GT(multi_cube_guards, 0);
+}
+
+BOOST_AUTO_TEST_CASE(AngiogenesisPT01BuchiResume, * utf::timeout(300)) {
+
+    const std::set<size_t> qnums{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    auto [pn, conditions, qstrings] = load_pn("/models/Angiogenesis-PT-01/model.pnml",
+        "/models/Angiogenesis-PT-01/LTLFireability.xml", qnums, TemporalLogic::LTL);
+    const auto markings = reachable_markings(*pn, 100);
+
+    struct edge_t {
+        size_t _edge;
+        size_t _dest;
+        bool _valid;
+    };
+    for (auto i : qnums) {
+        LTL::BuchiSuccessorGenerator generator(LTL::make_buchi_automaton(
+            path_formula(conditions[i]), LTL::BuchiOptimization::Low, LTL::APCompression::None));
+        const auto nstates = generator.automaton().buchi().num_states();
+        for (size_t m = 0; m < markings.size(); ++m) {
+            const auto& marking = markings[m];
+            const auto& other = markings[(m + 1) % markings.size()];
+            for (size_t state = 0; state < nstates; ++state) {
+                std::vector<edge_t> edges;
+                generator.prepare(state);
+                size_t dst;
+                const bdd* cond;
+                while (generator.next(dst, cond))
+                    edges.push_back({generator.edge(), dst, generator.guard_valid(*pn, marking.data())});
+
+                // resuming after an edge continues with the rest of the edges, also when several
+                // edges share a destination, and evaluates the guards afresh for the marking
+                for (size_t e = 0; e < edges.size(); ++e) {
+                    // leave the valuation of another marking behind
+                    generator.prepare(state);
+                    while (generator.next(dst, cond))
+                        generator.guard_valid(*pn, other.data());
+                    generator.resume(state, edges[e]._edge);
+                    for (size_t rest = e + 1; rest < edges.size(); ++rest) {
+                        BOOST_REQUIRE(generator.next(dst, cond));
+                        BOOST_REQUIRE_EQUAL(edges[rest]._edge, generator.edge());
+                        BOOST_REQUIRE_EQUAL(edges[rest]._dest, dst);
+                        BOOST_REQUIRE_EQUAL(edges[rest]._valid, generator.guard_valid(*pn, marking.data()));
+                    }
+                    BOOST_REQUIRE(!generator.next(dst, cond));
+                }
+            }
+        }
+    }
+}
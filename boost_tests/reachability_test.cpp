@@ -18,10 +18,20 @@
 
 #include <boost/test/unit_test.hpp>
 #include <string>
+#include <filesystem>
 #include <fstream>
 #include <sstream>
+#include <functional>
+#include <set>
+#include <vector>
 
 #include "utils.h"
+#include "PetriEngine/Reachability/ParallelReachabilitySearch.h"
+#include "PetriEngine/Reachability/PortfolioSearch.h"
+#include "PetriEngine/EnablednessKernel.h"
+#include "PetriEngine/PQL/CompiledCondition.h"
+#include "PetriEngine/PQL/IncrementalDistance.h"
+#include "PetriEngine/SuccessorGenerator.h"
 
 using namespace PetriEngine;
 using namespace PetriEngine::Colored;
@@ -114,3 +124,393 @@ BOOST_AUTO_TEST_CASE(AngiogenesisPT01ReachabilityFireability, * utf::timeout(60)
         }
     }
 }
+
+// the answers to the queries of Angiogenesis-PT-01/ReachabilityCardinality.xml
+const std::vector<Reachability::ResultPrinter::Result> angiogenesisCardinality{
+    Reachability::ResultPrinter::Satisfied,
+    Reachability::ResultPrinter::Satisfied,
+    Reachability::ResultPrinter::Satisfied,
+    Reachability::ResultPrinter::NotSatisfied,
+    Reachability::ResultPrinter::NotSatisfied,
+    Reachability::ResultPrinter::NotSatisfied,
+    Reachability::ResultPrinter::NotSatisfied,
+    Reachability::ResultPrinter::Satisfied,
+    Reachability::ResultPrinter::NotSatisfied,
+    Reachability::ResultPrinter::Satisfied,
+    Reachability::ResultPrinter::NotSatisfied,
+    Reachability::ResultPrinter::NotSatisfied,
+    Reachability::ResultPrinter::Satisfied,
+    Reachability::ResultPrinter::NotSatisfied,
+    Reachability::ResultPrinter::NotSatisfied,
+    Reachability::ResultPrinter::NotSatisfied};
+
+// the searches each query is solved with, every combination of the values is tried
+struct SearchMatrix {
+    std::vector<Strategy> strategies{Strategy::DFS};
+    std::vector<bool> stubborn{false};
+    std::vector<bool> trace{false};
+    std::vector<StateCompaction> compactions{StateCompaction::None};
+    // memory budgets of an external passed-list, 0 keeps the passed-list in memory
+    std::vector<size_t> external{0};
+    std::vector<MemoryPolicy> policies{MemoryPolicy::Stop};
+    // limit of the MemoryBudget while searching, 0 is none
+    size_t memoryLimit = 0;
+    // searches with more cores use a ParallelReachabilitySearch
+    uint32_t cores = 1;
+};
+
+/**
+ * Solves each of the queries of the model with every search of the default matrix changed by overrides,
+ * and requires the answer to be the expected one, or unknown if the search is approximate or runs out of memory.
+ */
+void expectReachability(const char* model, const char* queries,
+        const std::vector<Reachability::ResultPrinter::Result>& expected,
+        const std::function<void(SearchMatrix&)>& overrides = nullptr)
+{
+    SearchMatrix matrix;
+    if (overrides)
+        overrides(matrix);
+    std::set<size_t> qnums;
+    for (size_t i = 0; i < expected.size(); ++i)
+        qnums.insert(i);
+    auto [pn, conditions, qstrings] = load_pn(model, queries, qnums);
+
+    // the external passed-lists and spilled searches write their files here
+    auto directory = std::filesystem::temp_directory_path() / "verifypn_external_test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    ResultHandler handler;
+    MemoryBudget::setLimit(matrix.memoryLimit);
+    for (auto i : qnums) {
+        for (auto search : matrix.strategies) {
+            for (bool stub : matrix.stubborn) {
+                for (bool trace : matrix.trace) {
+                    for (auto compaction : matrix.compactions) {
+                        for (auto external : matrix.external) {
+                            for (auto policy : matrix.policies) {
+                                auto c2 = prepareForReachability(conditions[i]);
+                                std::vector<Condition_ptr> vec{c2};
+                                std::vector<Reachability::ResultPrinter::Result> results{Reachability::ResultPrinter::Unknown};
+                                bool exceeded = false;
+                                if (matrix.cores > 1) {
+                                    ParallelReachabilitySearch strategy(*pn, handler, matrix.cores, 0);
+                                    strategy.reachable(vec, results, search, stub, false, StatisticsLevel::None, trace, 0);
+                                } else {
+                                    ReachabilitySearch strategy(*pn, handler, 0);
+                                    if (compaction != StateCompaction::None)
+                                        strategy.setStateCompaction(compaction, 1024 * 1024, 3);
+                                    if (external != 0)
+                                        strategy.setExternalMemory(directory.string(), external);
+                                    strategy.setMemoryPolicy(policy, directory.string());
+                                    strategy.reachable(vec, results, search, stub, false, StatisticsLevel::None, trace, 0);
+                                    exceeded = strategy.memoryExceeded();
+                                }
+                                // the approximate searches can only find markings, which satisfy an EF query or refute an AG query
+                                const bool found = (expected[i] == Reachability::ResultPrinter::Satisfied) != c2->isInvariant();
+                                if (compaction != StateCompaction::None && !found)
+                                    BOOST_REQUIRE_EQUAL(Reachability::ResultPrinter::Unknown, results[0]);
+                                else if (results[0] == Reachability::ResultPrinter::Unknown && matrix.memoryLimit != 0)
+                                    BOOST_REQUIRE(exceeded);
+                                else
+                                    BOOST_REQUIRE_EQUAL(expected[i], results[0]);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    MemoryBudget::setLimit(0);
+    std::filesystem::remove_all(directory);
+}
+
+BOOST_AUTO_TEST_CASE(AngiogenesisPT01ParallelReachabilityCardinality, * utf::timeout(60)) {
+    expectReachability("/models/Angiogenesis-PT-01/model.pnml",
+        "/models/Angiogenesis-PT-01/ReachabilityCardinality.xml", angiogenesisCardinality, [](SearchMatrix& m) {
+            m.strategies = {Strategy::BFS, Strategy::DFS, Strategy::HEUR, Strategy::RDFS, Strategy::RPFS};
+            m.stubborn = {true, false};
+            m.cores = 4;
+        });
+}
+
+BOOST_AUTO_TEST_CASE(AngiogenesisPT01PortfolioCardinality, * utf::timeout(120)) {
+
+    std::set<size_t> qnums{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+
+    auto [pn, conditions, qstrings] = load_pn("/models/Angiogenesis-PT-01/model.pnml",
+        "/models/Angiogenesis-PT-01/ReachabilityCardinality.xml", qnums);
+
+    ResultHandler handler;
+    options_t options;
+    options.printstatistics = StatisticsLevel::None;
+
+    std::vector<Condition_ptr> vec;
+    for (auto i : qnums)
+        vec.push_back(prepareForReachability(conditions[i]));
+    std::vector<Reachability::ResultPrinter::Result> results(vec.size(), Reachability::ResultPrinter::Unknown);
+    PortfolioSearch portfolio(handler, *pn, nullptr, options);
+    portfolio.solve(vec, results);
+    for (auto i : qnums)
+        BOOST_REQUIRE_EQUAL(angiogenesisCardinality[i], results[i]);
+}
+
+BOOST_AUTO_TEST_CASE(AngiogenesisPT01StateCompaction, * utf::timeout(60)) {
+    expectReachability("/models/Angiogenesis-PT-01/model.pnml",
+        "/models/Angiogenesis-PT-01/ReachabilityCardinality.xml", angiogenesisCardinality, [](SearchMatrix& m) {
+            m.strategies = {Strategy::BFS, Strategy::DFS, Strategy::HEUR};
+            m.stubborn = {true};
+            m.compactions = {StateCompaction::Hash, StateCompaction::Bitstate};
+        });
+}
+
+BOOST_AUTO_TEST_CASE(AngiogenesisPT01ExternalMemory, * utf::timeout(60)) {
+    expectReachability("/models/Angiogenesis-PT-01/model.pnml",
+        "/models/Angiogenesis-PT-01/ReachabilityCardinality.xml", angiogenesisCardinality, [](SearchMatrix& m) {
+            m.strategies = {Strategy::BFS};
+            m.stubborn = {false, true};
+            // a small budget, so the layers are merged from several runs
+            m.external = {4096, 1024 * 1024};
+        });
+}
+
+BOOST_AUTO_TEST_CASE(ExternalStateSetManyRuns, * utf::timeout(60)) {
+    std::set<size_t> qnums{0};
+    auto [pn, conditions, qstrings] = load_pn("/models/Angiogenesis-PT-01/model.pnml",
+        "/models/Angiogenesis-PT-01/ReachabilityCardinality.xml", qnums);
+
+    auto directory = std::filesystem::temp_directory_path() / "verifypn_external_runs_test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    // a budget of one byte writes every marking as its own run, so a layer is merged from hundreds of runs
+    auto states = std::make_unique<Structures::ExternalStateSet>(*pn, 0, directory.string(), 1);
+    Structures::State state;
+    state.setMarking(pn->makeInitialMarking());
+    auto layer = [&](uint32_t from, uint32_t to) {
+        // every marking is added twice
+        for (uint32_t i = from; i < 2 * to - from; ++i) {
+            state.marking()[0] = from + (i - from) % (to - from);
+            BOOST_REQUIRE(states->add(state).first);
+        }
+        std::set<MarkVal> found;
+        if (states->nextLayer()) {
+            while (states->next(state))
+                BOOST_REQUIRE(found.insert(state.marking()[0]).second);
+        }
+        return found.size();
+    };
+
+    BOOST_REQUIRE_EQUAL(layer(0, 300), 300);
+    BOOST_REQUIRE_EQUAL(states->size(), 300);
+    BOOST_REQUIRE_EQUAL(layer(250, 400), 100);
+    BOOST_REQUIRE_EQUAL(states->size(), 400);
+    BOOST_REQUIRE_EQUAL(layer(0, 300), 0);
+
+    // the files of the passed-list are removed with it
+    states.reset();
+    BOOST_REQUIRE(std::filesystem::is_empty(directory));
+    std::filesystem::remove_all(directory);
+}
+
+BOOST_AUTO_TEST_CASE(AngiogenesisPT01MemoryBudget, * utf::timeout(60)) {
+    expectReachability("/models/Angiogenesis-PT-01/model.pnml",
+        "/models/Angiogenesis-PT-01/ReachabilityCardinality.xml", angiogenesisCardinality, [](SearchMatrix& m) {
+            m.strategies = {Strategy::BFS};
+            m.policies = {MemoryPolicy::Compact, MemoryPolicy::Spill, MemoryPolicy::Stop};
+            // the waiting list alone exceeds the budget, so every search is cut short
+            m.memoryLimit = 1;
+        });
+}
+
+// records the policies a search degrades with
+struct DegradationHandler : public ResultHandler {
+    std::vector<MemoryPolicy> policies;
+
+    void memoryExceeded(MemoryPolicy policy) override {
+        policies.push_back(policy);
+    }
+};
+
+BOOST_AUTO_TEST_CASE(AngiogenesisPT01MemoryBudgetSpill, * utf::timeout(60)) {
+    std::set<size_t> qnums{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    auto [pn, conditions, qstrings] = load_pn("/models/Angiogenesis-PT-01/model.pnml",
+        "/models/Angiogenesis-PT-01/ReachabilityCardinality.xml", qnums);
+
+    auto directory = std::filesystem::temp_directory_path() / "verifypn_spill_test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    // the encodings of the first hundred or so markings exceed the budget, so the search
+    // spills partway through and decides the remaining queries on the disk
+    MemoryBudget::setLimit(1024);
+    for (auto search : {Strategy::BFS, Strategy::DFS}) {
+        std::vector<Condition_ptr> vec;
+        for (auto i : qnums)
+            vec.push_back(prepareForReachability(conditions[i]));
+        std::vector<Reachability::ResultPrinter::Result> results(vec.size(), Reachability::ResultPrinter::Unknown);
+        DegradationHandler handler;
+        ReachabilitySearch strategy(*pn, handler, 0);
+        strategy.setMemoryPolicy(MemoryPolicy::Spill, directory.string());
+        strategy.reachable(vec, results, search, false, false, StatisticsLevel::None, false, 0);
+        BOOST_REQUIRE_EQUAL(handler.policies.size(), 1);
+        BOOST_REQUIRE(handler.policies[0] == MemoryPolicy::Spill);
+        BOOST_REQUIRE(!strategy.memoryExceeded());
+        for (auto i : qnums)
+            BOOST_REQUIRE_EQUAL(angiogenesisCardinality[i], results[i]);
+    }
+    MemoryBudget::setLimit(0);
+    std::filesystem::remove_all(directory);
+}
+
+BOOST_AUTO_TEST_CASE(AngiogenesisPT01EnablednessKernel, * utf::timeout(60)) {
+
+    auto [pn, conditions, qstrings] = load_pn("/models/Angiogenesis-PT-01/model.pnml",
+        "/models/Angiogenesis-PT-01/ReachabilityCardinality.xml", {0});
+
+    EnablednessKernel kernel(*pn);
+    EnablednessKernel incremental(*pn);
+    SuccessorGenerator generator(*pn);
+    Structures::State state(pn->makeInitialMarking());
+    Structures::State working(pn->makeInitialMarking());
+    for (size_t step = 0; step < 1000; ++step) {
+        kernel.compute(state.marking());
+        incremental.update(state.marking());
+        size_t nenabled = 0;
+        for (uint32_t t = 0; t < pn->numberOfTransitions(); ++t) {
+            BOOST_REQUIRE_EQUAL(pn->fireable(state.marking(), t), kernel.enabled(t));
+            BOOST_REQUIRE_EQUAL(kernel.enabled(t), incremental.enabled(t));
+            nenabled += kernel.enabled(t);
+        }
+        if (nenabled == 0)
+            break;
+        // walk to one of the successors, which must be generated in the same order
+        generator.prepare(state);
+        uint32_t t = kernel.next(0, pn->numberOfTransitions());
+        for (size_t i = 0; i <= step % nenabled; ++i) {
+            BOOST_REQUIRE(generator.next(working));
+            BOOST_REQUIRE_EQUAL(t, generator.fired());
+            t = kernel.next(t + 1, pn->numberOfTransitions());
+        }
+        std::copy(working.marking(), working.marking() + pn->numberOfPlaces(), state.marking());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(AngiogenesisPT01CompiledCondition, * utf::timeout(60)) {
+
+    std::set<size_t> qnums{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    for (auto queries : {"/models/Angiogenesis-PT-01/ReachabilityCardinality.xml",
+                         "/models/Angiogenesis-PT-01/ReachabilityFireability.xml"}) {
+        auto [pn, conditions, qstrings] = load_pn("/models/Angiogenesis-PT-01/model.pnml", queries, qnums);
+
+        std::vector<Condition_ptr> vec;
+        std::vector<PQL::CompiledCondition> compiled;
+        // the parsed queries are E F, which has no distance, so the prepared queries and their negations are used
+        for (auto i : qnums) {
+            vec.push_back(prepareForReachability(conditions[i]));
+            vec.push_back(std::make_shared<NotCondition>(vec.back()));
+        }
+        for (auto& c : vec) {
+            compiled.emplace_back(c.get());
+            BOOST_REQUIRE(compiled.back().valid());
+        }
+
+        SuccessorGenerator generator(*pn);
+        Structures::State state(pn->makeInitialMarking());
+        Structures::State working(pn->makeInitialMarking());
+        for (size_t step = 0; step < 1000; ++step) {
+            PQL::EvaluationContext context(state.marking(), pn.get());
+            for (size_t i = 0; i < vec.size(); ++i)
+                BOOST_REQUIRE_EQUAL(PetriEngine::PQL::evaluate(vec[i].get(), context), compiled[i].evaluate(context));
+            // walk to one of the successors
+            generator.prepare(state);
+            size_t nsucc = 0;
+            while (nsucc <= step % 7 && generator.next(working))
+                ++nsucc;
+            if (nsucc == 0)
+                break;
+            std::copy(working.marking(), working.marking() + pn->numberOfPlaces(), state.marking());
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(AngiogenesisPT01IncrementalDistance, * utf::timeout(60)) {
+
+    std::set<size_t> qnums{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    for (auto queries : {"/models/Angiogenesis-PT-01/ReachabilityCardinality.xml",
+                         "/models/Angiogenesis-PT-01/ReachabilityFireability.xml"}) {
+        auto [pn, conditions, qstrings] = load_pn("/models/Angiogenesis-PT-01/model.pnml", queries, qnums);
+
+        std::vector<Condition_ptr> vec;
+        std::vector<PQL::IncrementalDistance> incremental;
+        // the parsed queries are E F, which has no distance, so the prepared queries and their negations are used
+        for (auto i : qnums) {
+            vec.push_back(prepareForReachability(conditions[i]));
+            vec.push_back(std::make_shared<NotCondition>(vec.back()));
+        }
+        for (auto& c : vec) {
+            incremental.emplace_back(*pn, c.get());
+            BOOST_REQUIRE(incremental.back().valid());
+        }
+
+        SuccessorGenerator generator(*pn);
+        Structures::State state(pn->makeInitialMarking());
+        Structures::State working(pn->makeInitialMarking());
+        for (size_t step = 0; step < 1000; ++step) {
+            for (size_t i = 0; i < vec.size(); ++i) {
+                PQL::DistanceContext context(pn.get(), state.marking());
+                BOOST_REQUIRE_EQUAL(vec[i]->distance(context), incremental[i].prepare(state.marking()));
+            }
+            // every successor, then walk to one of them
+            generator.prepare(state);
+            size_t nsucc = 0;
+            Structures::State next(pn->makeInitialMarking());
+            while (generator.next(working)) {
+                for (size_t i = 0; i < vec.size(); ++i) {
+                    PQL::DistanceContext context(pn.get(), working.marking());
+                    BOOST_REQUIRE_EQUAL(vec[i]->distance(context), incremental[i].distance(working.marking(), generator.fired()));
+                }
+                if (nsucc++ <= step % 7)
+                    std::copy(working.marking(), working.marking() + pn->numberOfPlaces(), next.marking());
+            }
+            if (nsucc == 0)
+                break;
+            std::copy(next.marking(), next.marking() + pn->numberOfPlaces(), state.marking());
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(StreamedModelMatchesDocument) {
+
+    for (auto model : {"/models/Angiogenesis-PT-01/model.pnml",
+                       "/models/DiscoveryGPU-PT-15a/model.pnml",
+                       "/models/Referendum-PT-0015/model.pnml"}) {
+        shared_string_set sset;
+        PetriNetBuilder document(sset);
+        auto f = loadFile(model);
+        document.parse_model(f);
+        PetriNetBuilder streamed(sset);
+        streamed.parse_model(std::string(getenv("TEST_FILES")) + model);
+
+        std::unique_ptr<PetriNet> a{document.makePetriNet(false)};
+        std::unique_ptr<PetriNet> b{streamed.makePetriNet(false)};
+        BOOST_REQUIRE_EQUAL(a->numberOfPlaces(), b->numberOfPlaces());
+        BOOST_REQUIRE_EQUAL(a->numberOfTransitions(), b->numberOfTransitions());
+        std::unique_ptr<MarkVal[]> ma{a->makeInitialMarking()}, mb{b->makeInitialMarking()};
+        for (uint32_t p = 0; p < a->numberOfPlaces(); ++p) {
+            BOOST_REQUIRE_EQUAL(*a->placeNames()[p], *b->placeNames()[p]);
+            BOOST_REQUIRE_EQUAL(ma[p], mb[p]);
+        }
+        for (uint32_t t = 0; t < a->numberOfTransitions(); ++t) {
+            BOOST_REQUIRE_EQUAL(*a->transitionNames()[t], *b->transitionNames()[t]);
+            for (auto [sa, sb] : {std::make_pair(a->preset(t), b->preset(t)), std::make_pair(a->postset(t), b->postset(t))}) {
+                BOOST_REQUIRE_EQUAL(sa.second - sa.first, sb.second - sb.first);
+                for (; sa.first != sa.second; ++sa.first, ++sb.first) {
+                    BOOST_REQUIRE_EQUAL(sa.first->place, sb.first->place);
+                    BOOST_REQUIRE_EQUAL(sa.first->tokens, sb.first->tokens);
+                    BOOST_REQUIRE_EQUAL(sa.first->inhibitor, sb.first->inhibitor);
+                }
+            }
+        }
+    }
+}
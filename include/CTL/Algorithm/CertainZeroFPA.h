@@ -21,6 +21,11 @@ public:
     }
     virtual bool search(DependencyGraph::BasicDependencyGraph &t_graph) override;
 protected:
+    // shares the waiting list of another instance
+    CertainZeroFPA(std::shared_ptr<SearchStrategy::SearchStrategy> strategy)
+    : FixedPointAlgorithm(std::move(strategy))
+    {
+    }
 
     DependencyGraph::BasicDependencyGraph *graph;
     DependencyGraph::Configuration* vertex;
@@ -28,7 +33,11 @@ protected:
     void checkEdge(DependencyGraph::Edge* e, bool only_assign = false);
     void finalAssign(DependencyGraph::Configuration *c, DependencyGraph::Assignment a);
     void finalAssign(DependencyGraph::Edge *e, DependencyGraph::Assignment a);
-    void explore(DependencyGraph::Configuration *c);
+    virtual void explore(DependencyGraph::Configuration *c);
+    void addSuccessors(DependencyGraph::Configuration *c, std::vector<DependencyGraph::Edge*>& succs);
+
+    // reused by every call of successors
+    std::vector<DependencyGraph::Edge*> _succs;
 
 };
 }
@@ -18,6 +18,9 @@ public:
     size_t exploredConfigurations() const { return _exploredConfigurations; }
     size_t numberOfEdges() const { return _numberOfEdges; }
 protected:
+    FixedPointAlgorithm(std::shared_ptr<SearchStrategy::SearchStrategy> strategy)
+    : strategy(std::move(strategy)) {}
+
     std::shared_ptr<SearchStrategy::SearchStrategy> strategy;
     //total number of processed edges
     size_t _processedEdges = 0;
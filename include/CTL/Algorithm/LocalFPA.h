@@ -24,6 +24,9 @@ protected:
     void explore(DependencyGraph::Configuration *c);
     void addDependency(DependencyGraph::Edge *e,
                           DependencyGraph::Configuration *target);
+
+    // reused by every call of successors
+    std::vector<DependencyGraph::Edge*> _succs;
 };
 }
 #endif // LOCALFPA_H
@@ -0,0 +1,75 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PARALLELCERTAINZEROFPA_H
+#define PARALLELCERTAINZEROFPA_H
+
+#include "CertainZeroFPA.h"
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+namespace Algorithm {
+
+/**
+ * Multi-core certain-zero algorithm. The workers share the waiting list and each
+ * generate successors through their own view of the dependency graph, so several
+ * configurations are explored at once. Assignments, dependency sets and reference
+ * counts are only touched while holding the propagation lock, which a worker
+ * releases while it computes successors. The configuration is EXPLORING until
+ * its successors are added, the other workers only add dependencies to it.
+ * Negation edges are only released once the waiting list is empty and no worker
+ * is exploring, as in the sequential algorithm.
+ * Propagation is thus serialized: only successor generation scales with the
+ * workers, so graphs where propagation dominates gain little from more cores.
+ * Falls back to the sequential algorithm if the graph cannot be shared.
+ */
+class ParallelCertainZeroFPA : public CertainZeroFPA
+{
+public:
+    ParallelCertainZeroFPA(Strategy type, uint32_t cores) : CertainZeroFPA(type), _cores(cores)
+    {
+    }
+    virtual ~ParallelCertainZeroFPA()
+    {
+    }
+    virtual bool search(DependencyGraph::BasicDependencyGraph &t_graph) override;
+protected:
+    virtual void explore(DependencyGraph::Configuration *c) override;
+
+private:
+    struct shared_t {
+        std::mutex _lock;
+        std::condition_variable _idle;
+        // workers computing successors without holding the lock
+        size_t _exploring = 0;
+        size_t _waiting = 0;
+        bool _stop = false;
+    };
+
+    ParallelCertainZeroFPA(std::shared_ptr<SearchStrategy::SearchStrategy> strategy, shared_t& shared,
+                           DependencyGraph::BasicDependencyGraph& graph, DependencyGraph::Configuration* vertex);
+
+    void work(std::unique_lock<std::mutex>& guard);
+
+    uint32_t _cores = 1;
+    shared_t* _shared = nullptr;
+    std::unique_lock<std::mutex>* _guard = nullptr;
+};
+}
+#endif // PARALLELCERTAINZEROFPA_H
@@ -7,6 +7,7 @@
 
 #include "Algorithm/AlgorithmTypes.h"
 #include "../PetriEngine/PQL/PQL.h"
+#include "../PetriEngine/Structures/MarkingStore.h"
 
 #include "CTLResult.h"
 
@@ -14,7 +15,8 @@
 
 bool CTLSingleSolve(PetriEngine::PQL::Condition* query, PetriEngine::PetriNet* net,
                     CTL::CTLAlgorithmType algorithmtype,
-                    Strategy strategytype, bool partial_order, CTLResult& result);
+                    Strategy strategytype, bool partial_order, CTLResult& result, uint32_t cores = 1,
+                    std::shared_ptr<PetriEngine::Structures::MarkingStore> markings = nullptr);
 
 ReturnValue CTLMain(PetriEngine::PetriNet* net,
                     CTL::CTLAlgorithmType algorithmtype,
@@ -4,6 +4,7 @@
 #include <cstddef>
 #include <vector>
 #include <cstdint>
+#include <memory>
 
 namespace DependencyGraph {
 
@@ -13,10 +14,16 @@ class Edge;
 class BasicDependencyGraph {
 
 public:
-    virtual std::vector<Edge*> successors(Configuration *c) =0;
+    virtual ~BasicDependencyGraph() {}
+    // replaces the contents of succs with the outgoing edges of c
+    virtual void successors(Configuration *c, std::vector<Edge*>& succs) =0;
     virtual Configuration *initialConfiguration() =0;
     virtual void release(Edge* e) = 0;
     virtual void cleanUp() =0;
+
+    // a graph over the same configurations, for a worker computing successors
+    // concurrently with this graph; nullptr if the graph cannot be shared.
+    virtual std::unique_ptr<BasicDependencyGraph> workerGraph(uint32_t worker) { return nullptr; }
 };
 
 }
@@ -0,0 +1,114 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COMPACTLIST_H
+#define COMPACTLIST_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+
+namespace DependencyGraph {
+
+/**
+ * A list of pointers kept in one contiguous array with a 32-bit size and
+ * capacity, for the targets of edges and the dependencies of configurations.
+ * Like a std::forward_list, push_front places an element before all others, so
+ * pushed elements are iterated newest first; insert places an element before an
+ * iterator, so a list filled by insert keeps whatever order its user maintains.
+ * An all-zero list is a valid empty list, as the linked buckets require.
+ * clear keeps the array for reuse, shrink_to_fit releases it if empty.
+ */
+template<typename T>
+class CompactList {
+    static_assert(std::is_pointer_v<T>, "CompactList only holds pointers");
+public:
+    using iterator = std::reverse_iterator<T*>;
+    using const_iterator = std::reverse_iterator<const T*>;
+
+    CompactList() = default;
+    CompactList(const CompactList&) = delete;
+    CompactList& operator=(const CompactList&) = delete;
+    ~CompactList() { delete[] _data; }
+
+    iterator begin() { return iterator(_data + _size); }
+    iterator end() { return iterator(_data); }
+    const_iterator begin() const { return const_iterator(_data + _size); }
+    const_iterator end() const { return const_iterator(_data); }
+
+    bool empty() const { return _size == 0; }
+    uint32_t size() const { return _size; }
+
+    void push_front(T value)
+    {
+        if(_size == _capacity)
+            grow();
+        _data[_size++] = value;
+    }
+
+    iterator insert(iterator pos, T value)
+    {
+        uint32_t at = pos.base() - _data;
+        if(_size == _capacity)
+            grow();
+        std::memmove(_data + at + 1, _data + at, (_size - at) * sizeof(T));
+        _data[at] = value;
+        ++_size;
+        return iterator(_data + at + 1);
+    }
+
+    // returns the element following the erased one
+    iterator erase(iterator pos)
+    {
+        T* at = pos.base() - 1;
+        assert(at >= _data && at < _data + _size);
+        std::memmove(at, at + 1, (_data + _size - at - 1) * sizeof(T));
+        --_size;
+        return iterator(at);
+    }
+
+    void clear() { _size = 0; }
+
+    void shrink_to_fit()
+    {
+        if(_size != 0) return;
+        delete[] _data;
+        _data = nullptr;
+        _capacity = 0;
+    }
+
+private:
+    void grow()
+    {
+        _capacity = std::max<uint32_t>(2, _capacity * 2);
+        T* data = new T[_capacity];
+        if(_size != 0)
+            std::memcpy(data, _data, _size * sizeof(T));
+        delete[] _data;
+        _data = data;
+    }
+
+    T* _data = nullptr;
+    uint32_t _size = 0;
+    uint32_t _capacity = 0;
+};
+
+}
+#endif // COMPACTLIST_H
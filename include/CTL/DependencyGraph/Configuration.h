@@ -1,13 +1,13 @@
 #ifndef CONFIGURATION_H
 #define CONFIGURATION_H
 
+#include "CompactList.h"
 #include "Edge.h"
 
 #include <string>
 #include <cstdio>
 #include <iostream>
 #include <vector>
-#include <forward_list>
 #include <cstdint>
 
 namespace DependencyGraph {
@@ -17,10 +17,13 @@ class Edge;
 class Configuration
 {
 public:
-    std::forward_list<Edge*> dependency_set;   
+    // sorted by address, addDependency inserts in order
+    CompactList<Edge*> dependency_set;
     uint32_t nsuccs = 0;
 private:
     uint32_t distance = 0;
+    // the worker which created the configuration
+    uint32_t owner = 0;
     void setDistance(uint32_t value) { distance = value; }
 public:
     int8_t assignment = UNKNOWN;
@@ -28,8 +31,8 @@ public:
     uint32_t getDistance() const { return distance; }
     bool isDone() const { return assignment == ONE || assignment == CZERO; }
     void addDependency(Edge* e);
-    void setOwner(uint32_t) { }
-    uint32_t getOwner() { return 0; }
+    void setOwner(uint32_t value) { owner = value; }
+    uint32_t getOwner() const { return owner; }
     
 };
 
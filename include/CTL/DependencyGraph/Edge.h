@@ -6,18 +6,21 @@
 #include <string>
 #include <algorithm>
 #include <cassert>
-#include <forward_list>
 #include <cstdint>
 
+#include "CompactList.h"
+
 namespace DependencyGraph {
 
 class Configuration;
 enum Assignment {
-    ONE = 1, UNKNOWN = 0, ZERO = -1, CZERO = -2
+    ONE = 1, UNKNOWN = 0, ZERO = -1, CZERO = -2,
+    // claimed by a worker of the parallel algorithm which is still computing its successors
+    EXPLORING = -3
 };
 
 class Edge {
-    typedef std::forward_list<Configuration*> container;
+    typedef CompactList<Configuration*> container;
 public:
     Edge(){}
     Edge(Configuration &t_source) : source(&t_source) {}
@@ -4,7 +4,9 @@
 namespace DependencyGraph {
 
 enum Assignment {
-    ONE = 1, UNKNOWN = 0, ZERO = -1, CZERO = -2
+    ONE = 1, UNKNOWN = 0, ZERO = -1, CZERO = -2,
+    // claimed by a worker of the parallel algorithm which is still computing its successors
+    EXPLORING = -3
 };
 }
 
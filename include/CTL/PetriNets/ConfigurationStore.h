@@ -0,0 +1,118 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CONFIGURATIONSTORE_H
+#define CONFIGURATIONSTORE_H
+
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "CTL/DependencyGraph/Edge.h"
+#include "PetriConfig.h"
+#include "PetriEngine/Structures/MarkingStore.h"
+#include "PetriEngine/Structures/Sharded.h"
+#include "PetriEngine/Structures/linked_bucket.h"
+
+namespace PetriNets {
+
+/**
+ * Storage of the markings, configurations and edges of an OnTheFlyDG, which can
+ * be shared by the dependency graphs of several workers.
+ * Encoded markings are kept in a MarkingStore, which may also be shared with the
+ * graphs and searches of other queries; marking ids are the ids of the store.
+ * The configurations of a marking are distributed over shards by its id, see
+ * PetriEngine::Structures::sharded_t. A shard numbers the subformulae it has seen and finds
+ * the configuration of (marking, subformula) through an open addressing table
+ * holding 32-bit configuration ids.
+ * Configurations and edges are allocated from linked buckets with one slot per
+ * worker, so allocation does not need a lock.
+ */
+class ConfigurationStore {
+public:
+    using Condition = PetriEngine::PQL::Condition;
+
+    ConfigurationStore(size_t workers, size_t shards,
+                       std::shared_ptr<PetriEngine::Structures::MarkingStore> markings = nullptr);
+    ~ConfigurationStore();
+
+    /**
+     * Inserts an encoded marking with sum tokens, returns whether it is new to this store and its id.
+     */
+    std::pair<bool, size_t> insertMarking(const unsigned char* data, size_t size, size_t sum);
+    void unpackMarking(size_t id, unsigned char* destination);
+
+    /**
+     * Finds the configuration of (marking, query), creating it if needed.
+     * New configurations are allocated from the slot of the given worker.
+     */
+    PetriConfig* configuration(size_t marking, Condition* query, uint32_t owner, uint32_t worker);
+    DependencyGraph::Edge* newEdge(uint32_t worker);
+
+    size_t workers() const { return _workers; }
+    size_t markingCount() const { return _markingCount; }
+    size_t configurationCount() const { return _configurationCount; }
+    size_t maxTokens() const { return _maxTokens; }
+
+    // stubborn sets of different workers annotate the same query objects
+    std::mutex& queryLock() { return _query_lock; }
+
+private:
+    static constexpr uint32_t EMPTY = std::numeric_limits<uint32_t>::max();
+
+    struct slot_t {
+        size_t _marking = 0;
+        uint32_t _formula = EMPTY;
+        uint32_t _config = 0;
+    };
+
+    struct shard_t {
+        std::unordered_map<const Condition*, uint32_t> _formulas;
+        // power of two sized, at most three quarters full
+        std::vector<slot_t> _index = std::vector<slot_t>(16);
+        size_t _used = 0;
+        // the markings of the shard inserted into this store
+        std::unordered_set<size_t> _markings;
+
+        slot_t& find(size_t marking, uint32_t formula);
+        void grow();
+    };
+
+    PetriConfig* config(uint32_t id) {
+        return reinterpret_cast<PetriConfig*>((*_conf_alloc)[id]);
+    }
+
+    size_t _workers;
+    std::shared_ptr<PetriEngine::Structures::MarkingStore> _markings;
+    PetriEngine::Structures::sharded_t<shard_t> _shards;
+    std::unique_ptr<linked_bucket_t<DependencyGraph::Edge,1024*10>> _edge_alloc;
+
+    // Problem  with linked bucket and complex constructor
+    std::unique_ptr<linked_bucket_t<char[sizeof(PetriConfig)], 1024*64>> _conf_alloc;
+
+    std::atomic<size_t> _markingCount{0};
+    std::atomic<size_t> _configurationCount{0};
+    std::atomic<size_t> _maxTokens{0};
+    std::mutex _query_lock;
+};
+
+}
+#endif // CONFIGURATIONSTORE_H
@@ -2,17 +2,19 @@
 #define ONTHEFLYDG_H
 
 #include <functional>
+#include <memory>
 #include <stack>
-#include <ptrie/ptrie_map.h>
+#include <unordered_map>
 
 #include "CTL/DependencyGraph/BasicDependencyGraph.h"
 #include "CTL/DependencyGraph/Configuration.h"
 #include "CTL/DependencyGraph/Edge.h"
+#include "ConfigurationStore.h"
 #include "PetriConfig.h"
 #include "PetriParse/PNMLParser.h"
 #include "PetriEngine/PQL/PQL.h"
+#include "PetriEngine/PQL/CompiledCondition.h"
 #include "PetriEngine/Structures/AlignedEncoder.h"
-#include "PetriEngine/Structures/linked_bucket.h"
 #include "PetriEngine/ReducingSuccessorGenerator.h"
 
 namespace PetriNets {
@@ -22,14 +24,20 @@ public:
     using Condition = PetriEngine::PQL::Condition;
     using Condition_ptr = PetriEngine::PQL::Condition_ptr;
     using Marking = PetriEngine::Structures::State;
-    OnTheFlyDG(PetriEngine::PetriNet *t_net, bool partial_order);
+    // markings may be shared with the graphs and searches of other queries on t_net
+    OnTheFlyDG(PetriEngine::PetriNet *t_net, bool partial_order, uint32_t workers = 1,
+               std::shared_ptr<PetriEngine::Structures::MarkingStore> markings = nullptr);
+
+    // a view of other for the given worker, sharing the configurations of other
+    OnTheFlyDG(const OnTheFlyDG& other, uint32_t worker);
 
     virtual ~OnTheFlyDG();
 
     //Dependency graph interface
-    virtual std::vector<DependencyGraph::Edge*> successors(DependencyGraph::Configuration *c) override;
+    virtual void successors(DependencyGraph::Configuration *c, std::vector<DependencyGraph::Edge*>& succs) override;
     virtual DependencyGraph::Configuration *initialConfiguration() override;
     virtual void cleanUp() override;
+    virtual std::unique_ptr<DependencyGraph::BasicDependencyGraph> workerGraph(uint32_t worker) override;
     void setQuery(Condition* query);
 
     virtual void release(DependencyGraph::Edge* e) override;
@@ -57,9 +65,6 @@ protected:
     Marking query_marking;
     uint32_t n_transitions = 0;
     uint32_t n_places = 0;
-    size_t _markingCount = 0;
-    size_t _maxTokens = 0;
-    size_t _configurationCount = 0;
     //used after query is set
     Condition* query = nullptr;
 
@@ -100,14 +105,14 @@ protected:
     DependencyGraph::Edge* newEdge(DependencyGraph::Configuration &t_source, uint32_t weight);
 
     std::stack<DependencyGraph::Edge*> recycle;
-    ptrie::map<ptrie::uchar, std::vector<PetriConfig*> > trie;
-    linked_bucket_t<DependencyGraph::Edge,1024*10>* edge_alloc = nullptr;
-
-    // Problem  with linked bucket and complex constructor
-    linked_bucket_t<char[sizeof(PetriConfig)], 1024*1024>* conf_alloc = nullptr;
+    std::shared_ptr<ConfigurationStore> _store;
+    uint32_t _worker = 0;
 
+    PetriEngine::SuccessorGenerator _gen;
     PetriEngine::ReducingSuccessorGenerator _redgen;
     bool _partial_order = false;
+    // the (sub)queries lowered for fastEval, compiled on first use
+    std::unordered_map<const Condition*, PetriEngine::PQL::CompiledCondition> _compiled;
 
 };
 
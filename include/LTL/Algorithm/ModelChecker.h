@@ -31,6 +31,8 @@
 
 #include <iomanip>
 #include <algorithm>
+#include <atomic>
+#include <mutex>
 
 namespace LTL {
 
@@ -56,6 +58,19 @@ namespace LTL {
 
         virtual void set_partial_order(LTLPartialOrder) {}
 
+        /**
+         * Run this checker as one worker of a parallel search.
+         * @param markings marking store shared by all workers.
+         * @param query_lock serialises the use of Spot, BuDDy and the annotations of the shared formula.
+         * @param stop raised when another worker has answered the query; the checker then returns early
+         *        with an unspecified result.
+         */
+        void set_worker(PetriEngine::Structures::SharedStateSet& markings, std::mutex& query_lock, const std::atomic<bool>& stop) {
+            _shared_markings = &markings;
+            _query_lock = &query_lock;
+            _stop = &stop;
+        }
+
         virtual bool check() = 0;
 
         virtual ~ModelChecker() = default;
@@ -99,6 +114,16 @@ namespace LTL {
         size_t _explored = 0;
         size_t _expanded = 0;
 
+        bool stopped() const {
+            return _stop != nullptr && _stop->load(std::memory_order_relaxed);
+        }
+
+        std::unique_lock<std::mutex> lock_query() {
+            if (_query_lock == nullptr)
+                return std::unique_lock<std::mutex>();
+            return std::unique_lock<std::mutex>(*_query_lock);
+        }
+
         virtual void print_stats(std::ostream &os, size_t discovered, size_t max_tokens) const {
             std::cout << "STATS:\n"
                     << "\tdiscovered states: " << discovered << std::endl
@@ -117,6 +142,9 @@ namespace LTL {
         size_t _loop = std::numeric_limits<size_t>::max();
         std::vector<std::vector<uint32_t>> _trace;
         bool _violation = false;
+        PetriEngine::Structures::SharedStateSet* _shared_markings = nullptr;
+        std::mutex* _query_lock = nullptr;
+        const std::atomic<bool>* _stop = nullptr;
     };
 }
 
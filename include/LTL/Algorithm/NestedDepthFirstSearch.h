@@ -87,6 +87,9 @@ namespace LTL {
         template<typename G>
         bool check_with_generator(G& gen);
 
+        template<typename S>
+        void collect_stats(S& states);
+
         template<typename T, typename S>
         void dfs(ProductSuccessorGenerator<T>& successor_generator, S& states, size_t init);
 
@@ -0,0 +1,84 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VERIFYPN_SWARMMODELCHECKER_H
+#define VERIFYPN_SWARMMODELCHECKER_H
+
+#include "LTL/Algorithm/ModelChecker.h"
+#include "LTL/SuccessorGeneration/Heuristic.h"
+#include "PetriEngine/Structures/SharedStateSet.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace LTL {
+
+    /**
+     * Multi-core LTL model checking by swarm verification, see
+     * <p>
+     *   Gerard J. Holzmann, Rajeev Joshi and Alex Groce,<br>
+     *   Swarm Verification Techniques,<br>
+     *   https://doi.org/10.1109/TSE.2010.110
+     * </p>
+     * A number of independent workers (each a complete NDFS or Tarjan checker) search the
+     * product in parallel, each visiting successors in a different random order. The first
+     * worker to finish decides the query and stops the others. The workers share the marking
+     * store, while the product states (and their colours/stack information) are private to a
+     * worker, keeping each worker a sound and complete check on its own.
+     * The first worker keeps the configured heuristic, the others use a random one.
+     */
+    class SwarmModelChecker : public ModelChecker {
+    public:
+        using factory_t = std::function<std::unique_ptr<ModelChecker>()>;
+
+        SwarmModelChecker(const PetriEngine::PetriNet& net,
+                          const PetriEngine::PQL::Condition_ptr &condition,
+                          const Structures::BuchiAutomaton &buchi,
+                          uint32_t cores, uint64_t seed, const factory_t& factory);
+
+        bool check() override;
+
+        void set_partial_order(LTLPartialOrder order) override;
+
+        LTLPartialOrder used_partial_order() const override;
+
+        void print_stats(std::ostream &os) const override;
+
+        size_t max_tokens() const override;
+
+        size_t get_discovered() const override;
+
+        size_t get_markings() const override;
+
+        size_t get_configurations() const override;
+
+    private:
+        std::vector<std::unique_ptr<ModelChecker>> _workers;
+        std::vector<std::unique_ptr<Heuristic>> _heuristics;
+        PetriEngine::Structures::SharedStateSet _markings;
+        std::mutex _lock;
+        std::atomic<bool> _done{false};
+        size_t _winner = 0;
+        size_t _discovered = 0;
+        size_t _configurations = 0;
+        size_t _max_tokens = 0;
+    };
+}
+
+#endif //VERIFYPN_SWARMMODELCHECKER_H
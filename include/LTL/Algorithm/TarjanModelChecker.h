@@ -78,10 +78,10 @@ namespace LTL {
     private:
 
         template<typename SuccGen>
-        bool select_trace_compute(SuccGen& successorGenerator);
+        bool select_trace_compute(SuccGen& successorGenerator, std::unique_lock<std::mutex>& guard);
 
-        template<bool TRACE, typename SuccGen>
-        bool compute(SuccGen& successorGenerator);
+        template<bool TRACE, typename StateSet, typename SuccGen>
+        bool compute(SuccGen& successorGenerator, StateSet& seen);
 
         using State = LTL::Structures::ProductState;
         using idx_t = size_t;
@@ -19,6 +19,7 @@
 #define VERIFYPN_BITPRODUCTSTATESET_H
 
 #include "PetriEngine/Structures/StateSet.h"
+#include "PetriEngine/Structures/SharedStateSet.h"
 #include "LTL/Structures/ProductState.h"
 
 #include <ptrie/ptrie.h>
@@ -31,11 +32,14 @@ namespace LTL { namespace Structures {
      * Bit-hacking product state set for storing pairs (M, q) compactly in 64 bits.
      * Allows for a max of 2^nbits Büchi states and 2^(64-nbits) markings without overflow.
      * @tparam nbits the number of bits to allocate for Büchi state. Defaults to 20-bit. Max is 32-bit.
+     * @tparam marking_set_type the store of the markings; a SharedStateSet::View lets several
+     *         product state sets (of parallel workers) share one marking store.
      */
     using stateid_t = size_t;
     using result_t = std::tuple<bool, stateid_t, size_t>;
 
-    template<typename stateset_type = ptrie::set<stateid_t,17,32,8>, uint8_t nbits = 20>
+    template<typename stateset_type = ptrie::set<stateid_t,17,32,8>, uint8_t nbits = 20,
+             typename marking_set_type = PetriEngine::Structures::StateSet>
     class BitProductStateSet {
     public:
 
@@ -44,6 +48,11 @@ namespace LTL { namespace Structures {
         {
         }
 
+        BitProductStateSet(PetriEngine::Structures::SharedStateSet& markings, const PetriEngine::PetriNet& net, uint32_t kbound = 0)
+                : _markings(markings, net, kbound)
+        {
+        }
+
         static_assert(nbits <= 32, "Only up to 2^32 Büchi states supported");
         static_assert(sizeof(size_t) >= 8, "Expecting size_t to be at least 8 bytes");
 
@@ -114,7 +123,7 @@ namespace LTL { namespace Structures {
         static constexpr auto BUCHI_MASK = ~(std::numeric_limits<size_t>::max() << (nbits));
         static constexpr auto MARKING_SHIFT = nbits;
 
-        PetriEngine::Structures::StateSet _markings;
+        marking_set_type _markings;
         stateset_type _states;
         static constexpr auto _err_val = std::make_pair(false, std::numeric_limits<size_t>::max());
 
@@ -122,18 +131,24 @@ namespace LTL { namespace Structures {
         size_t _configurations = 0;
     };
 
-    template<uint8_t nbits = 20>
-    class TraceableBitProductStateSet : public BitProductStateSet<ptrie::map<stateid_t,std::pair<size_t,size_t>>, nbits> {
+    template<uint8_t nbits = 20, typename marking_set_type = PetriEngine::Structures::StateSet>
+    class TraceableBitProductStateSet : public BitProductStateSet<ptrie::map<stateid_t,std::pair<size_t,size_t>>, nbits, marking_set_type> {
+        using base_t = BitProductStateSet<ptrie::map<stateid_t,std::pair<size_t,size_t>>, nbits, marking_set_type>;
     public:
         explicit TraceableBitProductStateSet(const PetriEngine::PetriNet& net, uint32_t kbound = 0)
-                : BitProductStateSet<ptrie::map<stateid_t,std::pair<size_t,size_t>>,nbits>(net, kbound)
+                : base_t(net, kbound)
+        {
+        }
+
+        TraceableBitProductStateSet(PetriEngine::Structures::SharedStateSet& markings, const PetriEngine::PetriNet& net, uint32_t kbound = 0)
+                : base_t(markings, net, kbound)
         {
         }
 
         void decode(ProductState &state, stateid_t id) override
         {
             _parent = id;
-            BitProductStateSet<ptrie::map<stateid_t,std::pair<size_t,size_t>>,nbits>::decode(state, id);
+            base_t::decode(state, id);
         }
 
         void set_history(stateid_t id, size_t transition)
@@ -77,14 +77,17 @@ namespace LTL { namespace Structures {
 
         /**
          * Evaluate binary decision diagram (BDD) representation of transition guard in given state.
+         * The walk works on the raw node ids and never touches the BDD reference counts,
+         * so several threads may evaluate guards concurrently as long as no BDDs are built meanwhile.
          */
-        bool guard_valid(PetriEngine::PQL::EvaluationContext &ctx, bdd bdd) const
+        bool guard_valid(PetriEngine::PQL::EvaluationContext &ctx, const bdd& guard) const
         {
             // IDs 0 and 1 are false and true atoms, respectively
             // More details in buddy manual ( http://buddy.sourceforge.net/manual/main.html )
-            while (bdd.id() > 1) {
+            int node = guard.id();
+            while (node > 1) {
                 // find variable to test, and test it
-                size_t var = bdd_var(bdd);
+                size_t var = bdd_var(node);
                 using PetriEngine::PQL::Condition;
                 Condition::Result res = PetriEngine::PQL::evaluate(_ap_info.at(var)._expression.get(), ctx);
                 switch (res) {
@@ -93,14 +96,14 @@ namespace LTL { namespace Structures {
                         throw base_error("Unexpected unknown answer from evaluating query!");
                         break;
                     case Condition::RFALSE:
-                        bdd = bdd_low(bdd);
+                        node = bdd_low(node);
                         break;
                     case Condition::RTRUE:
-                        bdd = bdd_high(bdd);
+                        node = bdd_high(node);
                         break;
                 }
             }
-            return bdd == bddtrue;
+            return node == 1;
         }
     };
 } }
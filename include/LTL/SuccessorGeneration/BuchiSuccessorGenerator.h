@@ -19,49 +19,144 @@
 #define VERIFYPN_BUCHISUCCESSORGENERATOR_H
 
 #include "PetriEngine/SuccessorGenerator.h"
+#include "PetriEngine/PQL/CompiledCondition.h"
 #include "LTL/Structures/BuchiAutomaton.h"
 #include "LTL/LTLOptions.h"
+#include "utils/MathExt.h"
 
 #include <spot/twa/twagraph.hh>
 #include <spot/twaalgos/dot.hh>
 #include <spot/twaalgos/hoa.hh>
 #include <spot/twaalgos/neverclaim.hh>
 
-#include <utility>
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
 #include <memory>
+#include <unordered_map>
+#include <utility>
 
 namespace LTL {
+    /**
+     * Iterates the edges of a Büchi automaton. The edges are copied out of Spot into a flat
+     * table once, so that iterating them neither allocates Spot iterators nor copies BDDs;
+     * several generators over the same automaton can thus be used from different threads.
+     *
+     * The guards are compiled into disjunctions of cubes over the atomic propositions, each
+     * cube a mask of the propositions it tests and their required values. A guard is then
+     * checked with a few bit-operations against the valuation of the current marking, in which
+     * each proposition is evaluated at most once, and only if some guard needs it.
+     * Automata with more than 64 propositions, or guards with too many cubes, fall back to
+     * walking a copy of the BDDs of the guards. Both are built through the bdd interface when
+     * the generator is constructed, the guards are then checked without calling BuDDy.
+     */
     class BuchiSuccessorGenerator {
     public:
         explicit BuchiSuccessorGenerator(Structures::BuchiAutomaton automaton)
-                : _aut(std::move(automaton)), _self_loops(_aut.buchi().num_states(), InvariantSelfLoop::UNKNOWN)
+                : _aut(std::move(automaton))
         {
-            _deleter = SuccIterDeleter{&_aut};
+            const auto& buchi = _aut.buchi();
+            index_propositions();
+            // the nodes of the guards by their BDD, the guards share most of them
+            std::unordered_map<int, uint32_t> copied;
+            _nodes.push_back(node_t{0, FALSE_NODE, FALSE_NODE});
+            _nodes.push_back(node_t{0, TRUE_NODE, TRUE_NODE});
+            _first.reserve(buchi.num_states() + 1);
+            _accepting.resize(buchi.num_states());
+            _self_loops.resize(buchi.num_states(), false);
+            for (unsigned state = 0; state < buchi.num_states(); ++state) {
+                _first.push_back(_edges.size());
+                _accepting[state] = buchi.state_is_accepting(state);
+                for (auto &e : buchi.out(state)) {
+                    edge_t edge{e.dst, e.cond, copy(e.cond, copied), static_cast<uint32_t>(_cubes.size()), 0};
+                    if (_compiled && !compile(e.cond, 0, 0, edge._first_cube)) {
+                        _compiled = false;
+                        _cubes.clear();
+                    }
+                    edge._last_cube = _cubes.size();
+                    _edges.push_back(edge);
+                    if (e.dst == state && e.cond == bddtrue)
+                        _self_loops[state] = true;
+                }
+            }
+            _first.push_back(_edges.size());
         }
 
+        /** Start iterating the edges of state, for a new marking */
         void prepare(size_t state)
         {
-            auto curstate = _aut.buchi().state_from_number(state);
-            _succ = _succ_iter{_aut.buchi().succ_iter(curstate), SuccIterDeleter{&_aut}};
-            _succ->first();
+            _next = _first[state];
+            _end = _first[state + 1];
+            _known = 0;
         }
 
-        bool next(size_t &state, bdd &cond)
+        /** Continue iterating the edges of state after the given edge, for a new marking */
+        void resume(size_t state, size_t edge)
         {
-            if (!_succ->done()) {
-                auto dst = _succ->dst();
-                state = _aut.buchi().state_number(dst);
-                cond = _succ->cond();
-                _succ->next();
-                dst->destroy();
+            prepare(state);
+            assert(edge >= _next && edge < _end);
+            _next = edge + 1;
+        }
+
+        bool next(size_t &state, const bdd* &cond)
+        {
+            if (_next != _end) {
+                state = _edges[_next]._dest;
+                cond = &_edges[_next]._cond;
+                ++_next;
                 return true;
             }
             return false;
         }
 
+        /** The index of the edge last returned by next, see resume */
+        [[nodiscard]] size_t edge() const
+        {
+            return _next - 1;
+        }
+
+        /**
+         * True if the guard of the edge last returned by next holds in marking.
+         * The marking must be the same until the next call to prepare or resume.
+         */
+        bool guard_valid(const PetriEngine::PetriNet& net, const PetriEngine::MarkVal* marking)
+        {
+            const edge_t& edge = _edges[_next - 1];
+            if (!_compiled) {
+                PetriEngine::PQL::EvaluationContext ctx{marking, &net};
+                uint32_t node = edge._root;
+                while (node > TRUE_NODE) {
+                    const node_t& n = _nodes[node];
+                    node = PetriEngine::PQL::evaluate(_programs[n._proposition], _propositions[n._proposition], ctx)
+                           == PetriEngine::PQL::Condition::RTRUE ? n._high : n._low;
+                }
+                return node == TRUE_NODE;
+            }
+            for (uint32_t c = edge._first_cube; c < edge._last_cube; ++c) {
+                const cube_t& cube = _cubes[c];
+                if (((_values ^ cube._value) & cube._mask & _known) != 0)
+                    continue;
+                // evaluate the propositions one at a time, so that a failing cube stops early
+                for (uint64_t missing = cube._mask & ~_known; missing != 0; missing &= missing - 1) {
+                    const uint32_t bit = lowestBit(missing);
+                    PetriEngine::PQL::EvaluationContext ctx{marking, &net};
+                    if (PetriEngine::PQL::evaluate(_programs[bit], _propositions[bit], ctx) == PetriEngine::PQL::Condition::RTRUE)
+                        _values |= uint64_t{1} << bit;
+                    else
+                        _values &= ~(uint64_t{1} << bit);
+                    _known |= uint64_t{1} << bit;
+                    if (((_values ^ cube._value) >> bit) & 1)
+                        break;
+                }
+                if ((cube._mask & ~_known) == 0 && ((_values ^ cube._value) & cube._mask) == 0)
+                    return true;
+            }
+            return false;
+        }
+
         [[nodiscard]] bool is_accepting(size_t state) const
         {
-            return _aut.buchi().state_is_accepting(state);
+            return _accepting[state];
         }
 
         [[nodiscard]] size_t initial_state_number() const
@@ -69,21 +164,8 @@ namespace LTL {
             return _aut.buchi().get_init_state_number();
         }
 
-        bool has_invariant_self_loop(size_t state) {
-            if (_self_loops[state] != InvariantSelfLoop::UNKNOWN)
-                return _self_loops[state] == InvariantSelfLoop::TRUE;
-            auto it = std::unique_ptr<spot::twa_succ_iterator>{
-                    _aut.buchi().succ_iter(_aut.buchi().state_from_number(state))};
-            for (it->first(); !it->done(); it->next()) {
-                auto dest_id = _aut.buchi().state_number(it->dst());
-                bdd cond = it->cond();
-                if (state == dest_id && cond == bddtrue) {
-                    _self_loops[state] = InvariantSelfLoop::TRUE;
-                    return true;
-                }
-            }
-            _self_loops[state] = InvariantSelfLoop::FALSE;
-            return false;
+        bool has_invariant_self_loop(size_t state) const {
+            return _self_loops[state];
         }
 
         const Structures::BuchiAutomaton& automaton() const {
@@ -92,23 +174,100 @@ namespace LTL {
 
 
     private:
-        struct SuccIterDeleter {
-            Structures::BuchiAutomaton *_aut;
+        // a conjunction of propositions, those in _mask must have the values in _value
+        struct cube_t {
+            uint64_t _mask;
+            uint64_t _value;
+        };
 
-            void operator()(spot::twa_succ_iterator *iter) const
-            {
-                _aut->buchi().release_iter(iter);
-            }
+        // a node of the copy of the BDDs, testing a proposition
+        struct node_t {
+            uint32_t _proposition;
+            uint32_t _low;
+            uint32_t _high;
         };
 
-        enum class InvariantSelfLoop {
-            TRUE, FALSE, UNKNOWN
+        static constexpr uint32_t FALSE_NODE = 0;
+        static constexpr uint32_t TRUE_NODE = 1;
+
+        struct edge_t {
+            size_t _dest;
+            bdd _cond;
+            // the node of _cond in _nodes
+            uint32_t _root;
+            // the guard is the disjunction of _cubes[_first_cube] to _cubes[_last_cube]
+            uint32_t _first_cube;
+            uint32_t _last_cube;
         };
+
+        static constexpr size_t MAX_CUBES_PER_GUARD = 64;
+
+        void index_propositions()
+        {
+            const auto& aps = _aut.ap_info();
+            // the cubes have a bit per proposition
+            if (aps.size() > 64)
+                _compiled = false;
+            std::vector<int> vars;
+            for (auto& [var, ap] : aps)
+                vars.push_back(var);
+            std::sort(vars.begin(), vars.end());
+            for (auto var : vars) {
+                _bits[var] = _propositions.size();
+                _propositions.push_back(aps.at(var)._expression.get());
+                _programs.emplace_back(_propositions.back());
+            }
+        }
+
+        // adds the paths from node to the true-node as cubes from first, false if there are too many
+        bool compile(const bdd& node, uint64_t mask, uint64_t value, size_t first)
+        {
+            if (node == bddfalse)
+                return true;
+            if (node == bddtrue) {
+                _cubes.push_back(cube_t{mask, value});
+                return _cubes.size() - first <= MAX_CUBES_PER_GUARD;
+            }
+            const uint64_t bit = uint64_t{1} << _bits.at(bdd_var(node));
+            return compile(bdd_low(node), mask | bit, value, first) &&
+                   compile(bdd_high(node), mask | bit, value | bit, first);
+        }
+
+        // copies the BDD of node into _nodes, returning its index
+        uint32_t copy(const bdd& node, std::unordered_map<int, uint32_t>& copied)
+        {
+            if (node == bddfalse)
+                return FALSE_NODE;
+            if (node == bddtrue)
+                return TRUE_NODE;
+            auto it = copied.find(node.id());
+            if (it != copied.end())
+                return it->second;
+            const uint32_t low = copy(bdd_low(node), copied);
+            const uint32_t high = copy(bdd_high(node), copied);
+            _nodes.push_back(node_t{_bits.at(bdd_var(node)), low, high});
+            return copied[node.id()] = _nodes.size() - 1;
+        }
+
         Structures::BuchiAutomaton _aut;
-        std::vector<InvariantSelfLoop> _self_loops;
-        SuccIterDeleter _deleter{};
-        using _succ_iter = std::unique_ptr<spot::twa_succ_iterator, SuccIterDeleter>;
-        _succ_iter _succ = nullptr;
+        std::vector<edge_t> _edges;
+        // edges of state s are _edges[_first[s]] to _edges[_first[s + 1]]
+        std::vector<size_t> _first;
+        std::vector<bool> _accepting;
+        std::vector<bool> _self_loops;
+        size_t _next = 0;
+        size_t _end = 0;
+
+        bool _compiled = true;
+        std::vector<cube_t> _cubes;
+        std::vector<node_t> _nodes;
+        // the proposition of each bit or node, and the bit of each BDD variable
+        std::vector<PetriEngine::PQL::Condition*> _propositions;
+        std::vector<PetriEngine::PQL::CompiledCondition> _programs;
+        std::unordered_map<int, uint32_t> _bits;
+        // valuation of the propositions in the current marking, for those in _known
+        uint64_t _known = 0;
+        uint64_t _values = 0;
     };
 }
 #endif //VERIFYPN_BUCHISUCCESSORGENERATOR_H
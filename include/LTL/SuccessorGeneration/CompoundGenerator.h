@@ -60,19 +60,20 @@ namespace LTL {
             [[nodiscard]] bool fresh() const {
                 return _enabled_it.empty();
             }
-            size_t _buchi_state;
+            // the Büchi edge of the last successor, see BuchiSuccessorGenerator::edge
+            size_t _buchi_edge;
 
         private:
             // wasting of memory, but good enough for now
             std::vector<std::vector<uint32_t>> _enabled;
             std::vector<uint32_t> _enabled_it;
             successor_info_t() {
-                _buchi_state = NoBuchiState;
+                _buchi_edge = NoBuchiEdge;
                 _last_state = NoLastState;
             }
             static constexpr auto NoPCounter = 0;
             static constexpr auto NoTCounter = std::numeric_limits<uint32_t>::max();
-            static constexpr auto NoBuchiState = std::numeric_limits<size_t>::max();
+            static constexpr auto NoBuchiEdge = std::numeric_limits<size_t>::max();
             static constexpr auto NoLastState = std::numeric_limits<size_t>::max();
             friend class CompoundGenerator;
         };
@@ -22,14 +22,25 @@
 
 #include <utility>
 #include "PetriEngine/PQL/Contexts.h"
+#include "PetriEngine/PQL/IncrementalDistance.h"
 
 namespace LTL {
     class DistanceHeuristic : public Heuristic {
     public:
-        DistanceHeuristic(const PetriEngine::PetriNet *net, PetriEngine::PQL::Condition_ptr cond) : _net(net), _cond(std::move(cond)) {}
+        DistanceHeuristic(const PetriEngine::PetriNet *net, PetriEngine::PQL::Condition_ptr cond)
+        : _net(net), _cond(std::move(cond)), _distance(*_net, _cond.get()) {}
 
+        void prepare(const Structures::ProductState &state) override
+        {
+            if (_distance.valid())
+                _distance.prepare(state.marking());
+        }
+
+        // state is the successor of the prepared state by firing tid
         uint32_t eval(const Structures::ProductState &state, uint32_t tid) override
         {
+            if (_distance.valid())
+                return _distance.distance(state.marking(), tid);
             PetriEngine::PQL::DistanceContext context{_net, state.marking()};
             return _cond->distance(context);
         }
@@ -40,6 +51,7 @@ namespace LTL {
     private:
         const PetriEngine::PetriNet *_net;
         const PetriEngine::PQL::Condition_ptr _cond;
+        PetriEngine::PQL::IncrementalDistance _distance;
     };
 }
 
@@ -116,19 +116,13 @@ namespace LTL {
         {
             _successor_generator.prepare(state, sucinfo);
             _fresh_marking = sucinfo.fresh();
-            _buchi_succ_gen.prepare(state->get_buchi_state());
             _buchi_parent = state->get_buchi_state();
-            if (!_fresh_marking) {
-                assert(sucinfo._buchi_state != std::numeric_limits<size_t>::max());
-                // spool Büchi successors until last state found.
-                // TODO is there perhaps a good way to avoid this, perhaps using raw edge vector?
-                // Caveat: it seems like there usually are not that many successors, so this is probably cheap regardless
-                size_t tmp;
-                while (_buchi_succ_gen.next(tmp, _cond)) {
-                    if (tmp == sucinfo._buchi_state) {
-                        break;
-                    }
-                }
+            if (_fresh_marking) {
+                _buchi_succ_gen.prepare(_buchi_parent);
+            } else {
+                // continue after the Büchi edge of the last successor
+                assert(sucinfo._buchi_edge != std::numeric_limits<size_t>::max());
+                _buchi_succ_gen.resume(_buchi_parent, sucinfo._buchi_edge);
             }
         }
 
@@ -152,8 +146,7 @@ namespace LTL {
                 }
             }
             if (next_buchi_succ(state)) {
-                //_successor_generator->getSuccInfo(sucinfo);
-                sucinfo._buchi_state = state.get_buchi_state();
+                sucinfo._buchi_edge = _buchi_succ_gen.edge();
                 return true;
             }
                 // No valid transition in Büchi automaton for current marking;
@@ -163,7 +156,7 @@ namespace LTL {
                     // reset buchi successors
                     _buchi_succ_gen.prepare(_buchi_parent);
                     if (next_buchi_succ(state)) {
-                        sucinfo._buchi_state = state.get_buchi_state();
+                        sucinfo._buchi_edge = _buchi_succ_gen.edge();
                         return true;
                     }
                 }
@@ -195,17 +188,17 @@ namespace LTL {
         const PetriEngine::PetriNet& _net;
         BuchiSuccessorGenerator _buchi_succ_gen;
 
-        bdd _cond;
+        const bdd* _cond = nullptr;
         size_t _buchi_parent;
         bool _fresh_marking = true;
         std::vector<guard_info_t> _stateToGuards;
         /**
          * Evaluate binary decision diagram (BDD) representation of transition guard in given state.
          */
-        bool guard_valid(const PetriEngine::Structures::State &state, bdd bdd)
+        bool guard_valid(const PetriEngine::Structures::State &state, const bdd& guard)
         {
             PetriEngine::PQL::EvaluationContext ctx{state.marking(), &_net};
-            auto res = _buchi_succ_gen.automaton().guard_valid(ctx, bdd);
+            auto res = _buchi_succ_gen.automaton().guard_valid(ctx, guard);
             return res;
         }
 
@@ -216,7 +209,7 @@ namespace LTL {
         {
             size_t tmp;
             while (_buchi_succ_gen.next(tmp, _cond)) {
-                if (guard_valid(state, _cond)) {
+                if (_buchi_succ_gen.guard_valid(_net, state.marking())) {
                     state.set_buchi_state(tmp);
                     return true;
                 }
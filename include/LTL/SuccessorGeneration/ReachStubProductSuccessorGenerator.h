@@ -90,6 +90,11 @@ namespace LTL {
             ProductSuccessorGenerator<S>::prepare(state, sucinfo);
         }
 
+        void set_query_lock(std::mutex* lock)
+        {
+            _reach->set_query_lock(lock);
+        }
+
     private:
         void set_spooler(SuccessorSpooler& spooler)
         {
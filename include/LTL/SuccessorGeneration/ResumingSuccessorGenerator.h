@@ -33,7 +33,8 @@ namespace LTL {
         struct successor_info_t {
             uint32_t _pcounter;
             uint32_t _tcounter;
-            size_t _buchi_state;
+            // the Büchi edge of the last successor, see BuchiSuccessorGenerator::edge
+            size_t _buchi_edge;
             size_t _last_state;
 
             bool has_prev_state() const {
@@ -50,7 +51,7 @@ namespace LTL {
 
             static constexpr auto NoPCounter = 0;
             static constexpr auto NoTCounter = std::numeric_limits<uint32_t>::max();
-            static constexpr auto NoBuchiState = std::numeric_limits<size_t>::max();
+            static constexpr auto NoBuchiEdge = std::numeric_limits<size_t>::max();
             static constexpr auto NoLastState = std::numeric_limits<size_t>::max();
         };
     public:
@@ -84,6 +85,7 @@ namespace LTL {
         }
 
         using SuccessorGenerator::getParent;
+        using SuccessorGenerator::setIncremental;
 
         uint32_t fired() const {
             return _suc_tcounter - 1;
@@ -92,7 +94,7 @@ namespace LTL {
         static constexpr successor_info_t _initial_suc_info{
             successor_info_t::NoPCounter,
             successor_info_t::NoTCounter,
-            successor_info_t::NoBuchiState,
+            successor_info_t::NoBuchiEdge,
             successor_info_t::NoLastState};
 
         auto initial_suc_info() {
@@ -35,6 +35,7 @@ namespace LTL {
         }
 
         using SuccessorGenerator::getParent;
+        using SuccessorGenerator::setIncremental;
 
         size_t state_size() const {
             return _net.numberOfPlaces();
@@ -46,11 +47,12 @@ namespace LTL {
 
         struct successor_info_t {
             SuccessorQueue<> _successors;
-            size_t _buchi_state;
+            // the Büchi edge of the last successor, see BuchiSuccessorGenerator::edge
+            size_t _buchi_edge;
             size_t _last_state;
             size_t _transition;
 
-            successor_info_t(size_t buchiState, size_t lastState) : _buchi_state(buchiState), _last_state(lastState) {}
+            successor_info_t(size_t buchiEdge, size_t lastState) : _buchi_edge(buchiEdge), _last_state(lastState) {}
 
             [[nodiscard]] bool has_prev_state() const
             {
@@ -61,9 +63,9 @@ namespace LTL {
                 return _transition;
             }
 
-            [[nodiscard]] bool fresh() const { return _buchi_state == NoBuchiState && _last_state == NoLastState; }
+            [[nodiscard]] bool fresh() const { return _buchi_edge == NoBuchiEdge && _last_state == NoLastState; }
 
-            static constexpr auto NoBuchiState = std::numeric_limits<size_t>::max();
+            static constexpr auto NoBuchiEdge = std::numeric_limits<size_t>::max();
             static constexpr auto NoLastState = std::numeric_limits<size_t>::max();
         };
 
@@ -79,7 +81,7 @@ namespace LTL {
 
         [[nodiscard]] successor_info_t initial_suc_info()
         {
-            return successor_info_t{successor_info_t::NoBuchiState, successor_info_t::NoLastState};
+            return successor_info_t{successor_info_t::NoBuchiEdge, successor_info_t::NoLastState};
         }
 
         bool prepare(const PetriEngine::Structures::State *state)
@@ -181,10 +183,12 @@ namespace LTL {
             } else {
                 auto evaluate_heuristic = [&] (uint32_t tid) {
                     SuccessorGenerator::_fire(_statebuf, tid);
-                    _statebuf.set_buchi_state(sucinfo._buchi_state);
+                    // the Büchi successors are not known yet, so guide by the Büchi state of the parent
+                    _statebuf.set_buchi_state(parent->get_buchi_state());
                     return _heuristic->eval(_statebuf, tid);
                 };
 
+                _heuristic->prepare(*parent);
                 // list of (transition, weight)
                 std::vector<std::pair<uint32_t, uint32_t>> weighted_tids;
                 // grab previous stubborn transitions
@@ -20,6 +20,8 @@
 
 #include "LTL/Structures/ProductState.h"
 
+#include <mutex>
+
 namespace LTL {
     class SuccessorSpooler {
     public:
@@ -39,7 +41,19 @@ namespace LTL {
             return false;
         }
 
+        /**
+         * Serialise the parts of prepare which annotate the (shared) query objects
+         * on the given lock, allowing several searches over the same formula to run in parallel.
+         */
+        void set_query_lock(std::mutex* lock)
+        {
+            _query_lock = lock;
+        }
+
         static constexpr uint32_t NoTransition = std::numeric_limits<uint32_t>::max();
+
+    protected:
+        std::mutex* _query_lock = nullptr;
     };
 }
 
@@ -0,0 +1,59 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef BINARYNET_H
+#define BINARYNET_H
+
+#include "PetriNetBuilder.h"
+#include "utils/structures/shared_string.h"
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+namespace PetriEngine {
+
+    /**
+     * A versioned binary image of an unfolded (and possibly reduced) net, which is
+     * loaded without parsing, unfolding or reducing it again.
+     * The image holds the arrays of the PetriNet (transitions, arcs and initial
+     * marking), the names and locations of places and transitions, the names of the
+     * colored places and transitions they were unfolded from, so colored queries
+     * can still be unfolded, and the data the reducer needs to reconstruct traces.
+     * The arrays are aligned in the file and read from a mapping of it.
+     * Numbers are in the byte order of the machine which wrote the image.
+     */
+    class BinaryNet {
+    public:
+        static constexpr uint32_t VERSION = 1;
+
+        /** Writes the net of builder with the trace data of its reducer */
+        static void write(std::ostream& out, const PetriNetBuilder& builder, bool colored,
+                          const shared_name_name_map& transition_names,
+                          const shared_place_color_map& place_names);
+
+        /**
+         * Reads the image in file into an empty builder, the names of the
+         * colored net into transition_names and place_names.
+         * @return true if the net was unfolded from a colored net
+         */
+        static bool read(const std::string& file, PetriNetBuilder& builder,
+                         shared_name_name_map& transition_names,
+                         shared_place_color_map& place_names);
+    };
+}
+
+#endif // BINARYNET_H
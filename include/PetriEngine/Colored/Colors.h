@@ -27,6 +27,8 @@
 #include <utility>
 #include <vector>
 #include <unordered_map>
+#include <mutex>
+#include <shared_mutex>
 #include <iostream>
 #include <cassert>
 
@@ -193,7 +195,9 @@ namespace PetriEngine {
         class ProductType : public ColorType {
         private:
             std::vector<const ColorType*> _constituents;
+            // the colors are made when first asked for, possibly by several unfolding threads
             mutable std::unordered_map<size_t,Color> _cache;
+            mutable std::shared_mutex _cacheLock;
 
         public:
             ProductType(const std::string& name = "Undefined") : ColorType(name) {}
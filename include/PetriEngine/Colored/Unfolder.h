@@ -35,6 +35,8 @@
 #include "PetriEngine/PetriNetBuilder.h"
 #include "VariableSymmetry.h"
 
+#include <limits>
+
 
 namespace PetriEngine {
     class ColoredPetriNetBuilder;
@@ -44,13 +46,39 @@ namespace PetriEngine {
             const ColoredPetriNetBuilder& _builder;
             void getArcIntervals(const Colored::Transition& transition, bool &transitionActivated, uint32_t max_intervals, uint32_t transitionId);
 
+            // the sum place of an inhibited place, in place of the id of an unfolded place
+            static constexpr uint32_t SUM_PLACE = std::numeric_limits<uint32_t>::max();
+
+            // an arc of an unfolded transition, evaluated before anything is added to the builder
+            struct unfolded_arc_t {
+                uint32_t place;
+                uint32_t id;
+                const Colored::Color* color;
+                uint32_t weight;
+                bool input;
+            };
+
+            struct unfolded_transition_t {
+                shared_const_string name;
+                std::vector<unfolded_arc_t> arcs;
+                Colored::BindingMap binding; // only kept when the bindings are printed
+            };
+
+            // the bindings of a colored transition, which only read the colored net and so
+            // are evaluated by several threads, while the builder is extended by one in order
+            void evaluateTransition(uint32_t transitionId, std::vector<unfolded_transition_t>& unfolded) const;
+            void evaluateArc(const Colored::Arc& arc, const Colored::BindingMap& binding, std::vector<unfolded_arc_t>& arcs) const;
+            void addTransition(PetriNetBuilder& ptBuilder, uint32_t transitionId, const std::vector<unfolded_transition_t>& unfolded);
+            void addArc(PetriNetBuilder& ptBuilder, const unfolded_arc_t& arc, const shared_const_string& tName);
+            void unfoldInParallel(PetriNetBuilder& ptBuilder, uint32_t threads);
+            void unfoldLazily(PetriNetBuilder& ptBuilder);
+            const Colored::Color* unfoldedColor(uint32_t placeId, const Colored::Color* color, uint32_t& id, std::vector<uint32_t>& tupleIds) const;
+
             void unfoldPlace(PetriNetBuilder& ptBuilder, const Colored::Place* place, const PetriEngine::Colored::Color *color, uint32_t unfoldPlace, uint32_t id);
-            void unfoldTransition(PetriNetBuilder& builder, uint32_t transitionId);
             void handleOrphanPlace(PetriNetBuilder& ptBuilder, const Colored::Place& place, const shared_name_index_map& unfoldedPlaceMap);
             void createPartionVarmaps();
             void unfoldInhibitorArc(PetriNetBuilder& ptBuilder, const shared_const_string &oldname, const shared_const_string &newname);
             std::string arc_to_string(const Colored::Arc& arc) const;
-            void unfoldArc(PetriNetBuilder& ptBuilder, const Colored::Arc& arc, const Colored::BindingMap& binding, const shared_const_string& name);
             double _time = 0;
             shared_place_color_map _ptplacenames;
             shared_name_name_map _pttransitionnames;
@@ -72,7 +100,14 @@ namespace PetriEngine {
               _fixed_point(fixed_point),
               _print_bindings(print_bindings) {}
 
-            PetriNetBuilder unfold();
+            /**
+             * Unfolds the colored net. With more than one thread the bindings of the
+             * transitions are evaluated in parallel, the net is the same as with one.
+             * A lazy unfolding only evaluates a colored transition once each of its input
+             * places may hold a token, and only adds a binding once each of its input
+             * places may, so the transitions which can never fire are left out.
+             */
+            PetriNetBuilder unfold(uint32_t threads = 1, bool lazy = false);
 
             size_t number_of_arcs() const { return _nptarcs; }
 
@@ -0,0 +1,88 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef ENABLEDNESSKERNEL_H
+#define ENABLEDNESSKERNEL_H
+
+#include "PetriNet.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace PetriEngine {
+
+    /**
+     * Computes the enabled transitions of a marking in bulk.
+     * The input arcs of the net are kept as a structure-of-arrays (place, weight,
+     * inhibitor-mask) in the order of the transitions. As transitions are grouped
+     * by the place they consume from, the candidates of a marking are a few runs
+     * of transitions, whose arcs are compared against the marking at once, using
+     * AVX2 when the CPU supports it. This yields a bitmask of failing arcs; a
+     * transition is enabled if none of its arcs fail.
+     */
+    class EnablednessKernel {
+    public:
+        explicit EnablednessKernel(const PetriNet& net);
+
+        /** Computes the enabled transitions of marking */
+        void compute(const MarkVal* marking);
+
+        /**
+         * Computes the enabled transitions of marking from those of the previous
+         * marking, only rechecking the consumers of the places that changed.
+         * Falls back to compute if too many places changed.
+         */
+        void update(const MarkVal* marking);
+
+        bool enabled(uint32_t t) const {
+            return (_enabled[t / 64] >> (t % 64)) & 1;
+        }
+
+        /** The first enabled transition in [from, to), or to if there is none */
+        uint32_t next(uint32_t from, uint32_t to) const;
+
+        /** The bitmask of enabled transitions, bit t%64 of word t/64 is transition t */
+        const uint64_t* mask() const { return _enabled.data(); }
+
+        /** True if the AVX2 kernel is used */
+        static bool vectorised();
+
+    private:
+        bool anyFailed(uint32_t from, uint32_t to) const;
+        void failed(uint32_t from, uint32_t to, const MarkVal* marking);
+        bool fireable(uint32_t t, const MarkVal* marking) const;
+
+        const PetriNet* _net;
+        uint32_t _nplaces;
+        uint32_t _ntransitions;
+        uint32_t _narcs;
+        // first transition consuming from each place, see PetriNet::_placeToPtrs
+        std::vector<uint32_t> _consumers;
+        // first input arc of each transition, with a sentinel at the end
+        std::vector<uint32_t> _first;
+        std::vector<uint32_t> _places;
+        std::vector<uint32_t> _weights;
+        std::vector<uint32_t> _inhibitor;
+        std::vector<uint64_t> _failed;
+        std::vector<uint64_t> _enabled;
+        // the marking of the current mask, for update
+        std::vector<MarkVal> _marking;
+        bool _valid = false;
+        std::vector<uint32_t> _changed;
+    };
+}
+
+#endif // ENABLEDNESSKERNEL_H
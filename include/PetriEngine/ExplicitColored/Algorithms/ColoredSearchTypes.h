@@ -6,6 +6,12 @@
 #include "PetriEngine/ExplicitColored/Visitors/HeuristicVisitor.h"
 
 namespace PetriEngine::ExplicitColored {
+    // A state in an encoded waiting list, which is decoded from the passed list when it is popped
+    struct EncodedState {
+        size_t encodingId;
+        size_t id;
+    };
+
     template <typename T>
     class DFSStructure {
     public:
@@ -136,6 +142,22 @@ namespace PetriEngine::ExplicitColored {
             });
         }
 
+        // Adds a state which does not hold its marking
+        void add(T state, const ColoredPetriNetMarking& marking) {
+            const MarkingCount_t weight = _query->distance(marking, _negQuery);
+
+            _queue.push(WeightedState<T> {
+                std::move(state),
+                weight
+            });
+        }
+
+        // Weighs the states added from now on by another query, the waiting states keep their weight
+        void setQuery(std::shared_ptr<ExplicitQueryProposition> query, const bool negQuery) {
+            _query = std::move(query);
+            _negQuery = negQuery;
+        }
+
         [[nodiscard]] bool empty() const {
             return _queue.empty();
         }
@@ -6,12 +6,11 @@
 #include "PetriEngine/ExplicitColored/ColoredPetriNet.h"
 #include "PetriEngine/ExplicitColored/ColoredResultPrinter.h"
 #include "PetriEngine/ExplicitColored/Algorithms/SearchStatistics.h"
+#include "PetriEngine/ExplicitColored/Algorithms/ColoredSearchTypes.h"
 #include "PetriEngine/ExplicitColored/SuccessorGenerator/ColoredSuccessorGenerator.h"
 #include "PetriEngine/ExplicitColored/ColoredEncoder.h"
 
 namespace PetriEngine::ExplicitColored {
-    template <typename T>
-    class RDFSStructure;
     class ColoredResultPrinter;
 
     enum class Quantifier {
@@ -28,6 +27,20 @@ namespace PetriEngine::ExplicitColored {
         Transition_t transition;
     };
 
+    struct ExplicitQuery {
+        std::shared_ptr<ExplicitQueryProposition> gammaQuery;
+        Quantifier quantifier;
+        Reachability::AbstractHandler::Result result = Reachability::AbstractHandler::Unknown;
+        std::optional<uint64_t> counterExampleId;
+        // the statistics of the search when the query was decided
+        SearchStatistics searchStatistics;
+    };
+
+    /**
+     * Explores the state space of a colored net once for a batch of EF and AG queries.
+     * A query is retired as soon as a state decides it, the search stops when
+     * every query is decided or the state space is exhausted.
+     */
     class ExplicitWorklist {
     public:
         ExplicitWorklist(
@@ -39,37 +52,60 @@ namespace PetriEngine::ExplicitColored {
             bool createTrace
         );
 
-        bool check(Strategy searchStrategy, ColoredSuccessorGeneratorOption coloredSuccessorGeneratorOption);
+        ExplicitWorklist(
+            const ColoredPetriNet& net,
+            const std::vector<PQL::Condition_ptr>& queries,
+            const std::unordered_map<std::string, uint32_t>& placeNameIndices,
+            const std::unordered_map<std::string, Transition_t>& transitionNameIndices,
+            size_t seed,
+            bool createTrace
+        );
+
+        /**
+         * Searches the state space, returns true if the first query is satisfied.
+         * With encodedWaitingList the waiting list only holds the ids of the states in
+         * the passed list, and a state is decoded and fully expanded when it is popped.
+         */
+        bool check(Strategy searchStrategy, ColoredSuccessorGeneratorOption coloredSuccessorGeneratorOption, bool encodedWaitingList = false);
         [[nodiscard]] const SearchStatistics& GetSearchStatistics() const;
-        std::optional<uint64_t> getCounterExampleId() const;
+        [[nodiscard]] size_t numberOfQueries() const;
+        [[nodiscard]] Reachability::AbstractHandler::Result getResult(size_t query) const;
+        [[nodiscard]] const SearchStatistics& getSearchStatistics(size_t query) const;
+        std::optional<uint64_t> getCounterExampleId(size_t query = 0) const;
         std::optional<std::vector<InternalTraceStep>> getTraceTo(uint64_t counterExampleId) const;
     private:
-        std::shared_ptr<ExplicitQueryProposition> _gammaQuery;
-        std::optional<uint64_t> _counterExampleId;
-        Quantifier _quantifier;
+        std::vector<ExplicitQuery> _queries;
+        size_t _undecided;
+        // the query guiding the heuristic search
+        size_t _guide = 0;
         const ColoredPetriNet& _net;
         const ColoredSuccessorGenerator _successorGenerator;
         const size_t _seed;
         bool _fullStatespace = true;
         bool _createTrace;
+        bool _encodedWaitingList = false;
         StateMap _stateMap;
         SearchStatistics _searchStatistics;
         template <typename SuccessorGeneratorState>
-        [[nodiscard]] bool _search(Strategy searchStrategy);
-        [[nodiscard]] bool _check(const ColoredPetriNetMarking& state, size_t id) const;
+        void _search(Strategy searchStrategy);
+        [[nodiscard]] bool _check(const ColoredPetriNetMarking& state, size_t id);
+        void _decideRemaining(bool fullStatespace);
+        template <template <typename> typename WaitingList, typename T>
+        void _guideBy(WaitingList<T>& waiting);
 
         template <typename T>
-        [[nodiscard]] bool _dfs();
+        void _dfs();
         template <typename T>
-        [[nodiscard]] bool _bfs();
+        void _bfs();
         template <typename T>
-        [[nodiscard]] bool _rdfs();
+        void _rdfs();
         template <typename T>
-        [[nodiscard]] bool _bestfs();
+        void _bestfs();
 
         template <template <typename> typename WaitingList, typename T>
-        [[nodiscard]] bool _genericSearch(WaitingList<T> waiting);
-        [[nodiscard]] bool _getResult(bool found, bool fullStatespace) const;
+        void _genericSearch(WaitingList<T> waiting);
+        template <template <typename> typename WaitingList, typename T>
+        void _encodedSearch(WaitingList<EncodedState> waiting);
     };
 }
 
@@ -5,6 +5,7 @@
 #include "ExplicitColoredPetriNetBuilder.h"
 #include "PetriEngine/ExplicitColored/Algorithms/SearchStatistics.h"
 #include "PetriEngine/Reachability/ReachabilityResult.h"
+#include <memory>
 
 namespace PetriEngine::ExplicitColored {
     struct TraceStep {
@@ -31,12 +32,13 @@ namespace PetriEngine::ExplicitColored {
 
     struct ExplicitColoredTraceContext
     {
-        ExplicitColoredTraceContext(std::vector<TraceStep> traceSteps, ExplicitColoredPetriNetBuilder cpnBuilder)
+        ExplicitColoredTraceContext(std::vector<TraceStep> traceSteps, std::shared_ptr<const ExplicitColoredPetriNetBuilder> cpnBuilder)
             : traceSteps(std::move(traceSteps)), cpnBuilder(std::move(cpnBuilder)) {}
         ExplicitColoredTraceContext(ExplicitColoredTraceContext&&) = default;
         ExplicitColoredTraceContext& operator=(ExplicitColoredTraceContext&&) = default;
         std::vector<TraceStep> traceSteps;
-        ExplicitColoredPetriNetBuilder cpnBuilder;
+        // shared by the traces of all queries checked in the same exploration
+        std::shared_ptr<const ExplicitColoredPetriNetBuilder> cpnBuilder;
     };
 
     class IColoredResultPrinter {
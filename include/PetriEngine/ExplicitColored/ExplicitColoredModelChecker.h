@@ -28,6 +28,17 @@ namespace PetriEngine::ExplicitColored {
             options_t& options,
             IColoredResultPrinter* resultPrinter = nullptr
         ) const;
+
+        /**
+         * Checks a batch of reachability queries, the queries not decided by the
+         * color ignorant LP share a single exploration of the state space.
+         * resultPrinters[i], if any, prints the result of queries[i].
+         */
+        std::vector<Result> checkQueries(
+            const std::vector<PQL::Condition_ptr>& queries,
+            options_t& options,
+            const std::vector<IColoredResultPrinter*>& resultPrinters = {}
+        ) const;
     private:
         Result checkColorIgnorantLP(
             const std::string& pnmlModel,
@@ -35,11 +46,11 @@ namespace PetriEngine::ExplicitColored {
             options_t& options
         ) const;
 
-        std::pair<Result, std::optional<ExplicitColoredTraceContext>> explicitColorCheck(
+        std::vector<Result> explicitColorCheck(
             const std::string& pnmlModel,
-            const PQL::Condition_ptr& query,
+            const std::vector<PQL::Condition_ptr>& queries,
             options_t& options,
-            SearchStatistics* searchStatistics
+            const std::vector<IColoredResultPrinter*>& resultPrinters
         ) const;
 
         Result checkFireabilityColorIgnorantLP(
@@ -62,7 +73,7 @@ namespace PetriEngine::ExplicitColored {
         void _reduce(
             const std::string& pnmlModel,
             std::stringstream& out,
-            const PQL::Condition_ptr& query,
+            const std::vector<PQL::Condition_ptr>& queries,
             options_t& options
         ) const;
 
@@ -0,0 +1,91 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef NETCACHE_H
+#define NETCACHE_H
+
+#include "PetriNetBuilder.h"
+#include "utils/structures/shared_string.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace PetriEngine {
+
+    /**
+     * A directory of binary nets (see BinaryNet), each stored under a hash of
+     * everything it was computed from: the model, the options and, where the
+     * net depends on them, the queries. Nets are written to a temporary file
+     * and renamed into place, so runs sharing the directory never see half a net.
+     */
+    class NetCache {
+    public:
+        /** An incremental 64-bit FNV-1a hash */
+        class Key {
+        public:
+            Key& add(const void* data, size_t size);
+
+            Key& add(std::string_view s) {
+                add<uint64_t>(s.size());
+                return add(s.data(), s.size());
+            }
+
+            template<typename T, typename = std::enable_if_t<std::is_arithmetic_v<T> || std::is_enum_v<T>>>
+            Key& add(T v) { return add(&v, sizeof(T)); }
+
+            std::string str() const;
+
+        private:
+            uint64_t _hash = 14695981039346656037ULL;
+        };
+
+        /** A net read from the cache, with the names of the colored net it was unfolded from */
+        struct net_t {
+            explicit net_t(shared_string_set& string_set) : builder(string_set) {}
+            std::string file;
+            PetriNetBuilder builder;
+            bool colored = false;
+            shared_name_name_map transition_names;
+            shared_place_color_map place_names;
+        };
+
+        explicit NetCache(std::string directory) : _directory(std::move(directory)) {}
+
+        /** The file of the net stored under key, empty if there is none */
+        std::string find(const Key& key) const;
+
+        /**
+         * Reads the net stored under key, nullptr if there is none. A net which cannot be
+         * read, e.g. a truncated file, is only reported, it is replaced by the next store.
+         */
+        std::unique_ptr<net_t> load(const Key& key, shared_string_set& string_set) const;
+
+        /** Stores the net of builder under key, a net which cannot be stored is only reported */
+        void store(const Key& key, const PetriNetBuilder& builder, bool colored,
+                   const shared_name_name_map& transition_names,
+                   const shared_place_color_map& place_names) const;
+
+    private:
+        std::string file(const Key& key) const;
+
+        std::string _directory;
+    };
+}
+
+#endif // NETCACHE_H
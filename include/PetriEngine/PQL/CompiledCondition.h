@@ -0,0 +1,156 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VERIFYPN_COMPILEDCONDITION_H
+#define VERIFYPN_COMPILEDCONDITION_H
+
+#include "PQL.h"
+#include "Contexts.h"
+#include "Evaluation.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace PetriEngine { namespace PQL {
+
+    /**
+     * A condition lowered into a flat program over the indices of the marking,
+     * evaluated without visitors or shared pointers.
+     * Every instruction is an atomic proposition: a linear combination of places
+     * compared to zero, a conjunction of place bounds (which is also what fireability
+     * is analysed into), deadlock or a constant. Each instruction names the instruction
+     * to continue with when it holds and when it does not, which gives the short-circuiting
+     * of conjunctions and disjunctions; negations only swap the two.
+     * Temporal operators are only supported on top of the state formula, where they
+     * map its value as the EvaluateVisitor does. Conditions which cannot be lowered
+     * (nested temporal operators, upper bounds, non-linear products and path selections)
+     * give an invalid program, and must be evaluated by the visitors instead.
+     */
+    class CompiledCondition {
+    public:
+        CompiledCondition() = default;
+        explicit CompiledCondition(const Condition* condition);
+
+        /** False if the condition could not be lowered */
+        bool valid() const { return _valid; }
+
+        /** The number of instructions */
+        size_t size() const { return _program.size(); }
+
+        /** Same result as PQL::evaluate, the program must be valid */
+        Condition::Result evaluate(const MarkVal* marking, const PetriNet* net) const
+        {
+            const uint32_t end = _program.size();
+            uint32_t pc = 0;
+            while (pc < end) {
+                const instruction_t& i = _program[pc];
+                pc = holds(i, marking, net) ? i._on_true : i._on_false;
+            }
+            return pc == end ? _on_accept : _on_reject;
+        }
+
+        Condition::Result evaluate(const EvaluationContext& context) const
+        {
+            return evaluate(context.marking(), context.net());
+        }
+
+    private:
+        enum op_t : uint8_t {
+            LESS, LESS_EQUAL, EQUAL, NOT_EQUAL, BOUNDS, DEADLOCK, CONSTANT
+        };
+
+        struct instruction_t {
+            op_t _op;
+            // the instruction to continue with, end of program to accept and past it to reject
+            uint32_t _on_true;
+            uint32_t _on_false;
+            // into _terms or _bounds
+            uint32_t _first;
+            uint32_t _last;
+            int64_t _constant;
+        };
+
+        struct term_t {
+            uint32_t _place;
+            int64_t _coefficient;
+        };
+
+        struct bound_t {
+            uint32_t _place;
+            uint32_t _lower;
+            uint32_t _upper;
+        };
+
+        struct linear_t {
+            int64_t _constant = 0;
+            std::vector<term_t> _terms;
+        };
+
+        bool holds(const instruction_t& i, const MarkVal* marking, const PetriNet* net) const
+        {
+            switch (i._op) {
+                case BOUNDS:
+                    for (uint32_t b = i._first; b < i._last; ++b) {
+                        const MarkVal m = marking[_bounds[b]._place];
+                        if (m < _bounds[b]._lower || m > _bounds[b]._upper)
+                            return false;
+                    }
+                    return true;
+                case DEADLOCK:
+                    return net != nullptr && net->deadlocked(marking);
+                case CONSTANT:
+                    return i._constant != 0;
+                default:
+                    break;
+            }
+            int64_t value = i._constant;
+            for (uint32_t t = i._first; t < i._last; ++t)
+                value += _terms[t]._coefficient * (int64_t)marking[_terms[t]._place];
+            switch (i._op) {
+                case LESS:       return value < 0;
+                case LESS_EQUAL: return value <= 0;
+                case EQUAL:      return value == 0;
+                default:         return value != 0;
+            }
+        }
+
+        bool compileTop(const Condition* condition);
+        bool compile(const Condition* condition, uint32_t on_true, uint32_t on_false);
+        bool linearize(const Expr* expr, linear_t& result) const;
+        uint32_t label();
+        void emit(op_t op, uint32_t on_true, uint32_t on_false, uint32_t first = 0, uint32_t last = 0, int64_t constant = 0);
+
+        std::vector<instruction_t> _program;
+        std::vector<term_t> _terms;
+        std::vector<bound_t> _bounds;
+        // the instruction of each label while compiling
+        std::vector<uint32_t> _labels;
+        Condition::Result _on_accept = Condition::RTRUE;
+        Condition::Result _on_reject = Condition::RFALSE;
+        bool _valid = false;
+    };
+
+    /** Evaluates with compiled if it is valid, otherwise with the visitors */
+    inline Condition::Result evaluate(const CompiledCondition& compiled, Condition* element, const EvaluationContext& context)
+    {
+        if (compiled.valid())
+            return compiled.evaluate(context);
+        return evaluate(element, context);
+    }
+} }
+
+#endif // VERIFYPN_COMPILEDCONDITION_H
@@ -33,6 +33,7 @@
 #include <vector>
 #include <list>
 #include <map>
+#include <atomic>
 #include <chrono>
 #include <glpk.h>
 
@@ -186,7 +187,6 @@ namespace PetriEngine {
                 _negated = false;
                 _marking = marking;
                 _net = net;
-                _base_lp = buildBase();
                 _start = std::chrono::high_resolution_clock::now();
                 _cache = cache;
                 _markingOutOfBounds = false;
@@ -231,11 +231,18 @@ namespace PetriEngine {
             double getReductionTime();
 
             bool timeout() const {
+                if (_abort != nullptr && *_abort)
+                    return true;
                 auto end = std::chrono::high_resolution_clock::now();
                 auto diff = std::chrono::duration_cast<std::chrono::seconds>(end - _start);
                 return (diff.count() >= _queryTimeout);
             }
 
+            // lets another thread cut the simplification short, as if it timed out
+            void setAbort(const std::atomic<bool>* abort) {
+                _abort = abort;
+            }
+
             bool potencyTimeout() const {
                 auto end = std::chrono::high_resolution_clock::now();
                 auto diff = std::chrono::duration_cast<std::chrono::seconds>(end - _start);
@@ -251,6 +258,8 @@ namespace PetriEngine {
             }
 
             glp_prob* makeBaseLP() const;
+            // a fresh state equation of the net from the marking, nullptr on timeout
+            glp_prob* buildBase() const;
 
         private:
             bool _negated;
@@ -261,8 +270,7 @@ namespace PetriEngine {
             mutable glp_prob* _base_lp = nullptr;
             std::chrono::high_resolution_clock::time_point _start;
             Simplification::LPCache* _cache;
-
-            glp_prob* buildBase() const;
+            const std::atomic<bool>* _abort = nullptr;
         };
 
     } // PQL
@@ -0,0 +1,103 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VERIFYPN_DEEPCOPY_H
+#define VERIFYPN_DEEPCOPY_H
+
+#include "Visitor.h"
+
+namespace PetriEngine { namespace PQL {
+    /**
+     * Copies every node of an analysed formula, so the copy can be evaluated and annotated
+     * on another thread than the original. Shared constants such as DEADLOCK are copied too.
+     */
+    Condition_ptr deepCopy(const Condition_ptr& condition);
+    Expr_ptr deepCopy(const Expr_ptr& expr);
+
+    class DeepCopyVisitor : public Visitor {
+    public:
+        Condition_ptr copy(const Condition_ptr& condition);
+        Expr_ptr copy(const Expr_ptr& expr);
+
+    private:
+        Condition_ptr _condition;
+        Expr_ptr _expr;
+
+        template<typename T>
+        std::shared_ptr<T> quantifier(const T* element);
+        template<typename T>
+        std::shared_ptr<T> until(const T* element);
+        template<typename T>
+        std::shared_ptr<T> logical(const T* element);
+        template<typename T>
+        std::shared_ptr<T> compare(const T* element);
+        template<typename T>
+        std::shared_ptr<T> shallow(const T* element);
+        template<typename T>
+        std::shared_ptr<T> nary(const T* element);
+
+        void _accept(const NotCondition *element) override;
+        void _accept(const AndCondition *element) override;
+        void _accept(const OrCondition *element) override;
+        void _accept(const LessThanCondition *element) override;
+        void _accept(const LessThanOrEqualCondition *element) override;
+        void _accept(const EqualCondition *element) override;
+        void _accept(const NotEqualCondition *element) override;
+        void _accept(const DeadlockCondition *element) override;
+        void _accept(const CompareConjunction *element) override;
+        void _accept(const UnfoldedUpperBoundsCondition *element) override;
+        void _accept(const BooleanCondition *element) override;
+
+        void _accept(const ControlCondition *condition) override;
+        void _accept(const EFCondition *condition) override;
+        void _accept(const EGCondition *condition) override;
+        void _accept(const AGCondition *condition) override;
+        void _accept(const AFCondition *condition) override;
+        void _accept(const EXCondition *condition) override;
+        void _accept(const AXCondition *condition) override;
+        void _accept(const EUCondition *condition) override;
+        void _accept(const AUCondition *condition) override;
+        void _accept(const ACondition *condition) override;
+        void _accept(const ECondition *condition) override;
+        void _accept(const GCondition *condition) override;
+        void _accept(const FCondition *condition) override;
+        void _accept(const XCondition *condition) override;
+        void _accept(const UntilCondition *condition) override;
+        void _accept(const AllPaths *element) override;
+        void _accept(const ExistPath *element) override;
+        void _accept(const PathSelectCondition *element) override;
+
+        void _accept(const UnfoldedFireableCondition *element) override;
+        void _accept(const FireableCondition *element) override;
+        void _accept(const UpperBoundsCondition *element) override;
+        void _accept(const LivenessCondition *element) override;
+        void _accept(const KSafeCondition *element) override;
+        void _accept(const QuasiLivenessCondition *element) override;
+        void _accept(const StableMarkingCondition *element) override;
+
+        void _accept(const UnfoldedIdentifierExpr *element) override;
+        void _accept(const LiteralExpr *element) override;
+        void _accept(const PlusExpr *element) override;
+        void _accept(const MultiplyExpr *element) override;
+        void _accept(const MinusExpr *element) override;
+        void _accept(const SubtractExpr *element) override;
+        void _accept(const IdentifierExpr *element) override;
+        void _accept(const PathSelectExpr *element) override;
+    };
+} }
+
+#endif //VERIFYPN_DEEPCOPY_H
@@ -224,6 +224,7 @@ namespace PetriEngine {
 
         /** Base class for all binary expressions */
         class NaryExpr : public Expr {
+            friend class DeepCopyVisitor;
         protected:
             NaryExpr() {};
         public:
@@ -310,6 +311,7 @@ namespace PetriEngine {
         };
 
         class PathSelectExpr : public Expr {
+            friend class DeepCopyVisitor;
         private:
             std::string _name;
             size_t _offset;
@@ -327,6 +329,7 @@ namespace PetriEngine {
 
         /** Unary minus expression*/
         class MinusExpr : public Expr {
+            friend class DeepCopyVisitor;
         public:
 
             MinusExpr(const Expr_ptr expr) {
@@ -360,6 +363,7 @@ namespace PetriEngine {
 
         class IdentifierExpr : public Expr {
             friend class AnalyzeVisitor;
+            friend class DeepCopyVisitor;
         public:
             IdentifierExpr(shared_const_string name) : _name(name) {}
             IdentifierExpr(const IdentifierExpr&) = default;
@@ -417,6 +421,7 @@ namespace PetriEngine {
 
         class ShallowCondition : public Condition
         {
+            friend class DeepCopyVisitor;
             uint32_t distance(DistanceContext& context) const override
             { return _compiled->distance(context); }
 
@@ -435,6 +440,7 @@ namespace PetriEngine {
 
         /* Not condition */
         class NotCondition : public Condition {
+            friend class DeepCopyVisitor;
         public:
 
             NotCondition(const Condition_ptr cond) {
@@ -456,6 +462,7 @@ namespace PetriEngine {
         /******************** TEMPORAL OPERATORS ********************/
 
         class PathQuant : public Condition {
+            friend class DeepCopyVisitor;
         private:
             std::string _id;
             size_t _offset;
@@ -489,6 +496,7 @@ namespace PetriEngine {
         };
 
         class PathSelectCondition : public Condition {
+            friend class DeepCopyVisitor;
         private:
             std::string _name;
             size_t _offset;
@@ -526,6 +534,7 @@ namespace PetriEngine {
         };
 
         class SimpleQuantifierCondition : public QuantifierCondition {
+            friend class DeepCopyVisitor;
         public:
             template<typename T>
             SimpleQuantifierCondition(std::shared_ptr<T> cond) {
@@ -690,6 +699,7 @@ namespace PetriEngine {
         };
 
         class UntilCondition : public QuantifierCondition {
+            friend class DeepCopyVisitor;
         public:
             UntilCondition(const Condition_ptr cond1, const Condition_ptr cond2) {
                 _cond1 = cond1;
@@ -760,6 +770,7 @@ namespace PetriEngine {
 
         /* Logical conditon */
         class LogicalCondition : public Condition {
+            friend class DeepCopyVisitor;
         public:
             const Condition_ptr& operator[](size_t i) const
             {
@@ -898,6 +909,7 @@ namespace PetriEngine {
 
         /* Comparison conditon */
         class CompareCondition : public Condition {
+            friend class DeepCopyVisitor;
         public:
 
             CompareCondition(const Expr_ptr expr1, const Expr_ptr expr2)
@@ -1030,6 +1042,7 @@ namespace PetriEngine {
         class KSafeCondition : public ShallowCondition
         {
             friend class AnalyzeVisitor;
+            friend class DeepCopyVisitor;
         public:
             KSafeCondition(const Expr_ptr& expr1) : _bound(expr1)
             {}
@@ -0,0 +1,89 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VERIFYPN_INCREMENTALDISTANCE_H
+#define VERIFYPN_INCREMENTALDISTANCE_H
+
+#include "PQL.h"
+#include "Contexts.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace PetriEngine { namespace PQL {
+
+    /**
+     * Computes Condition::distance of the successors of a marking incrementally.
+     * The distance of the marking being expanded is computed from scratch by prepare,
+     * keeping the distance of every subformula. The distance of a successor then only
+     * recomputes the atomic propositions mentioning a place changed by the fired transition,
+     * and the conjunctions and disjunctions above them.
+     * The results are the same as those of Condition::distance. Queries whose distance
+     * does not only depend on the marking (upper bounds) give an invalid instance.
+     */
+    class IncrementalDistance {
+    public:
+        IncrementalDistance(const PetriNet& net, const Condition* query);
+
+        bool valid() const { return _valid; }
+
+        const Condition* query() const { return _query; }
+
+        /** The distance of marking, which becomes the parent of the successors given to distance */
+        uint32_t prepare(const MarkVal* marking);
+
+        /** The distance of marking, the successor of the prepared marking by firing transition t */
+        uint32_t distance(const MarkVal* marking, uint32_t t);
+
+    private:
+        enum kind_t : uint8_t { LEAF, SUM, MIN };
+
+        struct node_t {
+            kind_t _kind;
+            // the polarity of the DistanceContext of a leaf
+            bool _negated;
+            const Condition* _leaf;
+            // children are _children[_first] to _children[_last]
+            uint32_t _first;
+            uint32_t _last;
+        };
+
+        bool build(const Condition* condition, bool negated, uint32_t& node);
+        bool places(const Expr* expr, std::vector<uint32_t>& places) const;
+        void addLeaf(const Condition* condition, bool negated, std::vector<uint32_t>&& places, uint32_t& node);
+        uint32_t compute(const node_t& node, const MarkVal* marking) const;
+        const std::vector<uint32_t>& affected(uint32_t t);
+
+        const PetriNet& _net;
+        const Condition* _query;
+        // in post-order, the query is the last node
+        std::vector<node_t> _nodes;
+        std::vector<uint32_t> _children;
+        std::vector<uint32_t> _parents;
+        // the leaves mentioning each place
+        std::vector<std::vector<uint32_t>> _leaves;
+        // the nodes to recompute after firing each transition, in post-order, computed on first use
+        std::vector<std::vector<uint32_t>> _affected;
+        std::vector<bool> _known;
+        // the values of the prepared marking, and those of the successor
+        std::vector<uint32_t> _parent;
+        std::vector<uint32_t> _values;
+        bool _valid = false;
+    };
+} }
+
+#endif // VERIFYPN_INCREMENTALDISTANCE_H
@@ -78,6 +78,11 @@ namespace PetriEngine {
         uint32_t numberOfPlaces() const {
             return _nplaces;
         }
+        /** The transitions with an input or inhibitor arc from place */
+        std::pair<const uint32_t*, const uint32_t*> consumers(uint32_t place) const
+        {
+            return std::make_pair(_consumers.data() + _consumerPtrs[place], _consumers.data() + _consumerPtrs[place + 1]);
+        }
         uint32_t inArc(uint32_t place, uint32_t transition) const;
         uint32_t outArc(uint32_t transition, uint32_t place) const;
         bool controllable(uint32_t t) const
@@ -125,6 +130,7 @@ namespace PetriEngine {
         }
 
     private:
+        void constructConsumers();
 
         /** Number of x variables
          * @remarks We could also get this from the _places vector, but I don't see any
@@ -135,6 +141,9 @@ namespace PetriEngine {
         std::vector<TransPtr> _transitions;
         std::vector<Invariant> _invariants;
         std::vector<uint32_t> _placeToPtrs;
+        // all transitions reading a place, unlike _placeToPtrs which only has the "owner"
+        std::vector<uint32_t> _consumerPtrs;
+        std::vector<uint32_t> _consumers;
         std::vector<bool> _controllable;
         MarkVal* _initialMarking;
 
@@ -150,6 +159,8 @@ namespace PetriEngine {
         friend class ReducingSuccessorGenerator;
         friend class STSolver;
         friend class StubbornSet;
+        friend class EnablednessKernel;
+        friend class BinaryNet;
     };
 
 } // PetriEngine
@@ -34,6 +34,7 @@ namespace PetriEngine {
     class PetriNetBuilder : public AbstractPetriNetBuilder {
     public:
         friend class Reducer;
+        friend class BinaryNet;
 
     public:
         PetriNetBuilder(shared_string_set& string_set);
@@ -64,6 +65,11 @@ namespace PetriEngine {
 
         void saveInitialNet();
 
+        /** Removes all places and transitions and the trace data of the reducer, keeps the original size */
+        void clear();
+        /** Takes over the net and the trace data of the reducer of other, keeps the original size */
+        void takeNet(PetriNetBuilder&& other);
+
         virtual void sort() override;
         /** Make the resulting petri net, you take ownership */
         PetriNet* makePetriNet(bool reorder = true);
@@ -167,8 +173,8 @@ namespace PetriEngine {
         std::vector<PetriEngine::Transition> _transitions;
         std::vector<PetriEngine::Place> _places;
 
-        uint32_t _originalNumberOfPlaces;
-        uint32_t _originalNumberOfTransitions;
+        uint32_t _originalNumberOfPlaces = 0;
+        uint32_t _originalNumberOfTransitions = 0;
         std::vector<MarkVal> initialMarking;
         Reducer reducer;
         shared_string_set& _string_set;
@@ -0,0 +1,322 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef PARALLELREACHABILITYSEARCH_H
+#define PARALLELREACHABILITYSEARCH_H
+
+#include "ReachabilitySearch.h"
+#include "../Structures/SharedStateSet.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace PetriEngine {
+    namespace Reachability {
+
+        /**
+         * Multi-core reachability search. A number of workers explore the state-space
+         * concurrently over a shared passed-list, each with its own successor generator
+         * and waiting list. Workers running out of work steal states from the waiting
+         * lists of the others, and all workers stop as soon as the queries are decided.
+         * Workers finding nothing to steal sleep until another worker queues a state.
+         * Traces, random walks and upper-bounds are handled by the sequential search.
+         */
+        class ParallelReachabilitySearch : public ReachabilitySearch {
+        public:
+            ParallelReachabilitySearch(PetriNet& net, AbstractHandler& callback, uint32_t cores, int kbound = 0)
+            : ReachabilitySearch(net, callback, kbound), _cores(cores) {
+            }
+
+        protected:
+            bool search(
+                    std::vector<std::shared_ptr<PQL::Condition > >& queries,
+                    std::vector<ResultPrinter::Result>& results,
+                    Strategy strategy,
+                    bool usestubborn,
+                    bool statespacesearch,
+                    StatisticsLevel printstats,
+                    bool keep_trace,
+                    size_t seed,
+                    int64_t depthRandomWalk,
+                    const int64_t incRandomWalk,
+                    const std::vector<MarkVal>& initPotencies) override;
+
+        private:
+            template<typename Q>
+            struct worker_t {
+                worker_t(size_t seed, const std::vector<MarkVal>& initPotencies)
+                : _queue(seed) {
+                    if constexpr (std::is_base_of_v<Structures::PotencyQueue, Q>) {
+                        if (!initPotencies.empty())
+                            _queue = Q(initPotencies, seed);
+                    }
+                }
+                std::mutex _lock;
+                Q _queue;
+            };
+
+            template<typename Q, typename G>
+            bool tryReachParallel(
+                std::vector<std::shared_ptr<PQL::Condition > >& queries,
+                std::vector<ResultPrinter::Result>& results,
+                bool usequeries,
+                StatisticsLevel statisticsLevel,
+                size_t seed,
+                const std::vector<MarkVal>& initPotencies);
+
+            template<typename Q>
+            size_t steal(std::vector<std::unique_ptr<worker_t<Q>>>& workers, size_t self);
+
+            template<typename G>
+            G makeGenerator(std::vector<PQL::Condition_ptr>& queries);
+
+            bool checkQueriesShared(std::vector<std::shared_ptr<PQL::Condition > >&,
+                              std::vector<ResultPrinter::Result>&,
+                              Structures::State&, searchstate_t&,
+                              Structures::SharedStateSet&,
+                              Structures::StateSetInterface*);
+
+            // wakes one sleeping worker after a state is queued
+            void queued();
+            // wakes all sleeping workers, to stop or because nothing is left to expand
+            void wakeAll();
+
+            // shards of the passed-list per worker, so workers rarely contend for a shard
+            static constexpr size_t shards_per_worker = 64;
+
+            uint32_t _cores;
+            std::mutex _result_lock;
+            std::mutex _query_lock;
+            std::atomic<bool> _stop;
+            std::atomic<size_t> _pending;
+            std::atomic<size_t> _undecided;
+            std::atomic<size_t> _expanded;
+            std::atomic<size_t> _explored;
+            std::unique_ptr<std::atomic<bool>[]> _decided;
+            // the sleeping workers wait for _queued to change, or for the search to end
+            std::mutex _idle_lock;
+            std::condition_variable _idle;
+            std::atomic<size_t> _sleeping;
+            std::atomic<size_t> _queued;
+        };
+
+        inline void ParallelReachabilitySearch::queued() {
+            ++_queued;
+            if (_sleeping > 0) {
+                // a worker about to sleep holds the lock while it checks _queued
+                { std::lock_guard<std::mutex> guard(_idle_lock); }
+                _idle.notify_one();
+            }
+        }
+
+        inline void ParallelReachabilitySearch::wakeAll() {
+            { std::lock_guard<std::mutex> guard(_idle_lock); }
+            _idle.notify_all();
+        }
+
+        template<typename G>
+        G ParallelReachabilitySearch::makeGenerator(std::vector<PQL::Condition_ptr>& queries) {
+            // the stubborn sets annotate the shared query objects, which must be serialised
+            std::lock_guard<std::mutex> guard(_query_lock);
+            if constexpr (std::is_same_v<G, ReducingSuccessorGenerator>) {
+                auto stubset = std::make_shared<ReachabilityStubbornSet>(_net, queries);
+                stubset->setInterestingVisitor<InterestingTransitionVisitor>();
+                stubset->setQueryLock(&_query_lock);
+                return ReducingSuccessorGenerator{_net, stubset};
+            } else {
+                return G{_net, queries};
+            }
+        }
+
+        template<typename Q>
+        size_t ParallelReachabilitySearch::steal(std::vector<std::unique_ptr<worker_t<Q>>>& workers, size_t self) {
+            for (size_t n = 1; n < workers.size(); ++n) {
+                auto& victim = *workers[(self + n) % workers.size()];
+                std::unique_lock<std::mutex> guard(victim._lock, std::try_to_lock);
+                if (!guard.owns_lock())
+                    continue;
+                auto nid = victim._queue.pop();
+                if (nid != Structures::Queue::EMPTY)
+                    return nid;
+            }
+            return Structures::Queue::EMPTY;
+        }
+
+        template<typename Q, typename G>
+        bool ParallelReachabilitySearch::tryReachParallel(std::vector<std::shared_ptr<PQL::Condition> >& queries,
+                                        std::vector<ResultPrinter::Result>& results, bool usequeries,
+                                        StatisticsLevel statisticsLevel, size_t seed,
+                                        const std::vector<MarkVal>& initPotencies)
+        {
+            const size_t nworkers = _cores;
+            _stop = false;
+            _expanded = 0;
+            _explored = 1;
+            _undecided = 0;
+            _sleeping = 0;
+            _queued = 0;
+            _decided = std::make_unique<std::atomic<bool>[]>(queries.size());
+            for (size_t i = 0; i < queries.size(); ++i) {
+                _decided[i] = results[i] != ResultPrinter::Unknown;
+                if (!_decided[i]) ++_undecided;
+            }
+
+            Structures::SharedStateSet shared(nworkers * shards_per_worker);
+            std::vector<std::unique_ptr<Structures::SharedStateSet::View>> views;
+            std::vector<std::unique_ptr<worker_t<Q>>> workers;
+            std::vector<searchstate_t> sstates(nworkers);
+            for (size_t i = 0; i < nworkers; ++i) {
+                views.emplace_back(std::make_unique<Structures::SharedStateSet::View>(shared, _net, _kbound));
+                workers.emplace_back(std::make_unique<worker_t<Q>>(seed + i, initPotencies));
+                sstates[i].enabledTransitionsCount.resize(_net.numberOfTransitions(), 0);
+                sstates[i].heurquery = queries.size() >= 2 ? (seed + i) % queries.size() : 0;
+                sstates[i].usequeries = usequeries;
+            }
+
+            _initial.setMarking(_net.makeInitialMarking());
+            Structures::State working;
+            working.setMarking(_net.makeInitialMarking());
+
+            auto r = views[0]->add(working);
+            _pending = r.first ? 1 : 0;
+            if (r.first) {
+                if (usequeries && checkQueriesShared(queries, results, working, sstates[0], shared, views[0].get()))
+                    _pending = 0;
+                else {
+                    PQL::DistanceContext dc(&_net, working.marking());
+                    workers[0]->_queue.push(r.second, &dc, queries[sstates[0].heurquery].get());
+                }
+            }
+
+            std::exception_ptr error = nullptr;
+            std::mutex error_lock;
+            auto work = [&](size_t id) {
+                try {
+                    auto& self = *workers[id];
+                    auto& states = *views[id];
+                    auto& ss = sstates[id];
+                    Structures::State state;
+                    Structures::State working;
+                    state.setMarking(_net.makeInitialMarking());
+                    working.setMarking(_net.makeInitialMarking());
+                    G generator = makeGenerator<G>(queries);
+
+                    while (!_stop) {
+                        const size_t seen = _queued;
+                        size_t nid;
+                        {
+                            std::lock_guard<std::mutex> guard(self._lock);
+                            nid = self._queue.pop();
+                        }
+                        if (nid == Structures::Queue::EMPTY)
+                            nid = steal(workers, id);
+                        if (nid == Structures::Queue::EMPTY) {
+                            // nothing is queued and nobody is expanding; we are done
+                            if (_pending == 0)
+                                break;
+                            std::unique_lock<std::mutex> guard(_idle_lock);
+                            ++_sleeping;
+                            _idle.wait(guard, [&] { return _stop || _pending == 0 || _queued != seen; });
+                            --_sleeping;
+                            continue;
+                        }
+
+                        states.decode(state, nid);
+                        generator.prepare(&state);
+                        // the distances of the successors are computed relative to this marking;
+                        // thieves only pop, so the incremental state of the queue is ours alone
+                        if constexpr (std::is_same_v<Q, Structures::HeuristicQueue> || std::is_same_v<Q, Structures::RandomPotencyQueue>) {
+                            PQL::DistanceContext dc(&_net, state.marking());
+                            self._queue.expand(&dc, queries[ss.heurquery].get());
+                        }
+                        while (!_stop && generator.next(working)) {
+                            ss.enabledTransitionsCount[generator.fired()]++;
+                            auto res = states.add(working);
+                            if (res.first) {
+                                ++_pending;
+                                {
+                                    PQL::DistanceContext dc(&_net, working.marking());
+                                    std::lock_guard<std::mutex> guard(self._lock);
+                                    if constexpr (std::is_same_v<Q, Structures::HeuristicQueue> || std::is_same_v<Q, Structures::RandomPotencyQueue>)
+                                        self._queue.push(res.second, &dc, queries[ss.heurquery].get(), generator.fired());
+                                    else
+                                        self._queue.push(res.second, &dc, queries[ss.heurquery].get());
+                                }
+                                queued();
+                                ++_explored;
+                                if (checkQueriesShared(queries, results, working, ss, shared, &states))
+                                    break;
+                            }
+                        }
+                        ++_expanded;
+                        if (--_pending == 0)
+                            wakeAll();
+                        if (MemoryBudget::exceeded()) {
+                            _memory_exceeded = true;
+                            _stop = true;
+                        }
+                    }
+                } catch (...) {
+                    std::lock_guard<std::mutex> guard(error_lock);
+                    if (error == nullptr)
+                        error = std::current_exception();
+                    _stop = true;
+                }
+                // the others may sleep on a search that has stopped
+                wakeAll();
+            };
+
+            if (_pending > 0) {
+                std::vector<std::thread> threads;
+                for (size_t i = 0; i < nworkers; ++i)
+                    threads.emplace_back(work, i);
+                for (auto& t : threads)
+                    t.join();
+            }
+            if (error != nullptr)
+                std::rethrow_exception(error);
+
+            // collect the statistics of all workers
+            auto& states = *views[0];
+            searchstate_t ss = sstates[0];
+            for (size_t i = 1; i < nworkers; ++i) {
+                states.merge(*views[i]);
+                for (size_t t = 0; t < ss.enabledTransitionsCount.size(); ++t)
+                    ss.enabledTransitionsCount[t] += sstates[i].enabledTransitionsCount[t];
+            }
+            ss.expandedStates = _expanded;
+            ss.exploredStates = _explored;
+
+            if (!_stop && _undecided > 0) {
+                // no more successors, print last results
+                for (size_t i = 0; i < queries.size(); ++i) {
+                    if (results[i] == ResultPrinter::Unknown)
+                        results[i] = doCallback(queries[i], i, ResultPrinter::NotSatisfied, ss, &states).first;
+                }
+            }
+
+            if (statisticsLevel != StatisticsLevel::None)
+                printStats(ss, &states, statisticsLevel);
+            _max_tokens = states.maxTokens();
+            return (_stop && !_memory_exceeded) || _undecided == 0;
+        }
+    }
+}
+
+#endif // PARALLELREACHABILITYSEARCH_H
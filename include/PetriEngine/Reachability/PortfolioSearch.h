@@ -0,0 +1,94 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef PORTFOLIOSEARCH_H
+#define PORTFOLIOSEARCH_H
+
+#include "ReachabilityResult.h"
+#include "../PQL/PQL.h"
+#include "../PetriNet.h"
+#include "PetriEngine/options.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace PetriEngine {
+    namespace Reachability {
+
+        /**
+         * Portfolio of reachability engines. Each query is raced by a heuristic search,
+         * a random walk, trace abstraction refinement, the siphon-trap analysis (for
+         * deadlock queries) and the LP over-approximation with a larger budget, each in
+         * their own thread. The first conclusive answer is printed and the other engines
+         * are cancelled. Each engine works on its own deep copy of the query, as the
+         * engines annotate the nodes of the query while evaluating it.
+         * Exceeding the memory budget cancels the entire race and leaves the query
+         * unanswered.
+         */
+        class PortfolioSearch {
+        public:
+            PortfolioSearch(AbstractHandler& printer, PetriNet& net, Reducer* reducer, options_t& options)
+            : _printer(printer), _net(net), _reducer(reducer), _options(options) {
+            }
+
+            /** Races the undecided queries one at a time, queries must be prepared for reachability */
+            void solve(std::vector<std::shared_ptr<PQL::Condition > >& queries,
+                       std::vector<ResultPrinter::Result>& results);
+
+        private:
+            struct race_t {
+                std::atomic<bool> _abort{false};
+                std::mutex _result_lock;
+                ResultPrinter::Result _result = ResultPrinter::Unknown;
+                const char* _winner = nullptr;
+            };
+
+            // forwards the first conclusive answer of the race to the real printer
+            class Handler : public AbstractHandler {
+            public:
+                Handler(race_t& race, AbstractHandler& target, size_t index, const char* name)
+                : _race(race), _target(target), _index(index), _name(name) {}
+
+                std::pair<Result, bool> handle(
+                    size_t index,
+                    PQL::Condition* query,
+                    Result result,
+                    const std::vector<uint32_t>* maxPlaceBound = nullptr,
+                    size_t expandedStates = 0,
+                    size_t exploredStates = 0,
+                    size_t discoveredStates = 0,
+                    int maxTokens = 0,
+                    Structures::StateSetInterface* stateset = nullptr, size_t lastmarking = 0, const MarkVal* initialMarking = nullptr, bool trace = true) override;
+            private:
+                race_t& _race;
+                AbstractHandler& _target;
+                size_t _index;
+                const char* _name;
+            };
+
+            ResultPrinter::Result race(size_t index, const std::shared_ptr<PQL::Condition>& query);
+
+            AbstractHandler& _printer;
+            PetriNet& _net;
+            Reducer* _reducer;
+            options_t& _options;
+        };
+    }
+}
+
+#endif // PORTFOLIOSEARCH_H
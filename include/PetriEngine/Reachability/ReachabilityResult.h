@@ -26,6 +26,7 @@
 #include "../Reducer.h"
 
 struct options_t;
+enum class MemoryPolicy;
 
 namespace PetriEngine {
     class PetriNetBuilder;
@@ -61,6 +62,9 @@ namespace PetriEngine {
                 size_t discoveredStates = 0,
                 int maxTokens = 0,
                 Structures::StateSetInterface* stateset = nullptr, size_t lastmarking = 0, const MarkVal* initialMarking = nullptr, bool trace = true) = 0;
+
+            /** The memory budget was exceeded, and the search continues as given by policy */
+            virtual void memoryExceeded(MemoryPolicy policy) {}
         };
 
         class ResultPrinter : public AbstractHandler {
@@ -93,6 +97,8 @@ namespace PetriEngine {
                 size_t discoveredStates = 0,
                 int maxTokens = 0,
                 Structures::StateSetInterface* stateset = nullptr, size_t lastmarking = 0, const MarkVal* initialMarking = nullptr, bool trace = true) override;
+
+            void memoryExceeded(MemoryPolicy policy) override;
         };
 
         // The only purpose of this class is to pretty-print the "Solved by Trace
@@ -23,8 +23,12 @@
 #include "../Structures/State.h"
 #include "ReachabilityResult.h"
 #include "../PQL/PQL.h"
+#include "../PQL/CompiledCondition.h"
 #include "../PetriNet.h"
 #include "../Structures/StateSet.h"
+#include "../Structures/ApproximateStateSet.h"
+#include "../Structures/ExternalStateSet.h"
+#include "../Structures/MarkingStore.h"
 #include "../Structures/Queue.h"
 #include "../Structures/PotencyQueue.h"
 #include "../SuccessorGenerator.h"
@@ -32,7 +36,9 @@
 #include "PetriEngine/Stubborn/ReachabilityStubbornSet.h"
 
 #include "PetriEngine/options.h"
+#include "utils/MemoryBudget.h"
 
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -53,7 +59,11 @@ namespace PetriEngine {
             {
             }
 
-            /** Perform reachability check using BFS with hasing */
+            /**
+             * Perform reachability check using BFS with hasing.
+             * If the MemoryBudget is exceeded, the search is restarted or stopped as
+             * given by setMemoryPolicy.
+             */
             bool reachable(
                     std::vector<std::shared_ptr<PQL::Condition > >& queries,
                     std::vector<ResultPrinter::Result>& results,
@@ -67,13 +77,53 @@ namespace PetriEngine {
                     const int64_t incRandomWalk = 5000,
                     const std::vector<MarkVal>& initPotencies = std::vector<MarkVal>());
             size_t maxTokens() const;
+
+            // lets another thread cancel the search; a cancelled search reports nothing further
+            void setAbort(const std::atomic<bool>* abort) { _abort = abort; }
+            // store the passed states approximately in a table of bitstateBytes, see Structures::ApproximateStateSet
+            void setStateCompaction(StateCompaction compaction, size_t bitstateBytes = 0, uint32_t bitstateHashes = 0) {
+                _compaction = compaction;
+                _bitstate_bytes = bitstateBytes;
+                _bitstate_hashes = bitstateHashes;
+            }
+            // keep the passed states on disk in directory, see Structures::ExternalStateSet
+            void setExternalMemory(const std::string& directory, size_t memoryBytes) {
+                _external_directory = directory;
+                _external_memory = memoryBytes;
+            }
+            // keep the passed states in a store shared with other searches of the net, see Structures::MarkingStore
+            void setMarkingStore(std::shared_ptr<Structures::MarkingStore> store) {
+                _marking_store = std::move(store);
+            }
+            // what to do the first time the memory budget is exceeded; spilling uses spillDirectory
+            void setMemoryPolicy(MemoryPolicy policy, const std::string& spillDirectory = ".") {
+                _memory_policy = policy;
+                _spill_directory = spillDirectory;
+            }
+            // true if the last search was stopped by the memory budget
+            bool memoryExceeded() const { return _memory_stopped; }
         protected:
+            virtual bool search(
+                    std::vector<std::shared_ptr<PQL::Condition > >& queries,
+                    std::vector<ResultPrinter::Result>& results,
+                    Strategy strategy,
+                    bool usestubborn,
+                    bool statespacesearch,
+                    StatisticsLevel printstats,
+                    bool keep_trace,
+                    size_t seed,
+                    int64_t depthRandomWalk,
+                    const int64_t incRandomWalk,
+                    const std::vector<MarkVal>& initPotencies);
+
             struct searchstate_t {
                 size_t expandedStates = 0;
                 size_t exploredStates = 1;
                 std::vector<size_t> enabledTransitionsCount;
                 size_t heurquery = 0;
                 bool usequeries;
+                // the queries lowered for checkQueries, compiled on first use
+                std::vector<PQL::CompiledCondition> compiled;
             };
 
             template<typename W = Structures::RandomWalkStateSet, typename G>
@@ -96,13 +146,63 @@ namespace PetriEngine {
                 size_t seed,
                 const std::vector<MarkVal>& initPotencies);
 
+            // the passed-list of a search, as configured
+            template<typename W>
+            std::unique_ptr<W> makeStates();
+
+            // the search loop of tryReach, which may continue in another passed-list, see carry
+            template<typename Q, typename W, typename G>
+            bool explore(
+                std::vector<std::shared_ptr<PQL::Condition > >& queries,
+                std::vector<ResultPrinter::Result>& results,
+                searchstate_t& ss,
+                std::unique_ptr<W> states,
+                Q& queue,
+                G& generator,
+                StatisticsLevel statisticsLevel);
+
+            // moves the passed and waiting markings of states into a new passed-list of type W,
+            // pushing the waiting ones to the queue again; the passed ones are not expanded again
+            template<typename W, typename Q>
+            std::unique_ptr<W> carry(
+                std::unique_ptr<Structures::StateSet> states,
+                Q& queue,
+                searchstate_t& ss,
+                std::vector<std::shared_ptr<PQL::Condition > >& queries);
+
+            // the policy applying once the memory budget is exceeded; traces need the exact
+            // passed-list, and the approximate ones cannot explore the state-space
+            MemoryPolicy memoryPolicy(bool keep_trace, bool statespacesearch) const;
+
             void printStats(searchstate_t& s, Structures::StateSetInterface*, StatisticsLevel);
 
+            bool aborted() const {
+                return _abort != nullptr && _abort->load(std::memory_order_relaxed);
+            }
+
             virtual bool checkQueries(std::vector<std::shared_ptr<PQL::Condition > >&,
                               std::vector<ResultPrinter::Result>&,
                               Structures::State&, searchstate_t&,
                               Structures::StateSetInterface*);
 
+            // true if query i holds in state, evaluated by the programs compiled into ss on first use
+            bool satisfies(std::vector<std::shared_ptr<PQL::Condition > >& queries, size_t i,
+                           Structures::State& state, searchstate_t& ss);
+
+            // once the query guiding the heuristic is decided, guide it by the next undecided one
+            template<typename F>
+            static void nextHeuristicQuery(searchstate_t& ss, size_t nqueries, F&& decided) {
+                if (nqueries < 2 || !decided(ss.heurquery))
+                    return;
+                for (size_t n = 1; n < nqueries; ++n) {
+                    auto next = (ss.heurquery + n) % nqueries;
+                    if (!decided(next)) {
+                        ss.heurquery = next;
+                        return;
+                    }
+                }
+            }
+
             virtual std::pair<ResultPrinter::Result,bool> doCallback(
                 std::shared_ptr<PQL::Condition>& query, size_t i,
                 ResultPrinter::Result r, searchstate_t &ss,
@@ -114,6 +214,18 @@ namespace PetriEngine {
             Structures::State _initial;
             AbstractHandler& _callback;
             size_t _max_tokens = 0;
+            const std::atomic<bool>* _abort = nullptr;
+            StateCompaction _compaction = StateCompaction::None;
+            size_t _bitstate_bytes = 0;
+            uint32_t _bitstate_hashes = 0;
+            std::string _external_directory;
+            size_t _external_memory = 0;
+            std::shared_ptr<Structures::MarkingStore> _marking_store;
+            MemoryPolicy _memory_policy = MemoryPolicy::Stop;
+            std::string _spill_directory;
+            // set by a search stopping early because of the memory budget
+            std::atomic<bool> _memory_exceeded{false};
+            bool _memory_stopped = false;
         };
 
         template <typename G>
@@ -127,6 +239,21 @@ namespace PetriEngine {
             return ReducingSuccessorGenerator{net, stubset};
         }
 
+        template<typename W>
+        std::unique_ptr<W> ReachabilitySearch::makeStates()
+        {
+            if constexpr (std::is_same_v<W, Structures::ExternalStateSet>) {
+                return std::make_unique<W>(_net, _kbound, _external_directory, _external_memory);
+            } else {
+                auto states = std::make_unique<W>(_net, _kbound);
+                if constexpr (std::is_same_v<W, Structures::ApproximateStateSet>)
+                    states->setTable(_bitstate_bytes, _compaction == StateCompaction::Bitstate ? _bitstate_hashes : 0);
+                if constexpr (std::is_same_v<W, Structures::MarkingStoreStateSet>)
+                    states->setStore(_marking_store);
+                return states;
+            }
+        }
+
         template<typename Q, typename W, typename G>
         bool ReachabilitySearch::tryReach(std::vector<std::shared_ptr<PQL::Condition> >& queries,
                                         std::vector<ResultPrinter::Result>& results, bool usequeries,
@@ -149,7 +276,7 @@ namespace PetriEngine {
             state.setMarking(_net.makeInitialMarking());
             working.setMarking(_net.makeInitialMarking());
 
-            W states(_net, _kbound); // stateset
+            auto states = makeStates<W>(); // stateset
 
             Q queue(seed); // Working queue
             if constexpr (std::is_base_of_v<Structures::PotencyQueue, Q>) {
@@ -158,7 +285,10 @@ namespace PetriEngine {
             }
 
             G generator = _makeSucGen<G>(_net, queries); // successor generator
-            auto r = states.add(state);
+            // a depth-first search mostly expands a successor of the previous state
+            if constexpr (std::is_same_v<Q, Structures::DFSQueue> || std::is_same_v<Q, Structures::RDFSQueue>)
+                generator.setIncremental(true);
+            auto r = states->add(state);
             // this can fail due to reductions; we push tokens around and violate K
             if(r.first){
                 // add initial to states, check queries on initial state
@@ -166,67 +296,192 @@ namespace PetriEngine {
                 // check initial marking
                 if(ss.usequeries)
                 {
-                    if(checkQueries(queries, results, working, ss, &states))
+                    if(checkQueries(queries, results, working, ss, states.get()))
                     {
                         if(statisticsLevel != StatisticsLevel::None)
-                            printStats(ss, &states, statisticsLevel);
-                        _max_tokens = states.maxTokens();
+                            printStats(ss, states.get(), statisticsLevel);
+                        _max_tokens = states->maxTokens();
                         return true;
                     }
                 }
                 // add initial to queue
-                {
+                if constexpr (!std::is_same_v<W, Structures::ExternalStateSet>) {
                     PQL::DistanceContext dc(&_net, working.marking());
                     queue.push(r.second, &dc, queries[ss.heurquery].get());
                 }
+            }
+            return explore(queries, results, ss, std::move(states), queue, generator, statisticsLevel);
+        }
 
-                // Search!
-                for(auto nid = queue.pop(); nid != Structures::Queue::EMPTY; nid = queue.pop()) {
-                    states.decode(state, nid);
-                    generator.prepare(&state);
+        template<typename Q, typename W, typename G>
+        bool ReachabilitySearch::explore(std::vector<std::shared_ptr<PQL::Condition> >& queries,
+                                         std::vector<ResultPrinter::Result>& results, searchstate_t& ss,
+                                         std::unique_ptr<W> states, Q& queue, G& generator,
+                                         StatisticsLevel statisticsLevel)
+        {
+            // the external passed-list is also the waiting-list, and explores a breadth-first layer at a time
+            constexpr bool external = std::is_same_v<W, Structures::ExternalStateSet>;
+            Structures::State state;
+            Structures::State working;
+            state.setMarking(_net.makeInitialMarking());
+            working.setMarking(_net.makeInitialMarking());
 
-                    while(generator.next(working)){
-                        ss.enabledTransitionsCount[generator.fired()]++;
-                        auto res = states.add(working);
-                        // If we have not seen this state before
-                        if (res.first) {
-                            {
-                                PQL::DistanceContext dc(&_net, working.marking());
-                                if constexpr (std::is_same_v<Q, Structures::RandomPotencyQueue>)
-                                    queue.push(res.second, &dc, queries[ss.heurquery].get(), generator.fired());
-                                else
-                                    queue.push(res.second, &dc, queries[ss.heurquery].get());
-                            }
-                            states.setHistory(res.second, generator.fired());
-                            _satisfyingMarking = res.second;
-                            ss.exploredStates++;
-                            if (checkQueries(queries, results, working, ss, &states)) {
-                                if(statisticsLevel != StatisticsLevel::None)
-                                    printStats(ss, &states, statisticsLevel);
-                                _max_tokens = states.maxTokens();
-                                return true;
+            // the next marking to expand, from the current layer of an external passed-list
+            auto next = [&]() {
+                if constexpr (external) {
+                    while (!states->next(state)) {
+                        if (!states->nextLayer())
+                            return false;
+                    }
+                    return true;
+                } else {
+                    auto nid = queue.pop();
+                    if (nid == Structures::Queue::EMPTY)
+                        return false;
+                    states->decode(state, nid);
+                    states->release(nid);
+                    return true;
+                }
+            };
+
+            // Search!
+            while(!aborted() && next()) {
+                generator.prepare(&state);
+                // the distances of the successors are computed relative to this marking
+                if constexpr (!external && (std::is_same_v<Q, Structures::HeuristicQueue> || std::is_same_v<Q, Structures::RandomPotencyQueue>)) {
+                    PQL::DistanceContext dc(&_net, state.marking());
+                    queue.expand(&dc, queries[ss.heurquery].get());
+                }
+
+                while(generator.next(working)){
+                    ss.enabledTransitionsCount[generator.fired()]++;
+                    auto res = states->add(working);
+                    // If we have not seen this state before; an external passed-list only knows
+                    // that once the layer is merged, but the queries are cheaper than the disk
+                    if (res.first) {
+                        if constexpr (!external) {
+                            PQL::DistanceContext dc(&_net, working.marking());
+                            if constexpr (std::is_same_v<Q, Structures::HeuristicQueue> || std::is_same_v<Q, Structures::RandomPotencyQueue>)
+                                queue.push(res.second, &dc, queries[ss.heurquery].get(), generator.fired());
+                            else
+                                queue.push(res.second, &dc, queries[ss.heurquery].get());
+                        }
+                        states->setHistory(res.second, generator.fired());
+                        _satisfyingMarking = res.second;
+                        ss.exploredStates++;
+                        if (checkQueries(queries, results, working, ss, states.get())) {
+                            if(statisticsLevel != StatisticsLevel::None)
+                                printStats(ss, states.get(), statisticsLevel);
+                            _max_tokens = states->maxTokens();
+                            return true;
+                        }
+                    }
+                }
+                ss.expandedStates++;
+                if (MemoryBudget::exceeded()) {
+                    _memory_exceeded = true;
+                    // continue in a passed-list needing less memory, with the markings found so far
+                    if constexpr (std::is_same_v<W, Structures::StateSet>) {
+                        auto policy = memoryPolicy(false, !ss.usequeries);
+                        if (policy != MemoryPolicy::Stop) {
+                            _callback.memoryExceeded(policy);
+                            _memory_exceeded = false;
+                            // if the budget is exceeded again we stop
+                            _memory_policy = MemoryPolicy::Stop;
+                            if (policy == MemoryPolicy::Compact) {
+                                _compaction = StateCompaction::Hash;
+                                _bitstate_bytes = std::max<size_t>(MemoryBudget::limit() / 4, 1);
+                                return explore(queries, results, ss,
+                                               carry<Structures::ApproximateStateSet>(std::move(states), queue, ss, queries),
+                                               queue, generator, statisticsLevel);
                             }
+                            setExternalMemory(_spill_directory, std::max<size_t>(MemoryBudget::limit() / 4, 1));
+                            return explore(queries, results, ss,
+                                           carry<Structures::ExternalStateSet>(std::move(states), queue, ss, queries),
+                                           queue, generator, statisticsLevel);
                         }
                     }
-                    ss.expandedStates++;
+                    break;
                 }
+                if constexpr (std::is_same_v<W, Structures::ApproximateStateSet>) {
+                    if (states->full() && MemoryBudget::limit() != 0) {
+                        _memory_exceeded = true;
+                        break;
+                    }
+                }
+            }
+            // with a memory budget, a full table of an approximate search exceeds it
+            if constexpr (std::is_same_v<W, Structures::ApproximateStateSet>) {
+                if (states->full() && MemoryBudget::limit() != 0)
+                    _memory_exceeded = true;
             }
 
             // no more successors, print last results
-            for(size_t i= 0; i < queries.size(); ++i)
-            {
-                if(results[i] == ResultPrinter::Unknown)
+            // an approximate search may have omitted states, so it cannot refute the queries
+            if constexpr (!std::is_same_v<W, Structures::ApproximateStateSet>) {
+                for(size_t i= 0; i < queries.size() && !aborted() && !_memory_exceeded; ++i)
                 {
-                    results[i] = doCallback(queries[i], i, ResultPrinter::NotSatisfied, ss, &states).first;
+                    if(results[i] == ResultPrinter::Unknown)
+                    {
+                        results[i] = doCallback(queries[i], i, ResultPrinter::NotSatisfied, ss, states.get()).first;
+                    }
                 }
             }
 
             if(statisticsLevel != StatisticsLevel::None)
-                printStats(ss, &states, statisticsLevel);
-            _max_tokens = states.maxTokens();
+                printStats(ss, states.get(), statisticsLevel);
+            _max_tokens = states->maxTokens();
             return false;
         }
 
+        template<typename W, typename Q>
+        std::unique_ptr<W> ReachabilitySearch::carry(std::unique_ptr<Structures::StateSet> states, Q& queue,
+                                                     searchstate_t& ss,
+                                                     std::vector<std::shared_ptr<PQL::Condition> >& queries)
+        {
+            std::vector<size_t> waiting;
+            std::vector<bool> iswaiting(states->size(), false);
+            for (auto nid = queue.pop(); nid != Structures::Queue::EMPTY; nid = queue.pop()) {
+                waiting.push_back(nid);
+                iswaiting[nid] = true;
+            }
+            // pushed back in this order, the stacks pop the markings in their old order
+            if constexpr (std::is_same_v<Q, Structures::DFSQueue> || std::is_same_v<Q, Structures::RDFSQueue>)
+                std::reverse(waiting.begin(), waiting.end());
+
+            auto carried = makeStates<W>();
+            Structures::State state;
+            state.setMarking(_net.makeInitialMarking());
+            // the passed markings are not expanded again
+            for (size_t id = 0; id < states->size(); ++id) {
+                if (iswaiting[id])
+                    continue;
+                states->decode(state, id);
+                auto r = carried->add(state);
+                if constexpr (std::is_same_v<W, Structures::ExternalStateSet>) {
+                    (void)r;
+                } else if (r.first) {
+                    carried->release(r.second);
+                }
+            }
+            if constexpr (std::is_same_v<W, Structures::ExternalStateSet>)
+                carried->passCollected();
+            // the waiting markings are, as the next layer of an external passed-list
+            for (auto id : waiting) {
+                states->decode(state, id);
+                auto r = carried->add(state);
+                if constexpr (!std::is_same_v<W, Structures::ExternalStateSet>) {
+                    if (r.first) {
+                        PQL::DistanceContext dc(&_net, state.marking());
+                        queue.push(r.second, &dc, queries[ss.heurquery].get());
+                    }
+                }
+            }
+            states.reset();
+            MemoryBudget::reset();
+            return carried;
+        }
+
         template<typename W, typename G>
         bool ReachabilitySearch::tryReachRandomWalk(std::vector<std::shared_ptr<PQL::Condition> >& queries,
                                                     std::vector<ResultPrinter::Result>& results, bool usequeries,
@@ -252,6 +507,8 @@ namespace PetriEngine {
 
             W states(_net, _kbound, query, initPotencies, seed); // RandomWalk State Set
             G generator = _makeSucGen<G>(_net, queries); // Successor generator
+            // each step is a successor of the previous one
+            generator.setIncremental(true);
 
             // Check initial marking
             if(ss.usequeries)
@@ -271,12 +528,12 @@ namespace PetriEngine {
             }
 
             const int64_t maxDepthValue = std::numeric_limits<int64_t>::max() - incRandomWalk;
-            while(true) {
+            while(!aborted()) {
                 // Start a new random walk
                 states.newWalk();
 
                 // Search! Each turn is a random step
-                for(int stepCounter = 0; stepCounter < depthRandomWalk; ++stepCounter) {
+                for(int stepCounter = 0; stepCounter < depthRandomWalk && !aborted(); ++stepCounter) {
                     // The currentStepMarking is the nextMarking computed in the previous step
                     if (!states.nextStep(currentStepState.marking())) {
                         // No candidate found at the previous step, do a new walk
@@ -328,7 +585,7 @@ namespace PetriEngine {
             }
 
             // no more successors, print last results
-            for(size_t i= 0; i < queries.size(); ++i)
+            for(size_t i= 0; i < queries.size() && !aborted(); ++i)
             {
                 if(results[i] == ResultPrinter::Unknown)
                 {
@@ -26,6 +26,7 @@ namespace PetriEngine {
     using ArcIter = std::vector<Arc>::iterator;
 
     class PetriNetBuilder;
+    class BinaryNet;
 
     class QueryPlaceAnalysisContext : public PQL::AnalysisContext {
         std::vector<uint32_t> _placeInQuery;
@@ -89,6 +90,7 @@ namespace PetriEngine {
    };
 
     class Reducer {
+        friend class BinaryNet;
     public:
         Reducer(PetriNetBuilder*);
         ~Reducer();
@@ -134,12 +136,21 @@ namespace PetriEngine {
                 << "Applications of rule S: " << _ruleS << std::endl;
         }
 
+        // Makes the local rules scan the whole net every time instead of only the changed nodes,
+        // the reduced net is the same either way
+        void setFullRescan(bool fullRescan) {
+            _fullRescan = fullRescan;
+        }
+
         void postFire(std::ostream&, const std::string& transition) const;
         void tokenConsumption(std::ostream&, const std::string& transition) const;
         void initFire(std::ostream&) const;
 
         void saveInitialNet();
 
+        /** Takes over the trace data of other, the reducer of the net this net was copied from */
+        void copyTraces(const Reducer& other);
+
     private:
         size_t _skippedPlaces= 0;
         std::vector<uint32_t> _skippedTransitions;
@@ -187,6 +198,31 @@ namespace PetriEngine {
         void skipInArc(uint32_t, uint32_t);
         void skipOutArc(uint32_t, uint32_t);
 
+        // Dirty tracking: every change to the net stamps the places and transitions
+        // it alters with the current generation. The rules which only look at the
+        // neighbourhood of a single place or transition (A, B, E/P, F, F/N/O and G)
+        // remember the generation of their last complete scan and only revisit the
+        // nodes which themselves or whose neighbours were stamped since; the rules
+        // comparing two places (C) or two transitions (D) only revisit pairs where
+        // one of the two was stamped since.
+        void touchPlace(uint32_t place);
+        void touchTransition(uint32_t transition);
+        void touchArc(uint32_t place, uint32_t transition) {
+            touchPlace(place);
+            touchTransition(transition);
+        }
+        // also stamps the transitions around the place, rule B reads the flag two steps away
+        void touchInhibitor(uint32_t place);
+        bool placeTouched(uint32_t place, uint32_t since) const {
+            return place >= _pchanged.size() || _pchanged[place] > since;
+        }
+        bool transitionTouched(uint32_t transition, uint32_t since) const {
+            return transition >= _tchanged.size() || _tchanged[transition] > since;
+        }
+        bool placeChanged(uint32_t place, uint32_t since) const;
+        bool transitionChanged(uint32_t transition, uint32_t since) const;
+        void resetTracking();
+
         shared_const_string newTransName();
 
         bool consistent();
@@ -209,6 +245,11 @@ namespace PetriEngine {
         std::vector<uint8_t> _pflags;
         std::vector<uint32_t> _lower;
         size_t _tnameid = 0;
+        uint32_t _generation = 1;
+        std::vector<uint32_t> _pchanged;
+        std::vector<uint32_t> _tchanged;
+        bool _fullRescan = false;
+        uint32_t _scanA = 0, _scanB = 0, _scanC = 0, _scanD = 0, _scanEP = 0, _scanF = 0, _scanFNO = 0, _scanG = 0;
     };
 }
 
@@ -14,9 +14,14 @@
 #include "MurmurHash2.h"
 #include "Member.h"
 #include "Vector.h"
+#include "../PetriNet.h"
 
+typedef struct glp_prob glp_prob;
 
 namespace PetriEngine {
+    namespace PQL {
+        class SimplificationContext;
+    }
     namespace Simplification {
         class LinearProgram;
 
@@ -41,10 +46,29 @@ namespace PetriEngine {
              //   assert(vector.refs() == 0);
             }
 
+            /**
+             * The state equation of the net and initial marking of context, built on the first call and
+             * kept for the following programs of the same net. A program adds its rows on top and gives
+             * them back with releaseRows, the basis of its solution is kept as the starting point of the
+             * next program. Returns nullptr if the construction timed out.
+             */
+            glp_prob* stateEquation(const PQL::SimplificationContext& context);
+            void releaseRows(glp_prob* lp, int first);
+
+            // an impossible program stays impossible with more or tighter equations
+            bool knownImpossible(const LinearProgram& program) const;
+            void addImpossible(const LinearProgram& program);
+
 
         private:
             // unordered_map does not invalidate on insert, only erase
             std::unordered_set<Vector> vectors;
+
+            glp_prob* _lp = nullptr;
+            const PetriNet* _net = nullptr;
+            const MarkVal* _marking = nullptr;
+            int _baseRows = 0;
+            std::vector<LinearProgram> _impossible;
         };
 
     }
@@ -0,0 +1,119 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef APPROXIMATESTATESET_H
+#define APPROXIMATESTATESET_H
+
+#include "StateSet.h"
+#include "utils/MemoryBudget.h"
+
+#include <cmath>
+#include <vector>
+
+namespace PetriEngine {
+    namespace Structures {
+
+        /**
+         * Probabilistic passed-list. Instead of the markings, either a 64-bit
+         * fingerprint of each marking is stored (hash compaction), or a number of
+         * bits in a large bit-table is set for each marking (bitstate hashing).
+         * Two distinct markings may thus be mistaken for each other, in which case
+         * the second is omitted from the search; the expected number of omissions
+         * is tracked while the search runs.
+         *
+         * The table is sized once by setTable and never grows; once the table of
+         * fingerprints is full, new markings are dropped and counted as omitted.
+         *
+         * Markings can only be decoded until they are released, so the ids of
+         * states that are already passed cannot be decoded, and the id of a
+         * marking that was seen before is not known. The encodings of the waiting
+         * markings are kept in one buffer in the order they were added; released
+         * markings at either end are removed, as a depth- or breadth-first search
+         * releases them.
+         */
+        class ApproximateStateSet : public EncodingStateSetInterface {
+        public:
+            ApproximateStateSet(const PetriNet& net, uint32_t kbound, int nplaces = -1);
+
+            /**
+             * Size the table to (at most) the given number of bytes, rounded down to a
+             * power of two. Uses bitstate hashing setting hashes bits per marking, or
+             * hash compaction if hashes is 0. Must be called before the first add.
+             */
+            void setTable(size_t bytes, uint32_t hashes);
+
+            std::pair<bool, size_t> add(const State& state) override;
+
+            void decode(State& state, size_t id) override;
+
+            std::pair<bool, size_t> lookup(State& state) override;
+
+            void release(size_t id) override;
+
+            void setHistory(size_t id, size_t transition) override {}
+
+            std::pair<size_t, size_t> getHistory(size_t markingid) override
+            {
+                assert(false);
+                return std::make_pair(0,0);
+            }
+
+            size_t size() const override {
+                return _stored;
+            }
+
+            bool bitstate() const { return _hashes > 0; }
+
+            /** Fraction of the fingerprint slots or bits in use */
+            double fill() const;
+
+            /** Whether the fingerprint table is full, so markings were dropped */
+            bool full() const { return _dropped > 0; }
+
+            /** Estimated number of markings wrongly considered as seen, including the dropped ones */
+            double expectedOmissions() const { return _omissions + _dropped; }
+
+            /** Estimated probability that at least one marking was wrongly considered as seen */
+            double omissionProbability() const { return -std::expm1(-expectedOmissions()); }
+
+        private:
+            // probability that a new marking is mistaken for a stored one
+            double collisionProbability() const;
+            bool contains(uint64_t h1, uint64_t h2) const;
+            bool insert(uint64_t h1, uint64_t h2);
+
+            // 0 for hash compaction
+            uint32_t _hashes = 0;
+            // the fingerprints (0 is empty) or the bit-table
+            std::vector<uint64_t, tracked_allocator<uint64_t>> _table;
+            size_t _mask = 0;
+            size_t _set_bits = 0;
+            size_t _stored = 0;
+            size_t _dropped = 0;
+            double _omissions = 0;
+            // encodings of the markings with ids from _first, which may still be decoded
+            // from _head on; _offsets are relative to where _encodings once started
+            std::vector<unsigned char, tracked_allocator<unsigned char>> _encodings;
+            std::vector<size_t> _offsets;
+            std::vector<bool> _released;
+            size_t _first = 0;
+            size_t _head = 0;
+            size_t _base = 0;
+        };
+    }
+}
+
+#endif // APPROXIMATESTATESET_H
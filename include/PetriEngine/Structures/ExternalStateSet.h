@@ -0,0 +1,112 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef EXTERNALSTATESET_H
+#define EXTERNALSTATESET_H
+
+#include "StateSet.h"
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace PetriEngine {
+    namespace Structures {
+
+        /**
+         * Disk-backed passed- and waiting-list for a breadth-first search, using
+         * delayed duplicate detection. The markings of the current layer are read
+         * from disk, while their successors are collected (encoded) in memory.
+         * Whenever the memory budget is exceeded the collected markings are sorted
+         * and written to disk as a run. At the end of a layer, the runs are merged
+         * with the (sorted) passed-list on disk, the markings not seen before
+         * forming the next layer. Many runs are first merged in passes of at most
+         * 64 files, so the number of open files stays bounded.
+         * All files are kept in a scratch directory and removed again.
+         */
+        class ExternalStateSet : public StateSetInterface {
+        public:
+            ExternalStateSet(const PetriNet& net, uint32_t kbound, const std::string& directory, size_t memory);
+            ~ExternalStateSet();
+
+            /**
+             * Collects a successor for the next layer, false if it exceeds the k-bound.
+             * Markings cannot be decoded by id, so no id is returned.
+             */
+            std::pair<bool, size_t> add(const State& state);
+
+            void setHistory(size_t id, size_t transition) {}
+
+            /** Moves to the next layer, false if there are no new markings */
+            bool nextLayer();
+
+            /**
+             * Merges the collected markings into the passed-list without making them
+             * a layer, for markings another passed-list has expanded already.
+             */
+            void passCollected();
+
+            /** Reads the next marking of the current layer, false at the end of the layer */
+            bool next(State& state);
+
+            std::pair<size_t, size_t> getHistory(size_t markingid) override
+            {
+                assert(false);
+                return std::make_pair(0,0);
+            }
+
+            /** The number of distinct markings merged into the passed-list */
+            size_t size() const override {
+                return _passed;
+            }
+
+            size_t layers() const { return _layers; }
+
+            /** The largest amount of disk space used at once, in bytes */
+            size_t diskUsage() const { return _max_disk; }
+
+        private:
+            std::string file(const char* kind, size_t n = 0) const;
+            void flush();
+            void combine();
+            void merge();
+
+            // the most files read at once by a merge
+            static constexpr size_t max_merge_width = 64;
+
+            AlignedEncoder _encoder;
+            std::string _prefix;
+            size_t _memory;
+
+            // encoded, length-prefixed markings of the next layer
+            std::vector<unsigned char> _buffer;
+            std::vector<size_t> _records;
+            // the size in bytes of each sorted run on disk
+            std::vector<size_t> _runs;
+
+            std::unique_ptr<std::ifstream> _layer;
+            std::vector<unsigned char> _record;
+
+            size_t _passed = 0;
+            size_t _layers = 0;
+            size_t _disk = 0;
+            size_t _max_disk = 0;
+        };
+    }
+}
+
+#endif // EXTERNALSTATESET_H
@@ -0,0 +1,123 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MARKINGSTORE_H
+#define MARKINGSTORE_H
+
+#include "StateSet.h"
+#include "Sharded.h"
+
+#include <atomic>
+#include <memory>
+#include <unordered_set>
+
+namespace PetriEngine {
+    namespace Structures {
+
+        /**
+         * An append-only store of markings encoded with the AlignedEncoder, which is
+         * shared by all searches of one net, e.g. the dependency graphs and nested
+         * reachability searches of the CTL queries of a run, so a marking is only
+         * encoded into a ptrie once.
+         * Markings are distributed over ptrie shards by a hash of their encoding, see
+         * sharded_t; a store with one shard is not locked. Ids are local ids interleaved
+         * with the shard index and stay valid for the lifetime of the store, so it never
+         * shrinks; CTLMain starts a new store for the next query once one holds too many
+         * markings.
+         * The interface matches the tries of EncodingStateSetInterface, the store is
+         * also the passed-list of a SharedStateSet.
+         */
+        class MarkingStore {
+        public:
+            explicit MarkingStore(size_t shards = 1);
+
+            /** Inserts an encoded marking, returns whether it is new and its id */
+            std::pair<bool, size_t> insert(const uchar* data, size_t size);
+            std::pair<bool, size_t> exists(const uchar* data, size_t size);
+            void unpack(size_t id, uchar* destination);
+
+            size_t size() const { return _size; }
+            size_t shards() const { return _tries.size(); }
+
+        private:
+            using ptrie_t = ptrie::set_stable<ptrie::uchar,size_t,17,128,4>;
+
+            size_t shard_of(const uchar* data, size_t size) const;
+
+            sharded_t<ptrie_t> _tries;
+            std::atomic<size_t> _size{0};
+        };
+
+        /**
+         * A passed-list backed by a MarkingStore; the search only keeps the ids of
+         * the markings of the store it has passed, markings found by earlier searches
+         * are not encoded into a trie again.
+         */
+        class MarkingStoreStateSet : public EncodingStateSetInterface {
+        private:
+            // the markings of the store passed by this search
+            class passed_t {
+            public:
+                std::pair<bool, size_t> insert(const uchar* data, size_t size);
+                std::pair<bool, size_t> exists(const uchar* data, size_t size);
+                void unpack(size_t id, uchar* destination) { _store->unpack(id, destination); }
+
+                std::shared_ptr<MarkingStore> _store;
+                std::unordered_set<size_t> _passed;
+            };
+
+        public:
+            using EncodingStateSetInterface::EncodingStateSetInterface;
+
+            /** Must be set before the first marking is added */
+            void setStore(std::shared_ptr<MarkingStore> store) {
+                assert(_passed._passed.empty());
+                _passed._store = std::move(store);
+            }
+
+            std::pair<bool, size_t> add(const State& state) override
+            {
+                return _add(state, _passed);
+            }
+
+            void decode(State& state, size_t id) override
+            {
+                _decode(state, id, _passed);
+            }
+
+            std::pair<bool, size_t> lookup(State& state) override
+            {
+                return _lookup(state, _passed);
+            }
+
+            void setHistory(size_t id, size_t transition) override {}
+
+            std::pair<size_t, size_t> getHistory(size_t markingid) override
+            {
+                throw base_error("The passed-list of a marking store does not keep the history of markings");
+            }
+
+            size_t size() const override {
+                return _passed._passed.size();
+            }
+
+        private:
+            passed_t _passed;
+        };
+    }
+}
+
+#endif // MARKINGSTORE_H
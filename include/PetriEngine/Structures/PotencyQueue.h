@@ -4,6 +4,7 @@
 #include <queue>
 
 #include "../PQL/PQL.h"
+#include "Queue.h"
 
 namespace PetriEngine {
     namespace Structures {
@@ -36,12 +37,20 @@ namespace PetriEngine {
 
             virtual void push(size_t id, PQL::DistanceContext *context, const PQL::Condition *query, uint32_t t) = 0;
 
+            // the marking of the context is about to be expanded, see PQL::IncrementalDistance
+            void expand(PQL::DistanceContext *context, const PQL::Condition *query);
+
         protected:
+            // the distance of a successor of the expanded marking by firing t
+            uint32_t distance(PQL::DistanceContext *context, const PQL::Condition *query, uint32_t t);
+
             size_t _size = 0;
             size_t _best;
             uint32_t _currentParentDist;
             std::vector<uint32_t> _potencies;
-            std::vector<std::priority_queue<weighted_t>> _queues;
+            using queue_t = std::priority_queue<weighted_t, tracked_vector<weighted_t>>;
+            std::vector<queue_t> _queues;
+            std::shared_ptr<PQL::IncrementalDistance> _distance;
 
             const static uint32_t _initPotencyConstant = 1;
             const static uint32_t _initPotencyMultiplier = 60;
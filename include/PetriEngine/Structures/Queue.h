@@ -20,9 +20,17 @@
 #include <random>
 
 #include "../PQL/PQL.h"
+#include "../PQL/IncrementalDistance.h"
+#include "utils/MemoryBudget.h"
 
 namespace PetriEngine {
     namespace Structures {
+        // the waiting lists count towards the memory budget
+        template<typename T>
+        using tracked_vector = std::vector<T, tracked_allocator<T>>;
+        template<typename T>
+        using tracked_deque = std::deque<T, tracked_allocator<T>>;
+
         class Queue {
         public:
             Queue(size_t s = 0);
@@ -45,8 +53,8 @@ namespace PetriEngine {
                 const PQL::Condition* query) override;
             virtual bool empty() const override;
         private:
-            std::queue<uint32_t> _queue;
-            std::vector<uint32_t> _cache;
+            std::queue<uint32_t, tracked_deque<uint32_t>> _queue;
+            tracked_vector<uint32_t> _cache;
             std::default_random_engine _rng;
         };
 
@@ -61,7 +69,7 @@ namespace PetriEngine {
                 const PQL::Condition* query);
             virtual bool empty() const override;
         private:
-            std::stack<uint32_t> _stack;
+            std::stack<uint32_t, tracked_deque<uint32_t>> _stack;
         };
 
         class RDFSQueue : public Queue {
@@ -74,8 +82,8 @@ namespace PetriEngine {
                 const PQL::Condition* query);
             virtual bool empty() const override;
         private:
-            std::stack<uint32_t> _stack;
-            std::vector<uint32_t> _cache;
+            std::stack<uint32_t, tracked_deque<uint32_t>> _stack;
+            tracked_vector<uint32_t> _cache;
             std::default_random_engine _rng;
         };
 
@@ -98,9 +106,15 @@ namespace PetriEngine {
             virtual size_t pop();
             virtual void push(size_t id, PQL::DistanceContext*,
                 const PQL::Condition* query);
+            // the marking of the context is about to be expanded, see PQL::IncrementalDistance
+            void expand(PQL::DistanceContext* context, const PQL::Condition* query);
+            // push a successor of the expanded marking by firing t
+            void push(size_t id, PQL::DistanceContext*,
+                const PQL::Condition* query, uint32_t t);
             virtual bool empty() const override;
         private:
-            std::priority_queue<weighted_t> _queue;
+            std::priority_queue<weighted_t, tracked_vector<weighted_t>> _queue;
+            std::shared_ptr<PQL::IncrementalDistance> _distance;
         };
     }
 }
@@ -0,0 +1,74 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SHARDED_H
+#define SHARDED_H
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace PetriEngine {
+    namespace Structures {
+
+        /**
+         * A number of shards of T, each with its own lock, so threads only contend
+         * when they access the same shard. With a single shard the structure is
+         * meant for a single thread and is never locked.
+         */
+        template<typename T>
+        class sharded_t {
+        public:
+            explicit sharded_t(size_t shards)
+            {
+                _shards.reserve(std::max<size_t>(shards, 1));
+                for(size_t i = 0; i < std::max<size_t>(shards, 1); ++i)
+                    _shards.emplace_back(std::make_unique<shard_t>());
+            }
+
+            size_t size() const {
+                return _shards.size();
+            }
+
+            /** Applies f to the given shard while holding its lock */
+            template<typename F>
+            auto apply(size_t shard, F&& f)
+            {
+                auto& s = *_shards[shard];
+                if(_shards.size() == 1)
+                    return f(s._data);
+                std::lock_guard<std::mutex> guard(s._lock);
+                return f(s._data);
+            }
+
+            /** Access without locking, only when no other thread uses the shards */
+            T& operator[](size_t shard) {
+                return _shards[shard]->_data;
+            }
+
+        private:
+            struct shard_t {
+                std::mutex _lock;
+                T _data;
+            };
+
+            std::vector<std::unique_ptr<shard_t>> _shards;
+        };
+    }
+}
+
+#endif // SHARDED_H
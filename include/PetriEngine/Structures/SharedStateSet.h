@@ -0,0 +1,103 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SHAREDSTATESET_H
+#define SHAREDSTATESET_H
+
+#include "StateSet.h"
+#include "MarkingStore.h"
+#include "utils/errors.h"
+
+#include <atomic>
+
+namespace PetriEngine {
+    namespace Structures {
+
+        /**
+         * A passed-list which can be shared by several search workers.
+         * The markings are kept in a MarkingStore, whose shards each have their own
+         * lock, so workers only contend when they hit the same shard.
+         * Workers access the set through a view, which owns the (non thread-safe)
+         * encoder and the statistics of the worker.
+         */
+        class SharedStateSet {
+        public:
+            class View : public EncodingStateSetInterface {
+            public:
+                View(SharedStateSet& set, const PetriNet& net, uint32_t kbound)
+                : EncodingStateSetInterface(net, kbound), _set(set) {}
+
+                std::pair<bool, size_t> add(const State& state) override
+                {
+                    ++_set._discovered;
+                    return _add(state, _set._store);
+                }
+
+                void decode(State& state, size_t id) override
+                {
+                    _decode(state, id, _set._store);
+                }
+
+                std::pair<bool, size_t> lookup(State& state) override
+                {
+                    return _lookup(state, _set._store);
+                }
+
+                void setHistory(size_t id, size_t transition) override {}
+
+                std::pair<size_t, size_t> getHistory(size_t markingid) override
+                {
+                    throw base_error("The shared passed-list does not keep the history of markings");
+                }
+
+                size_t size() const override {
+                    return _set.size();
+                }
+
+                /**
+                 * Folds the statistics of another (finished) worker into this view.
+                 */
+                void merge(const View& other)
+                {
+                    _discovered += other._discovered;
+                    _maxTokens = std::max(_maxTokens, other._maxTokens);
+                    for(size_t p = 0; p < _maxPlaceBound.size(); ++p)
+                        _maxPlaceBound[p] = std::max(_maxPlaceBound[p], other._maxPlaceBound[p]);
+                }
+
+            private:
+                SharedStateSet& _set;
+            };
+
+            SharedStateSet(size_t shards)
+            : _store(shards) {}
+
+            size_t size() const {
+                return _store.size();
+            }
+
+            size_t discovered() const {
+                return _discovered;
+            }
+
+        private:
+            MarkingStore _store;
+            std::atomic<size_t> _discovered{0};
+        };
+    }
+}
+
+#endif // SHAREDSTATESET_H
@@ -27,6 +27,7 @@
 #include "AlignedEncoder.h"
 #include "utils/structures/binarywrapper.h"
 #include "utils/errors.h"
+#include "utils/MemoryBudget.h"
 #include "PetriEngine/PQL/Contexts.h"
 
 
@@ -328,9 +329,14 @@ namespace PetriEngine {
 
             virtual void setHistory(size_t id, size_t transition) = 0;
 
+            /** The marking of id will not be decoded again */
+            virtual void release(size_t id) {}
+
         protected:
             AlignedEncoder _encoder;
             binarywrapper_t _sp;
+            // bytes of the encodings of the markings added
+            size_t _encoded = 0;
 #ifdef DEBUG
             std::vector<uint32_t*> _dbg;
 #endif
@@ -383,6 +389,7 @@ namespace PetriEngine {
                 {
                     return std::pair<bool, size_t>(false, tit.second);
                 }
+                _encoded += length;
 
 #ifdef DEBUG
                 _dbg.push_back(new uint32_t[_net.numberOfPlaces()]);
@@ -453,9 +460,18 @@ namespace PetriEngine {
         public:
             using EncodingStateSetInterface::EncodingStateSetInterface;
 
+            ~StateSet()
+            {
+                MemoryBudget::released(_encoded);
+            }
+
             std::pair<bool, size_t> add(const State& state) override
             {
-                return _add(state, _trie);
+                // the ptrie cannot report its allocations, so the budget counts the encodings it holds
+                auto encoded = _encoded;
+                auto res = _add(state, _trie);
+                MemoryBudget::allocated(_encoded - encoded);
+                return res;
             }
 
             void decode(State& state, size_t id) override
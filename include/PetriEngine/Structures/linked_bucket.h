@@ -26,6 +26,9 @@
 #include <atomic>
 #include <vector>
 #include <iostream>
+#include <new>
+
+#include "utils/MemoryBudget.h"
 
 #ifndef LINKED_BUCKET_H
 #define LINKED_BUCKET_H
@@ -39,12 +42,31 @@ private:
         std::atomic<size_t> _offset;
         size_t _count;
         T _data[C];
+
+        // buckets are over-aligned, so these are the forms used by new and delete
+        static void* operator new(size_t size, std::align_val_t align) {
+            MemoryBudget::allocated(size);
+            return ::operator new(size, align);
+        }
+        static void operator delete(void* p, size_t size, std::align_val_t align) {
+            MemoryBudget::released(size);
+            ::operator delete(p, align);
+        }
     } __attribute__ ((aligned (64)));
     
     struct index_t
     {
         bucket_t* _index[C];
         std::atomic<index_t*> _next;
+
+        static void* operator new(size_t size) {
+            MemoryBudget::allocated(size);
+            return ::operator new(size);
+        }
+        static void operator delete(void* p, size_t size) {
+            MemoryBudget::released(size);
+            ::operator delete(p);
+        }
     };
 
     bucket_t* _begin;
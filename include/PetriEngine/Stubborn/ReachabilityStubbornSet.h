@@ -22,6 +22,8 @@
 #include "PetriEngine/Stubborn/StubbornSet.h"
 #include "InterestingTransitionVisitor.h"
 
+#include <mutex>
+
 namespace PetriEngine {
     class ReachabilityStubbornSet : public StubbornSet {
     public:
@@ -43,10 +45,15 @@ namespace PetriEngine {
             _interesting = std::make_unique<TVisitor>(*this, _closure);
         }
 
+        // the queries are annotated during prepare; stubborn sets sharing the
+        // same query objects across threads must share a lock for this.
+        void setQueryLock(std::mutex* lock) { _query_lock = lock; }
+
     private:
         std::unique_ptr<InterestingTransitionVisitor> _interesting;
 
         bool _closure;
+        std::mutex* _query_lock = nullptr;
     };
 }
 
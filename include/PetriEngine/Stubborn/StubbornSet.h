@@ -19,11 +19,13 @@
 #define VERIFYPN_STUBBORNSET_H
 
 #include "PetriEngine/PetriNet.h"
+#include "PetriEngine/EnablednessKernel.h"
 #include "PetriEngine/Structures/State.h"
 #include "utils/structures/light_deque.h"
 #include "PetriEngine/PQL/PQL.h"
 
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace PetriEngine {
@@ -101,6 +103,9 @@ namespace PetriEngine {
             _queries = conds;
         }
 
+        /** Maintain the enabled transitions incrementally, see SuccessorGenerator::setIncremental */
+        void setIncremental(bool incremental) { _incremental = incremental; }
+
         [[nodiscard]] size_t nenabled() const { return _nenabled; }
 
         [[nodiscard]] bool *enabled() const { return _enabled.get(); };
@@ -235,6 +240,8 @@ namespace PetriEngine {
         std::unique_ptr<uint32_t[]> _dependency;
         bool _netContainsInhibitorArcs, _done;
         std::vector<std::vector<uint32_t>> _inhibpost;
+        std::optional<EnablednessKernel> _kernel;
+        bool _incremental = false;
 
         std::vector<PQL::Condition *> _queries;
 
@@ -243,24 +250,20 @@ namespace PetriEngine {
             _ordering.clear();
             memset(_enabled.get(), 0, _net.numberOfTransitions());
             memset(_stubborn.get(), 0, _net.numberOfTransitions());
-            for (uint32_t p = 0; p < _net.numberOfPlaces(); ++p) {
-                // orphans are currently under "place 0" as a special case
-                if (p == 0 || _parent->marking()[p] > 0) {
-                    uint32_t t = placeToPtrs()[p];
-                    uint32_t last = placeToPtrs()[p + 1];
-
-                    for (; t != last; ++t) {
-                        if (!checkPreset(t)) {
-                            continue;
-                        }
-                        if constexpr (!std::is_null_pointer_v<T>)
-                            if(!callback(t))
-                                return;
-                        _enabled[t] = true;
-                        _ordering.push_back(t);
-                        ++_nenabled;
-                    }
-                }
+            if (!_kernel)
+                _kernel.emplace(_net);
+            if (_incremental)
+                _kernel->update(_parent->marking());
+            else
+                _kernel->compute(_parent->marking());
+            const uint32_t last = _net.numberOfTransitions();
+            for (uint32_t t = _kernel->next(0, last); t != last; t = _kernel->next(t + 1, last)) {
+                if constexpr (!std::is_null_pointer_v<T>)
+                    if(!callback(t))
+                        return;
+                _enabled[t] = true;
+                _ordering.push_back(t);
+                ++_nenabled;
             }
         }
 
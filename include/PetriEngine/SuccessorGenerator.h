@@ -15,8 +15,10 @@
 #define SUCCESSORGENERATOR_H
 
 #include "PetriNet.h"
+#include "EnablednessKernel.h"
 #include "Structures/State.h"
 #include <memory>
+#include <optional>
 #include "Stubborn/StubbornSet.h"
 
 namespace PetriEngine {
@@ -55,6 +57,13 @@ public:
 
     void reset();
 
+    /**
+     * Derive the enabled transitions of a state from those of the previously
+     * prepared state, rechecking only the transitions reading the places that
+     * changed. This pays off when consecutive states are close, as in a DFS.
+     */
+    void setIncremental(bool incremental) { _incremental = incremental; }
+
     /**
      * Checks if the conditions are met for fireing t, if write != NULL,
      * then also consumes tokens from write while checking
@@ -83,8 +92,15 @@ protected:
 
     void _fire(Structures::State &write, uint32_t tid);
 
+    // computes the enabled transitions of the parent in bulk
+    void computeEnabled();
+
     template<typename T>
     bool _next(Structures::State& write, T&& predicate) {
+        // a resumed generator only has a few transitions left, check those one by one
+        // unless the enabled transitions are maintained incrementally
+        if (!_has_enabled && (_incremental || (_suc_pcounter == 0 && _suc_tcounter == std::numeric_limits<uint32_t>::max())))
+            computeEnabled();
         for (; _suc_pcounter < _net._nplaces; ++_suc_pcounter) {
             // orphans are currently under "place 0" as a special case
             if (_suc_pcounter == 0 || (*_parent).marking()[_suc_pcounter] > 0) {
@@ -93,8 +109,10 @@ protected:
                 }
                 uint32_t last = _net._placeToPtrs[_suc_pcounter + 1];
                 for (; _suc_tcounter != last; ++_suc_tcounter) {
-
-                    if (!checkPreset(_suc_tcounter)) continue;
+                    if (_has_enabled) {
+                        _suc_tcounter = _kernel->next(_suc_tcounter, last);
+                        if (_suc_tcounter == last) break;
+                    } else if (!checkPreset(_suc_tcounter)) continue;
                     if (!predicate(_suc_tcounter)) continue;
                     _fire(write, _suc_tcounter); // <-- also updated _suc_tcounter
                     return true;
@@ -111,6 +129,11 @@ protected:
     uint32_t _suc_pcounter;
     uint32_t _suc_tcounter;
 
+    // built on first use, generators that never call _next do not pay for it
+    std::optional<EnablednessKernel> _kernel;
+    bool _has_enabled = false;
+    bool _incremental = false;
+
 private:
 
     friend class ReducingSuccessorGenerator;
@@ -27,6 +27,8 @@
 #include "PetriEngine/Reachability/ReachabilitySearch.h"
 #include "PetriEngine/options.h"
 
+#include <atomic>
+
 namespace PetriEngine {
     namespace Reachability {
         class Solver;
@@ -50,7 +52,11 @@ namespace PetriEngine {
                 std::vector<std::shared_ptr<PQL::Condition > >& queries,
                 std::vector<ResultPrinter::Result>& results,
                 StatisticsLevel statisticsLevel, bool printtrace);
+
+            // lets another thread cancel the search; a cancelled search reports nothing further
+            void setAbort(const std::atomic<bool>* abort) { _abort = abort; }
         private:
+            bool aborted() const { return _abort != nullptr && *_abort; }
 
             void printTrace(trace_t& stack);
             void nextEdge(AntiChain<uint32_t, size_t>& checked, state_t& state, trace_t& waiting, std::set<size_t>& nextinter);
@@ -73,6 +79,7 @@ namespace PetriEngine {
             PetriNet& _net;
             Reducer* _reducer;
             TraceSet _traceset;
+            const std::atomic<bool>* _abort = nullptr;
 
 #ifdef TAR_TIMING
             double _check_time = 0;
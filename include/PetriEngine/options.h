@@ -9,6 +9,7 @@
 #include <limits>
 #include <set>
 #include <sstream>
+#include <string>
 #include <vector>
 #include <iostream>
 #include <cstdint>
@@ -40,6 +41,18 @@ enum class TemporalLogic {
     CTL, LTL
 };
 
+enum class StateCompaction {
+    None,
+    Hash,
+    Bitstate
+};
+
+enum class MemoryPolicy {
+    Compact,
+    Spill,
+    Stop
+};
+
 enum class StatisticsLevel {
     None,
     SearchOnly,
@@ -56,6 +69,7 @@ struct options_t {
     std::vector<uint32_t> reductions{8,2,3,4,5,7,9,6,0,1};
     std::vector<uint32_t> colreductions{};
     int reductionTimeout = 60;
+    bool reducePerQuery = false; // one reduced net per group of queries mentioning the same places
     int colReductionTimeout = 30;
     bool stubbornreduction = true;
     bool statespaceexploration = false;
@@ -68,6 +82,16 @@ struct options_t {
     uint32_t siphontrapTimeout = 0;
     uint32_t siphonDepth = 0;
     uint32_t cores = 1;
+    bool portfolio = false;
+    size_t portfolioMemory = 0; // in MB, 0 is unbounded
+    StateCompaction stateCompaction = StateCompaction::None;
+    size_t bitstateSize = 512; // in MB
+    uint32_t bitstateHashes = 3;
+    std::string externalMemory; // directory of the external passed-list, empty if unused
+    size_t externalMemoryBudget = 1024; // in MB
+    size_t maxMemory = 0; // in MB, 0 is unbounded
+    MemoryPolicy memoryPolicy = MemoryPolicy::Compact;
+    std::string spillDirectory = ".";
     bool doVerification = true;
     bool doUnfolding = true;
     int64_t depthRandomWalk = 50000;
@@ -100,6 +124,8 @@ struct options_t {
     std::string model_out_file;
     std::string model_col_out_file;
     std::string unfolded_out_file;
+    uint32_t binary_net_io = 0;
+    std::string netCache; // directory of the cached unfolded and reduced nets, empty if unused
     std::string unfold_query_out_file;
     bool keep_solved = false;
 
@@ -113,11 +139,13 @@ struct options_t {
     uint32_t seed_offset = 0;
     int max_intervals = 500; //0 disabled
     int max_intervals_reduced = 5;
+    bool lazyUnfolding = false;
     bool print_bindings = false;
     bool interactive_mode = false;
 
     bool explicit_colored = false;
     ColoredSuccessorGeneratorOption colored_sucessor_generator = ColoredSuccessorGeneratorOption::EVEN;
+    bool colored_encoded_waiting_list = false;
 
     std::string strategy_output;
 
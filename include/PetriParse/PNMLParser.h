@@ -32,6 +32,8 @@
 #include "../PetriEngine/Colored/Expressions.h"
 #include "../PetriEngine/Colored/Colors.h"
 #include "../PetriEngine/Colored/EquivalenceClass.h"
+#include "../utils/MappedFile.h"
+#include "XMLPullReader.h"
 
 class PNMLParser {
 
@@ -75,6 +77,18 @@ public:
     void parse(std::istream& xml,
             PetriEngine::AbstractPetriNetBuilder* builder);
 
+    /**
+     * Parses a mapped model file. Nets without colors are streamed straight into
+     * the builder without building a DOM; places and transitions are added as
+     * they are read, and so are the arcs after both of their ends.
+     * Colored nets are parsed by rapidxml in place in the mapping.
+     */
+    void parse(MappedFile& file,
+            PetriEngine::AbstractPetriNetBuilder* builder);
+
+    /** False if the model text may be of a colored net, in which case it is not streamed */
+    static bool streamable(const char* data, size_t size);
+
     std::vector<Query> getQueries() {
         return queries;
     }
@@ -84,6 +98,18 @@ public:
         PetriEngine::AbstractPetriNetBuilder* builder,
         ColorTypeMap* colorTypes);
 private:
+    void parseDocument(char* text, PetriEngine::AbstractPetriNetBuilder* builder);
+    void addArc(const Arc& arc);
+    void parseStream(const char* data, size_t size);
+    void streamElement(XMLPullReader& reader);
+    void streamPlace(XMLPullReader& reader);
+    void streamTransition(XMLPullReader& reader);
+    void streamArc(XMLPullReader& reader, bool inhibitor);
+    void streamTransportArc(XMLPullReader& reader);
+    void streamQueries(XMLPullReader& reader);
+    void streamValue(XMLPullReader& reader, std::string& text);
+    void streamPosition(XMLPullReader& reader, double& x, double& y);
+    void addArcLazily(Arc&& arc);
     void parseElement(rapidxml::xml_node<>* element);
     void parsePlace(rapidxml::xml_node<>* element);
     void parseArc(rapidxml::xml_node<>* element, bool inhibitor = false);
@@ -0,0 +1,83 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef XMLPULLREADER_H
+#define XMLPULLREADER_H
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * A pull reader over an XML text in memory, which is never modified or copied.
+ * Each call to next gives the next start tag, end tag or text; names and
+ * attributes refer into the text until the next call. Comments, processing
+ * instructions and the document type are skipped. Only the predefined and
+ * numeric entities are decoded, which is all PNML uses.
+ */
+class XMLPullReader {
+public:
+    enum event_t { START, END, TEXT, DONE };
+
+    XMLPullReader(const char* begin, const char* end)
+    : _begin(begin), _pos(begin), _end(end) {}
+
+    event_t next();
+
+    /** The name of the element of the last START or END */
+    std::string_view name() const { return _name; }
+
+    /** The value of attribute name of the last START, false if it has none */
+    bool attribute(std::string_view name, std::string& value) const;
+
+    /** The text of the last TEXT, with the entities decoded */
+    std::string text() const;
+
+    /**
+     * Moves to the next child of the element of the last START, or past its
+     * END if it has no more. Text between the children is skipped.
+     */
+    bool child();
+
+    /** Moves past the END of the element of the last START */
+    void skip();
+
+    /** Moves past the END of the element of the last START, giving the text directly inside it */
+    std::string content();
+
+    /** The offset into the text, for error messages */
+    size_t offset() const { return _pos - _begin; }
+
+private:
+    const char* find(const char* what) const;
+    const char* scanName();
+    void skipSpace();
+    void expect(char c);
+    [[noreturn]] void fail(const char* message) const;
+    static std::string decode(std::string_view raw);
+
+    const char* _begin;
+    const char* _pos;
+    const char* _end;
+    std::string_view _name;
+    std::string_view _text;
+    std::vector<std::pair<std::string_view, std::string_view>> _attributes;
+    bool _closing = false;
+    bool _cdata = false;
+};
+
+#endif // XMLPULLREADER_H
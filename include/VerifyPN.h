@@ -72,6 +72,7 @@
 #include "PetriParse/QueryBinaryParser.h"
 #include "PetriParse/PNMLParser.h"
 #include "PetriEngine/PetriNetBuilder.h"
+#include "PetriEngine/NetCache.h"
 #include "PetriEngine/PQL/PQL.h"
 #include "PetriEngine/PQL/CTLVisitor.h"
 #include "PetriEngine/PQL/XMLPrinter.h"
@@ -117,7 +118,8 @@ unfold(ColoredPetriNetBuilder& cpnBuilder, bool compute_partiton,
        bool compute_symmetry, bool computed_fixed_point,
        std::ostream& out = std::cout, int32_t partitionTimeout = 0,
        int32_t max_intervals = 0, int32_t intervals_reduced = 0,
-       int32_t interval_timeout = 0, bool over_approx = false, bool print_bindings = false);
+       int32_t interval_timeout = 0, bool over_approx = false, bool print_bindings = false,
+       uint32_t threads = 1, bool lazy = false);
 
 ReturnValue contextAnalysis(bool colored, const shared_name_name_map& transition_names,
                             const shared_place_color_map& place_names,
@@ -145,6 +147,55 @@ Condition_ptr simplify_ltl_query(Condition_ptr query, options_t options,
 
 void outputNet(const PetriNetBuilder &builder, std::string out_file);
 
+void outputBinaryNet(const PetriNetBuilder &builder, bool colored, const shared_name_name_map& transition_names,
+    const shared_place_color_map& place_names, std::string out_file);
+
+/**
+ * Hashes the model file and what its unfolding depends on into key,
+ * false if the model cannot be read
+ */
+bool unfoldingCacheKey(const options_t& options, std::vector<Condition_ptr>& queries, NetCache::Key& key);
+
+/** Extends the key of the unfolded net with what its structural reduction depends on */
+NetCache::Key reductionCacheKey(NetCache::Key key, const options_t& options,
+                                std::vector<Condition_ptr>& queries,
+                                const std::vector<ResultPrinter::Result>& results);
+
+/**
+ * Groups the queries which are not answered yet such that the queries of a group
+ * get the same structural reduction alone as together, empty if the queries
+ * cannot be reduced apart
+ */
+std::vector<std::vector<size_t>> reductionGroups(const PetriNetBuilder& builder, std::vector<Condition_ptr>& queries,
+                                                 const std::vector<ResultPrinter::Result>& results);
+
+/**
+ * Reduces a copy of builder for each of the given groups of queries, on up to --cores
+ * threads, builder should already have saved its initial net when a trace is requested
+ */
+std::vector<std::unique_ptr<PetriNetBuilder>>
+reducePerQuery(PetriNetBuilder& builder, std::vector<Condition_ptr>& queries,
+               const std::vector<ResultPrinter::Result>& results,
+               const std::vector<std::vector<size_t>>& groups, options_t& options);
+
+/**
+ * Verifies the queries which are not answered yet on net, the reduction of builder,
+ * returns early once all queries are answered
+ */
+int verify(PetriNetBuilder& builder, PetriNet* net, ResultPrinter& printer, options_t& options,
+           std::vector<Condition_ptr>& queries, std::vector<ResultPrinter::Result>& results,
+           std::vector<std::string>& querynames, const shared_name_name_map& transition_names,
+           const shared_place_color_map& place_names);
+
+/**
+ * Verifies each group of queries on its own reduction of builder, which is reduced a batch
+ * of --cores groups at a time, and records the answers of the groups in results
+ */
+int verifyPerQuery(PetriNetBuilder& builder, const std::vector<std::vector<size_t>>& groups, options_t& options,
+                   std::vector<Condition_ptr>& queries, std::vector<ResultPrinter::Result>& results,
+                   std::vector<std::string>& querynames, const shared_name_name_map& transition_names,
+                   const shared_place_color_map& place_names);
+
 void outputQueries(const PetriNetBuilder &builder,
                    const std::vector<PetriEngine::PQL::Condition_ptr> &queries,
                    std::vector<std::string> &querynames, std::string filename,
@@ -0,0 +1,115 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * A file mapped privately into memory; pages are only read in when touched
+ * and can be dropped by the kernel again, so a large file does not have to
+ * fit in memory. Writes are copy-on-write and never reach the file.
+ * Where mmap is not available the file is read into a buffer instead.
+ */
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+#ifndef _WIN32
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return;
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || S_ISDIR(st.st_mode)) {
+            ::close(fd);
+            return;
+        }
+        if (S_ISREG(st.st_mode)) {
+            _size = st.st_size;
+            _page = sysconf(_SC_PAGESIZE);
+            if (_size == 0)
+                _open = true;
+            else {
+                void* data = ::mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+                if (data != MAP_FAILED) {
+                    _data = static_cast<char*>(data);
+                    _mapped = true;
+                    _open = true;
+                    ::madvise(data, _size, MADV_SEQUENTIAL);
+                }
+            }
+        }
+        ::close(fd);
+        if (_open)
+            return;
+        // pipes and other streams are read
+#endif
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            return;
+        _buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        _size = _buffer.size();
+        _buffer.push_back('\0');
+        _data = _buffer.data();
+        _open = true;
+    }
+
+    ~MappedFile() {
+#ifndef _WIN32
+        if (_mapped)
+            ::munmap(_data, _size);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool is_open() const { return _open; }
+
+    char* data() { return _data; }
+    const char* data() const { return _data; }
+    size_t size() const { return _size; }
+
+    /**
+     * True if data()[size()] is a readable '\0', as rapidxml needs for parsing in place.
+     * The remainder of the last page of a mapping is zero filled, unless the
+     * file ends on a page boundary.
+     */
+    bool terminated() const {
+        return _data != nullptr && (!_mapped || _size % _page != 0);
+    }
+
+private:
+    char* _data = nullptr;
+    size_t _size = 0;
+    size_t _page = 1;
+    bool _mapped = false;
+    bool _open = false;
+    std::vector<char> _buffer;
+};
+
+#endif // MAPPEDFILE_H
@@ -1,6 +1,8 @@
 #ifndef MATHEXT_H
 #define MATHEXT_H
 
+#include <cstdint>
+
 /// maps value to [0,max) using modulo but when value is negative
 /// it is handled differently s.t. signed_wrap(-1, 5) = 4
 template <typename S, typename U>
@@ -22,4 +24,16 @@ std::make_unsigned_t<U> addColorOffset(U baseValue, O offset, U max) {
     static_assert(std::is_signed_v<O>, "O needs to be signed");
     return signedWrap(static_cast<int64_t>(baseValue) + static_cast<int64_t>(offset), max);
 }
+
+/// index of the lowest set bit of word, which must not be 0
+inline uint32_t lowestBit(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#else
+    uint32_t bit = 0;
+    for (; (word & 1) == 0; word >>= 1)
+        ++bit;
+    return bit;
+#endif
+}
 #endif //MATHEXT_H
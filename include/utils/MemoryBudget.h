@@ -0,0 +1,128 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MEMORYBUDGET_H
+#define MEMORYBUDGET_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <fstream>
+#include <memory>
+#include <new>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+/**
+ * Process-wide memory budget of the searches. The containers of the searches
+ * (queues, stacks and buckets) report their allocations here; the ptries
+ * cannot, so the exact passed-list reports the size of the encodings it holds,
+ * and the resident memory of the process is sampled as well where the
+ * platform reports it. A budget of 0 is unbounded.
+ */
+class MemoryBudget {
+public:
+    static void setLimit(size_t bytes) { _limit = bytes; }
+    static size_t limit() { return _limit; }
+
+    static void allocated(size_t bytes) { _tracked.fetch_add(bytes, std::memory_order_relaxed); }
+    static void released(size_t bytes) { _tracked.fetch_sub(bytes, std::memory_order_relaxed); }
+
+    /** Bytes currently held by the tracked containers */
+    static size_t tracked() { return _tracked.load(std::memory_order_relaxed); }
+
+    /** Resident memory of the process in bytes, 0 if unknown */
+    static size_t resident() {
+#ifdef __linux__
+        std::ifstream statm("/proc/self/statm");
+        size_t size = 0, resident = 0;
+        if (statm >> size >> resident)
+            return resident * sysconf(_SC_PAGESIZE);
+#endif
+        return 0;
+    }
+
+    /**
+     * True if the budget is exceeded. Cheap enough to be called once per state,
+     * as the resident memory is only sampled every so often.
+     */
+    static bool exceeded() {
+        if (_limit == 0)
+            return false;
+        thread_local size_t calls = 0;
+        if (++calls % SAMPLE_INTERVAL == 0)
+            _resident.store(resident(), std::memory_order_relaxed);
+        return tracked() > _limit ||
+               _resident.load(std::memory_order_relaxed) > std::max(_limit, _floor.load(std::memory_order_relaxed));
+    }
+
+    /**
+     * Called when a search has freed its memory and another one starts.
+     * Freed memory is not always returned to the system, but it is reused by
+     * the next search, so the resident memory at this point is not held against it.
+     * The tracked containers are still held to the limit.
+     */
+    static void reset() {
+#if defined(__GLIBC__)
+        malloc_trim(0);
+#endif
+        _resident = resident();
+        _floor = _resident.load();
+    }
+
+private:
+    static constexpr size_t SAMPLE_INTERVAL = 4096;
+    inline static size_t _limit = 0;
+    inline static std::atomic<size_t> _tracked{0};
+    inline static std::atomic<size_t> _resident{0};
+    inline static std::atomic<size_t> _floor{0};
+};
+
+/** An std::allocator reporting to the MemoryBudget */
+template<typename T>
+struct tracked_allocator : public std::allocator<T> {
+    using value_type = T;
+
+    template<typename U>
+    struct rebind { using other = tracked_allocator<U>; };
+
+    tracked_allocator() = default;
+    template<typename U>
+    tracked_allocator(const tracked_allocator<U>&) {}
+
+    T* allocate(size_t n) {
+        MemoryBudget::allocated(n * sizeof(T));
+        return std::allocator<T>::allocate(n);
+    }
+
+    void deallocate(T* p, size_t n) {
+        MemoryBudget::released(n * sizeof(T));
+        std::allocator<T>::deallocate(p, n);
+    }
+
+    template<typename U>
+    bool operator==(const tracked_allocator<U>&) const { return true; }
+    template<typename U>
+    bool operator!=(const tracked_allocator<U>&) const { return false; }
+};
+
+#endif // MEMORYBUDGET_H
@@ -11,6 +11,8 @@
 #include <memory>
 #include <cstring>
 
+#include "utils/MemoryBudget.h"
+
 template<typename T>
 class light_deque
 {
@@ -25,16 +27,19 @@ class light_deque
             if(initial_size == 0) initial_size = 1;
             _data = (T*)new uint8_t[initial_size*sizeof(T)]; // TODO, revisit with cast and initialization
             _size = initial_size;
+            MemoryBudget::allocated(_size*sizeof(T));
         }
 
         light_deque<T> &operator=(const light_deque<T> &other) {
             for(auto& e : *this)
                 e.~T();
             delete[] (uint8_t*)_data;
+            MemoryBudget::released(_size*sizeof(T));
             _front = 0;
             _back = 0;
             _size = other.size();
             _data = (T*)new uint8_t[_size*sizeof(T)];
+            MemoryBudget::allocated(_size*sizeof(T));
             for(auto& e : other)
                 push_back(e);
             return *this;
@@ -46,6 +51,7 @@ class light_deque
                 e.~T();
             }
             delete[] (uint8_t*)_data;
+            MemoryBudget::released(_size*sizeof(T));
             _data = nullptr;
         }
 
@@ -157,6 +163,7 @@ class light_deque
                 new (ndata + n) T(std::move(e));
                 ++n;
             }
+            MemoryBudget::allocated(_size*sizeof(T));
             _size *= 2;
             _back = (_back - _front);
             _front = 0;
@@ -70,17 +70,18 @@ void Algorithm::CertainZeroFPA::checkEdge(Edge* e, bool only_assign)
 
     bool allOne = true;
     bool hasCZero = false;
+    // explored last, the parallel algorithm lets go of the lock while exploring
+    Configuration *toExplore = nullptr;
     //auto pre_empty = e->targets.empty();
     Configuration *lastUndecided = nullptr;
     {
         auto it = e->targets.begin();
-        auto pit = e->targets.before_begin();
         while(it != e->targets.end())
         {
             if ((*it)->assignment == ONE)
             {
-                e->targets.erase_after(pit);
-                it = pit;
+                it = e->targets.erase(it);
+                continue;
             }
             else
             {
@@ -99,7 +100,6 @@ void Algorithm::CertainZeroFPA::checkEdge(Edge* e, bool only_assign)
                     lastUndecided = *it;
                 }
             }
-            pit = it;
             ++it;
         }
     }
@@ -134,7 +134,7 @@ void Algorithm::CertainZeroFPA::checkEdge(Edge* e, bool only_assign)
                 }
                 lastUndecided->addDependency(e);
                 if (lastUndecided->assignment == UNKNOWN) {
-                    explore(lastUndecided);
+                    toExplore = lastUndecided;
                 }
             }
         }
@@ -163,12 +163,13 @@ void Algorithm::CertainZeroFPA::checkEdge(Edge* e, bool only_assign)
                 }
             }
             if (lastUndecided->assignment == UNKNOWN) {
-                explore(lastUndecided);
+                toExplore = lastUndecided;
             }
         }
     }
     if(e->refcnt > 0  && !only_assign) e->processed = true;
     if(e->refcnt == 0) graph->release(e);
+    if(toExplore != nullptr) explore(toExplore);
 }
 
 void Algorithm::CertainZeroFPA::finalAssign(DependencyGraph::Edge *e, DependencyGraph::Assignment a)
@@ -210,57 +211,60 @@ void Algorithm::CertainZeroFPA::finalAssign(DependencyGraph::Configuration *c, D
     }
 
     c->dependency_set.clear();
+    c->dependency_set.shrink_to_fit();
 }
 
 void Algorithm::CertainZeroFPA::explore(Configuration *c)
 {
     c->assignment = ZERO;
+    graph->successors(c, _succs);
+    addSuccessors(c, _succs);
+}
 
-    {
-        auto succs = graph->successors(c);
-        c->nsuccs = succs.size();
+void Algorithm::CertainZeroFPA::addSuccessors(Configuration *c, std::vector<Edge*>& succs)
+{
+    c->nsuccs = succs.size();
 
-        _exploredConfigurations += 1;
-        _numberOfEdges += c->nsuccs;
-        // before we start exploring, lets check if any of them determine
-        // the outcome already!
+    _exploredConfigurations += 1;
+    _numberOfEdges += c->nsuccs;
+    // before we start exploring, lets check if any of them determine
+    // the outcome already!
 
-        for(int32_t i = c->nsuccs-1; i >= 0; --i)
+    for(int32_t i = c->nsuccs-1; i >= 0; --i)
+    {
+        checkEdge(succs[i], true);
+        if (c->isDone())
         {
-            checkEdge(succs[i], true);
-            if (c->isDone())
-            {
-                for(Edge *e : succs){
-                    assert(e->refcnt <= 1);
-                    if(e->refcnt >= 1) --e->refcnt;
-                    if(e->refcnt == 0) graph->release(e);
-                }
-                return;
-            }
-        }
-
-        if (c->nsuccs == 0) {
             for(Edge *e : succs){
                 assert(e->refcnt <= 1);
                 if(e->refcnt >= 1) --e->refcnt;
                 if(e->refcnt == 0) graph->release(e);
             }
-            finalAssign(c, CZERO);
             return;
         }
+    }
 
-        for (Edge *succ : succs) {
-            assert(succ->refcnt <= 1);
-            if(succ->refcnt > 0)
-            {
-                strategy->pushEdge(succ);
-                --succ->refcnt;
-                if(succ->refcnt == 0) graph->release(succ);
-            }
-            else if(succ->refcnt == 0)
-            {
-                graph->release(succ);
-            }
+    if (c->nsuccs == 0) {
+        for(Edge *e : succs){
+            assert(e->refcnt <= 1);
+            if(e->refcnt >= 1) --e->refcnt;
+            if(e->refcnt == 0) graph->release(e);
+        }
+        finalAssign(c, CZERO);
+        return;
+    }
+
+    for (Edge *succ : succs) {
+        assert(succ->refcnt <= 1);
+        if(succ->refcnt > 0)
+        {
+            strategy->pushEdge(succ);
+            --succ->refcnt;
+            if(succ->refcnt == 0) graph->release(succ);
+        }
+        else if(succ->refcnt == 0)
+        {
+            graph->release(succ);
         }
     }
     strategy->flush();
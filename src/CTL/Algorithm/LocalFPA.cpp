@@ -89,22 +89,23 @@ void Algorithm::LocalFPA::finalAssign(DependencyGraph::Configuration *c, Depende
     }
 
     c->dependency_set.clear();
+    c->dependency_set.shrink_to_fit();
 }
 
 void Algorithm::LocalFPA::explore(DependencyGraph::Configuration *c)
 {
     assert(c->assignment == DependencyGraph::UNKNOWN);
     c->assignment = DependencyGraph::ZERO;
-    auto succs = graph->successors(c);
+    graph->successors(c, _succs);
 
-    for (DependencyGraph::Edge *succ : succs) {
+    for (DependencyGraph::Edge *succ : _succs) {
         strategy->pushEdge(succ);
         --succ->refcnt;
         if(succ->refcnt == 0) graph->release(succ);
     }
 
     _exploredConfigurations += 1;
-    _numberOfEdges += succs.size();
+    _numberOfEdges += _succs.size();
 }
 
 void Algorithm::LocalFPA::addDependency(DependencyGraph::Edge *e, DependencyGraph::Configuration *target)
@@ -0,0 +1,168 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CTL/Algorithm/ParallelCertainZeroFPA.h"
+
+#include <cassert>
+#include <exception>
+#include <thread>
+
+using namespace DependencyGraph;
+using namespace SearchStrategy;
+
+Algorithm::ParallelCertainZeroFPA::ParallelCertainZeroFPA(std::shared_ptr<SearchStrategy::SearchStrategy> strategy,
+                                                          shared_t& shared, BasicDependencyGraph& t_graph,
+                                                          Configuration* t_vertex)
+: CertainZeroFPA(std::move(strategy)), _shared(&shared)
+{
+    graph = &t_graph;
+    vertex = t_vertex;
+}
+
+bool Algorithm::ParallelCertainZeroFPA::search(DependencyGraph::BasicDependencyGraph &t_graph)
+{
+    std::vector<std::unique_ptr<BasicDependencyGraph>> graphs;
+    for(uint32_t i = 1; i < _cores; ++i)
+    {
+        graphs.emplace_back(t_graph.workerGraph(i));
+        if(graphs.back() == nullptr)
+            return CertainZeroFPA::search(t_graph);
+    }
+    if(graphs.empty())
+        return CertainZeroFPA::search(t_graph);
+
+    graph = &t_graph;
+    vertex = graph->initialConfiguration();
+
+    shared_t shared;
+    std::vector<std::unique_ptr<ParallelCertainZeroFPA>> workers;
+    workers.emplace_back(new ParallelCertainZeroFPA(strategy, shared, t_graph, vertex));
+    for(auto& g : graphs)
+        workers.emplace_back(new ParallelCertainZeroFPA(strategy, shared, *g, vertex));
+
+    {
+        // nobody else is running yet, the initial exploration needs no care
+        std::unique_lock<std::mutex> guard(shared._lock);
+        workers[0]->_guard = &guard;
+        workers[0]->explore(vertex);
+    }
+
+    std::exception_ptr error = nullptr;
+    if(!vertex->isDone())
+    {
+        auto run = [&](size_t id) {
+            std::unique_lock<std::mutex> guard(shared._lock);
+            try {
+                workers[id]->work(guard);
+            } catch (...) {
+                if(error == nullptr)
+                    error = std::current_exception();
+                shared._stop = true;
+                shared._idle.notify_all();
+            }
+        };
+        std::vector<std::thread> threads;
+        for(size_t i = 0; i < workers.size(); ++i)
+            threads.emplace_back(run, i);
+        for(auto& t : threads)
+            t.join();
+    }
+    if(error != nullptr)
+        std::rethrow_exception(error);
+
+    for(auto& w : workers)
+    {
+        _processedEdges += w->_processedEdges;
+        _processedNegationEdges += w->_processedNegationEdges;
+        _exploredConfigurations += w->_exploredConfigurations;
+        _numberOfEdges += w->_numberOfEdges;
+    }
+    return vertex->assignment == ONE;
+}
+
+void Algorithm::ParallelCertainZeroFPA::work(std::unique_lock<std::mutex>& guard)
+{
+    _guard = &guard;
+    size_t cnt = 0;
+    while(!_shared->_stop && !vertex->isDone())
+    {
+        if(auto e = strategy->popEdge(false))
+        {
+            ++e->refcnt;
+            assert(e->refcnt >= 1);
+            checkEdge(e);
+            assert(e->refcnt >= -1);
+            if(e->refcnt > 0) --e->refcnt;
+            if(e->refcnt == 0) graph->release(e);
+            ++cnt;
+            if((cnt % 1000) == 0) strategy->trivialNegation();
+            continue;
+        }
+
+        if(_shared->_exploring > 0)
+        {
+            // workers still computing successors will bring more work
+            ++_shared->_waiting;
+            _shared->_idle.wait(guard);
+            --_shared->_waiting;
+            continue;
+        }
+
+        // nobody can add edges behind our back now
+        if(strategy->empty())
+            break;
+
+        if(!strategy->trivialNegation())
+        {
+            cnt = 0;
+            strategy->releaseNegationEdges(strategy->maxDistance());
+        }
+    }
+    _shared->_stop = true;
+    _shared->_idle.notify_all();
+}
+
+void Algorithm::ParallelCertainZeroFPA::explore(Configuration *c)
+{
+    if(_shared == nullptr)
+    {
+        CertainZeroFPA::explore(c);
+        return;
+    }
+
+    // claim the configuration before letting go of the lock; no edges leave
+    // it before its successors are added, so nobody else can assign it. Until
+    // then the others must not take it for ZERO, they only add dependencies.
+    c->assignment = EXPLORING;
+    ++_shared->_exploring;
+    _guard->unlock();
+    try {
+        graph->successors(c, _succs);
+    } catch (...) {
+        _guard->lock();
+        --_shared->_exploring;
+        throw;
+    }
+    _guard->lock();
+    --_shared->_exploring;
+
+    assert(c->assignment == EXPLORING);
+    c->assignment = ZERO;
+    addSuccessors(c, _succs);
+    if(_shared->_waiting > 0)
+        _shared->_idle.notify_all();
+}
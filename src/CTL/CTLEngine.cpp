@@ -5,6 +5,7 @@
 
 #include "CTL/Algorithm/CertainZeroFPA.h"
 #include "CTL/Algorithm/LocalFPA.h"
+#include "CTL/Algorithm/ParallelCertainZeroFPA.h"
 
 #include "utils/stopwatch.h"
 #include "PetriEngine/options.h"
@@ -16,8 +17,13 @@
 #include "PetriEngine/PQL/PredicateCheckers.h"
 #include "LTL/LTLSearch.h"
 
+#include <atomic>
+#include <exception>
 #include <iostream>
 #include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <thread>
 #include <vector>
 
 using namespace CTL;
@@ -27,7 +33,7 @@ using namespace PetriEngine::Reachability;
 using namespace PetriNets;
 
 ReturnValue getAlgorithm(std::shared_ptr<Algorithm::FixedPointAlgorithm>& algorithm,
-                         CTLAlgorithmType algorithmtype, Strategy search)
+                         CTLAlgorithmType algorithmtype, Strategy search, uint32_t cores)
 {
     switch(algorithmtype)
     {
@@ -35,7 +41,10 @@ ReturnValue getAlgorithm(std::shared_ptr<Algorithm::FixedPointAlgorithm>& algori
             algorithm = std::make_shared<Algorithm::LocalFPA>(search);
             break;
         case CTLAlgorithmType::CZero:
-            algorithm = std::make_shared<Algorithm::CertainZeroFPA>(search);
+            if(cores > 1)
+                algorithm = std::make_shared<Algorithm::ParallelCertainZeroFPA>(search, cores);
+            else
+                algorithm = std::make_shared<Algorithm::CertainZeroFPA>(search);
             break;
         default:
             throw base_error("Unknown or unsupported algorithm");
@@ -45,19 +54,24 @@ ReturnValue getAlgorithm(std::shared_ptr<Algorithm::FixedPointAlgorithm>& algori
 
 bool CTLSingleSolve(const Condition_ptr& query, PetriNet* net,
                  CTLAlgorithmType algorithmtype,
-                 Strategy strategytype, bool partial_order, CTLResult& result)
+                 Strategy strategytype, bool partial_order, CTLResult& result, uint32_t cores = 1,
+                 std::shared_ptr<Structures::MarkingStore> markings = nullptr)
 {
-    return CTLSingleSolve(query.get(), net, algorithmtype, strategytype, partial_order, result);
+    return CTLSingleSolve(query.get(), net, algorithmtype, strategytype, partial_order, result, cores, std::move(markings));
 }
 
 bool CTLSingleSolve(Condition* query, PetriNet* net,
                  CTLAlgorithmType algorithmtype,
-                 Strategy strategytype, bool partial_order, CTLResult& result)
+                 Strategy strategytype, bool partial_order, CTLResult& result, uint32_t cores,
+                 std::shared_ptr<Structures::MarkingStore> markings)
 {
-    OnTheFlyDG graph(net, partial_order);
+    // upper-bounds are recorded inside the query objects while evaluating
+    if(containsUpperBounds(query))
+        cores = 1;
+    OnTheFlyDG graph(net, partial_order, cores, std::move(markings));
     graph.setQuery(query);
     std::shared_ptr<Algorithm::FixedPointAlgorithm> alg = nullptr;
-    getAlgorithm(alg, algorithmtype,  strategytype);
+    getAlgorithm(alg, algorithmtype,  strategytype, cores);
 
     stopwatch timer;
     timer.start();
@@ -75,9 +89,52 @@ bool CTLSingleSolve(Condition* query, PetriNet* net,
     return res;
 }
 
+// What the queries solved by CTLMain share. The marking store is append-only, so once it
+// holds max_markings markings the next query starts a new one, and the old store is freed
+// when the last query using it is done. Spot and BuDDy keep global state, so the LTL
+// searches of queries solved concurrently take turns.
+class CTLScheduler {
+public:
+    // the memory a store may take without a --max-memory
+    static constexpr size_t default_store_memory = size_t(1) << 30;
+
+    CTLScheduler(const PetriNet& net, const options_t& options, size_t workers)
+    : _workers(workers), _shards(options.cores > 1 ? options.cores * 64 : 1)
+    {
+        // a store may take half of the memory budget, counting a marking at its unencoded size
+        size_t memory = options.maxMemory > 0 ? (options.maxMemory << 20) / 2 : default_store_memory;
+        _max_markings = std::max<size_t>(1, memory / (net.numberOfPlaces() * sizeof(MarkVal) + sizeof(size_t)));
+    }
+
+    std::shared_ptr<Structures::MarkingStore> markings()
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        if(_store == nullptr || _store->size() >= _max_markings)
+            _store = std::make_shared<Structures::MarkingStore>(_shards);
+        return _store;
+    }
+
+    // held while an LTL search runs, a single worker never waits
+    std::unique_lock<std::mutex> ltlTurn()
+    {
+        if(_workers <= 1)
+            return std::unique_lock<std::mutex>();
+        return std::unique_lock<std::mutex>(_ltl_lock);
+    }
+
+private:
+    std::mutex _lock;
+    std::mutex _ltl_lock;
+    size_t _workers;
+    size_t _shards;
+    size_t _max_markings;
+    std::shared_ptr<Structures::MarkingStore> _store;
+};
+
 bool recursiveSolve(const Condition_ptr& query, PetriNet* net,
                     CTLAlgorithmType algorithmtype,
-                    Strategy strategytype, bool partial_order, CTLResult& result, options_t& options);
+                    Strategy strategytype, bool partial_order, CTLResult& result, options_t& options,
+                    const std::shared_ptr<Structures::MarkingStore>& markings, CTLScheduler& scheduler);
 
 class SimpleResultHandler : public AbstractHandler
 {
@@ -143,7 +200,8 @@ class ResultHandler : public SimpleResultHandler {
 
 bool solveLogicalCondition(LogicalCondition* query, bool is_conj, PetriNet* net,
                            CTLAlgorithmType algorithmtype,
-                           Strategy strategytype, bool partial_order, CTLResult& result, options_t& options)
+                           Strategy strategytype, bool partial_order, CTLResult& result, options_t& options,
+                           const std::shared_ptr<Structures::MarkingStore>& markings, CTLScheduler& scheduler)
 {
     std::vector<int8_t> state(query->size(), 0);
     std::vector<int8_t> lstate;
@@ -164,6 +222,7 @@ bool solveLogicalCondition(LogicalCondition* query, bool is_conj, PetriNet* net,
         if(!options.tar)
         {
             ReachabilitySearch strategy(*net, handler, options.kbound, true);
+            strategy.setMarkingStore(markings);
             strategy.reachable(queries, res,
                                options.strategy,
                                options.stubbornreduction,
@@ -202,7 +261,7 @@ bool solveLogicalCondition(LogicalCondition* query, bool is_conj, PetriNet* net,
     for(size_t i = 0; i < query->size(); ++i) {
         if (state[i] == 0)
         {
-            if(recursiveSolve((*query)[i], net, algorithmtype, strategytype, partial_order, result, options) xor is_conj)
+            if(recursiveSolve((*query)[i], net, algorithmtype, strategytype, partial_order, result, options, markings, scheduler) xor is_conj)
             {
                 return !is_conj;
             }
@@ -213,31 +272,34 @@ bool solveLogicalCondition(LogicalCondition* query, bool is_conj, PetriNet* net,
 
 bool recursiveSolve(Condition* query, PetriEngine::PetriNet* net,
                     CTL::CTLAlgorithmType algorithmtype,
-                    Strategy strategytype, bool partial_order, CTLResult& result, options_t& options);
+                    Strategy strategytype, bool partial_order, CTLResult& result, options_t& options,
+                    const std::shared_ptr<Structures::MarkingStore>& markings, CTLScheduler& scheduler);
 
 bool recursiveSolve(const Condition_ptr& query, PetriEngine::PetriNet* net,
                     CTL::CTLAlgorithmType algorithmtype,
 
-                    Strategy strategytype, bool partial_order, CTLResult& result, options_t& options)
+                    Strategy strategytype, bool partial_order, CTLResult& result, options_t& options,
+                    const std::shared_ptr<Structures::MarkingStore>& markings, CTLScheduler& scheduler)
 {
-    return recursiveSolve(query.get(), net, algorithmtype, strategytype, partial_order, result, options);
+    return recursiveSolve(query.get(), net, algorithmtype, strategytype, partial_order, result, options, markings, scheduler);
 }
 
 bool recursiveSolve(Condition* query, PetriEngine::PetriNet* net,
                     CTL::CTLAlgorithmType algorithmtype,
-                    Strategy strategytype, bool partial_order, CTLResult& result, options_t& options)
+                    Strategy strategytype, bool partial_order, CTLResult& result, options_t& options,
+                    const std::shared_ptr<Structures::MarkingStore>& markings, CTLScheduler& scheduler)
 {
     if(auto q = dynamic_cast<NotCondition*>(query))
     {
-        return ! recursiveSolve((*q)[0], net, algorithmtype, strategytype, partial_order, result, options);
+        return ! recursiveSolve((*q)[0], net, algorithmtype, strategytype, partial_order, result, options, markings, scheduler);
     }
     else if(auto q = dynamic_cast<AndCondition*>(query))
     {
-        return solveLogicalCondition(q, true, net, algorithmtype, strategytype, partial_order, result, options);
+        return solveLogicalCondition(q, true, net, algorithmtype, strategytype, partial_order, result, options, markings, scheduler);
     }
     else if(auto q = dynamic_cast<OrCondition*>(query))
     {
-        return solveLogicalCondition(q, false, net, algorithmtype, strategytype, partial_order, result, options);
+        return solveLogicalCondition(q, false, net, algorithmtype, strategytype, partial_order, result, options, markings, scheduler);
     }
     else if(PetriEngine::PQL::isReachability(query))
     {
@@ -253,6 +315,7 @@ bool recursiveSolve(Condition* query, PetriEngine::PetriNet* net,
         else
         {
             ReachabilitySearch strategy(*net, handler, options.kbound, true);
+            strategy.setMarkingStore(markings);
             strategy.reachable(queries, res,
                                options.strategy,
                                options.stubbornreduction,
@@ -293,6 +356,7 @@ bool recursiveSolve(Condition* query, PetriEngine::PetriNet* net,
         }
         if(ok)
         {
+            auto turn = scheduler.ltlTurn();
             LTL::LTLSearch search(*net, q, options.buchiOptimization, options.ltl_compress_aps);
             auto r = search.solve(false, options.kbound, options.ltlalgorithm, options.ltl_por,
                             options.strategy, options.ltlHeuristic, options.ltluseweak, options.seed_offset);
@@ -305,11 +369,56 @@ bool recursiveSolve(Condition* query, PetriEngine::PetriNet* net,
     }
     //else
     {
-        return CTLSingleSolve(query, net, algorithmtype, strategytype, partial_order, result);
+        return CTLSingleSolve(query, net, algorithmtype, strategytype, partial_order, result, options.cores, markings);
     }
 }
 
 
+static CTLResult CTLSolveQuery(PetriNet* net,
+                               CTLAlgorithmType algorithmtype,
+                               Strategy strategytype,
+                               bool partial_order,
+                               const Condition_ptr& query,
+                               options_t& options,
+                               const std::shared_ptr<Structures::MarkingStore>& markings, CTLScheduler& scheduler)
+{
+    CTLResult result(query);
+    bool solved = false;
+
+    {
+        OnTheFlyDG graph(net, partial_order, 1, markings);
+        graph.setQuery(result.query);
+        switch (graph.initialEval()) {
+            case Condition::Result::RFALSE:
+                result.result = false;
+                solved = true;
+                break;
+            case Condition::Result::RTRUE:
+                result.result = true;
+                solved = true;
+                break;
+            default:
+                break;
+        }
+    }
+    result.numberOfConfigurations = 0;
+    result.numberOfMarkings = 0;
+    result.processedEdges = 0;
+    result.processedNegationEdges = 0;
+    result.exploredConfigurations = 0;
+    result.numberOfEdges = 0;
+    result.duration = 0;
+    result.maxTokens = 0;
+    if(!solved)
+    {
+        if(options.strategy == Strategy::BFS || options.strategy == Strategy::RDFS)
+            result.result = CTLSingleSolve(result.query, net, algorithmtype, options.strategy, options.stubbornreduction, result, options.cores, markings);
+        else
+            result.result = recursiveSolve(result.query, net, algorithmtype, strategytype, partial_order, result, options, markings, scheduler);
+    }
+    return result;
+}
+
 ReturnValue CTLMain(PetriNet* net,
                     CTLAlgorithmType algorithmtype,
                     Strategy strategytype,
@@ -321,43 +430,50 @@ ReturnValue CTLMain(PetriNet* net,
                     options_t& options
         )
 {
-    for(auto qnum : querynumbers){
-        CTLResult result(queries[qnum]);
-        bool solved = false;
+    const size_t nworkers = std::min<size_t>(options.cores, querynumbers.size());
+    // the dependency graphs and reachability searches of the queries encode their markings only once
+    CTLScheduler scheduler(*net, options, nworkers);
+    if(nworkers <= 1)
+    {
+        for(auto qnum : querynumbers){
+            auto result = CTLSolveQuery(net, algorithmtype, strategytype, partial_order, queries[qnum], options, scheduler.markings(), scheduler);
+            result.print(querynames[qnum], printstatistics, qnum, options, std::cout);
+        }
+        return ReturnValue::SuccessCode;
+    }
 
-        {
-            OnTheFlyDG graph(net, partial_order);
-            graph.setQuery(result.query);
-            switch (graph.initialEval()) {
-                case Condition::Result::RFALSE:
-                    result.result = false;
-                    solved = true;
-                    break;
-                case Condition::Result::RTRUE:
-                    result.result = true;
-                    solved = true;
-                    break;
-                default:
-                    break;
+    // the queries are independent and only read the net; solve them on a pool of
+    // workers, splitting the cores among them, and print each result in one go.
+    std::mutex print_lock;
+    std::atomic<size_t> next{0};
+    std::exception_ptr error = nullptr;
+    auto work = [&]() {
+        options_t local = options;
+        local.cores = std::max<uint32_t>(1, options.cores / nworkers);
+        try {
+            for(size_t i = next++; i < querynumbers.size(); i = next++)
+            {
+                auto qnum = querynumbers[i];
+                auto result = CTLSolveQuery(net, algorithmtype, strategytype, partial_order, queries[qnum], local, scheduler.markings(), scheduler);
+                std::stringstream ss;
+                result.print(querynames[qnum], printstatistics, qnum, options, ss);
+                std::lock_guard<std::mutex> guard(print_lock);
+                std::cout << ss.str() << std::flush;
             }
+        } catch (...) {
+            std::lock_guard<std::mutex> guard(print_lock);
+            if(error == nullptr)
+                error = std::current_exception();
+            next = querynumbers.size();
         }
-        result.numberOfConfigurations = 0;
-        result.numberOfMarkings = 0;
-        result.processedEdges = 0;
-        result.processedNegationEdges = 0;
-        result.exploredConfigurations = 0;
-        result.numberOfEdges = 0;
-        result.duration = 0;
-        result.maxTokens = 0;
-        if(!solved)
-        {
-            if(options.strategy == Strategy::BFS || options.strategy == Strategy::RDFS)
-                result.result = CTLSingleSolve(result.query, net, algorithmtype, options.strategy, options.stubbornreduction, result);
-            else
-                result.result = recursiveSolve(result.query, net, algorithmtype, strategytype, partial_order, result, options);
-        }
-        result.print(querynames[qnum], printstatistics, qnum, options, std::cout);
-    }
+    };
+
+    std::vector<std::thread> threads;
+    for(size_t i = 0; i < nworkers; ++i)
+        threads.emplace_back(work);
+    for(auto& t : threads)
+        t.join();
+    if(error != nullptr)
+        std::rethrow_exception(error);
     return ReturnValue::SuccessCode;
 }
-
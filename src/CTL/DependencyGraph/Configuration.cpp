@@ -10,15 +10,13 @@ namespace DependencyGraph {
 
         setDistance(std::max(sDist, tDist));
         auto it = dependency_set.begin();
-        auto pit = dependency_set.before_begin();
         while(it != dependency_set.end())
         {
             if(*it == e) return;
             if(*it > e) break;
-            pit = it;
             ++it;
         }
-        dependency_set.insert_after(pit, e);
+        dependency_set.insert(it, e);
         ++e->refcnt;
     }
 }
\ No newline at end of file
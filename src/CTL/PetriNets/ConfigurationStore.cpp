@@ -0,0 +1,127 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CTL/PetriNets/ConfigurationStore.h"
+
+#include <algorithm>
+#include <cassert>
+#include <new>
+
+using namespace DependencyGraph;
+
+namespace PetriNets {
+
+ConfigurationStore::ConfigurationStore(size_t workers, size_t shards,
+                                       std::shared_ptr<PetriEngine::Structures::MarkingStore> markings)
+: _workers(std::max<size_t>(workers, 1)),
+  _markings(markings ? std::move(markings) : std::make_shared<PetriEngine::Structures::MarkingStore>(shards)),
+  _shards(shards),
+  _edge_alloc(std::make_unique<linked_bucket_t<Edge,1024*10>>(_workers)),
+  _conf_alloc(std::make_unique<linked_bucket_t<char[sizeof(PetriConfig)], 1024*64>>(_workers))
+{
+    // a single shard is not locked, so only a single worker may use it
+    assert(_workers == 1 || (_shards.size() > 1 && _markings->shards() > 1));
+}
+
+ConfigurationStore::~ConfigurationStore()
+{
+    // every configuration is registered at its marking
+    for(size_t i = 0; i < _shards.size(); ++i)
+    {
+        for(auto& slot : _shards[i]._index)
+        {
+            if(slot._formula != EMPTY)
+                config(slot._config)->~PetriConfig();
+        }
+    }
+}
+
+ConfigurationStore::slot_t& ConfigurationStore::shard_t::find(size_t marking, uint32_t formula)
+{
+    const size_t mask = _index.size() - 1;
+    size_t h = (marking * 0x9E3779B97F4A7C15ULL) ^ (formula * 0xC2B2AE3D27D4EB4FULL);
+    for(size_t i = (h ^ (h >> 29)) & mask;; i = (i + 1) & mask)
+    {
+        auto& slot = _index[i];
+        if(slot._formula == EMPTY || (slot._marking == marking && slot._formula == formula))
+            return slot;
+    }
+}
+
+void ConfigurationStore::shard_t::grow()
+{
+    std::vector<slot_t> old(_index.size() * 2);
+    old.swap(_index);
+    for(auto& slot : old)
+    {
+        if(slot._formula != EMPTY)
+            find(slot._marking, slot._formula) = slot;
+    }
+}
+
+std::pair<bool, size_t> ConfigurationStore::insertMarking(const unsigned char* data, size_t size, size_t sum)
+{
+    auto id = _markings->insert(data, size).second;
+    bool fresh = _shards.apply(id % _shards.size(), [&](shard_t& shard) {
+        return shard._markings.insert(id).second;
+    });
+    if(fresh)
+    {
+        ++_markingCount;
+        size_t old = _maxTokens;
+        while(old < sum && !_maxTokens.compare_exchange_weak(old, sum)) {}
+    }
+    return std::make_pair(fresh, id);
+}
+
+void ConfigurationStore::unpackMarking(size_t id, unsigned char* destination)
+{
+    _markings->unpack(id, destination);
+}
+
+PetriConfig* ConfigurationStore::configuration(size_t marking, Condition* query, uint32_t owner, uint32_t worker)
+{
+    return _shards.apply(marking % _shards.size(), [&](shard_t& shard) {
+        auto formula = shard._formulas.try_emplace(query, shard._formulas.size()).first->second;
+        auto& slot = shard.find(marking, formula);
+        if(slot._formula != EMPTY)
+            return config(slot._config);
+
+        ++_configurationCount;
+        size_t id = _conf_alloc->next(worker);
+        assert(id < EMPTY);
+        char* mem = (*_conf_alloc)[id];
+        PetriConfig* newConfig = new (mem) PetriConfig();
+        newConfig->marking = marking;
+        newConfig->query = query;
+        newConfig->setOwner(owner);
+        slot._marking = marking;
+        slot._formula = formula;
+        slot._config = id;
+        if(++shard._used * 4 > shard._index.size() * 3)
+            shard.grow();
+        return newConfig;
+    });
+}
+
+Edge* ConfigurationStore::newEdge(uint32_t worker)
+{
+    size_t n = _edge_alloc->next(worker);
+    return &(*_edge_alloc)[n];
+}
+
+}
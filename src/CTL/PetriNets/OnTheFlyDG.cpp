@@ -19,28 +19,51 @@ using namespace DependencyGraph;
 
 namespace PetriNets {
 
-OnTheFlyDG::OnTheFlyDG(PetriEngine::PetriNet *t_net, bool partial_order) : encoder(t_net->numberOfPlaces(), 0),
-        edge_alloc(new linked_bucket_t<DependencyGraph::Edge,1024*10>(1)),
-        conf_alloc(new linked_bucket_t<char[sizeof(PetriConfig)], 1024*1024>(1)),
-        _redgen(*t_net, std::make_shared<PetriEngine::ReachabilityStubbornSet>(*t_net)), _partial_order(partial_order) {
+static std::shared_ptr<PetriEngine::ReachabilityStubbornSet> makeStubbornSet(PetriEngine::PetriNet *t_net, ConfigurationStore& store)
+{
+    auto stubset = std::make_shared<PetriEngine::ReachabilityStubbornSet>(*t_net);
+    if(store.workers() > 1)
+        stubset->setQueryLock(&store.queryLock());
+    return stubset;
+}
+
+OnTheFlyDG::OnTheFlyDG(PetriEngine::PetriNet *t_net, bool partial_order, uint32_t workers,
+                       std::shared_ptr<PetriEngine::Structures::MarkingStore> markings) : encoder(t_net->numberOfPlaces(), 0),
+        _store(std::make_shared<ConfigurationStore>(workers, workers > 1 ? workers * 64 : 1, std::move(markings))),
+        _gen(*t_net), _redgen(*t_net, makeStubbornSet(t_net, *_store)), _partial_order(partial_order) {
+    // the markings are expanded in a depth-first manner, mostly close to the previous one
+    _gen.setIncremental(true);
+    _redgen.setIncremental(true);
     net = t_net;
     n_places = t_net->numberOfPlaces();
     n_transitions = t_net->numberOfTransitions();
 }
 
+OnTheFlyDG::OnTheFlyDG(const OnTheFlyDG& other, uint32_t worker) : encoder(other.net->numberOfPlaces(), 0),
+        _store(other._store), _worker(worker),
+        _gen(*other.net), _redgen(*other.net, makeStubbornSet(other.net, *other._store)), _partial_order(other._partial_order) {
+    assert(worker < _store->workers());
+    _gen.setIncremental(true);
+    _redgen.setIncremental(true);
+    net = other.net;
+    n_places = other.n_places;
+    n_transitions = other.n_transitions;
+    if(other.query != nullptr)
+        setQuery(other.query);
+}
+
 
 OnTheFlyDG::~OnTheFlyDG()
 {
     cleanUp();
-    //Note: initial marking is in the markings set, therefore it will be deleted by the for loop
-    //TODO: Ensure we don't leak memory here, when code moving is done
-    size_t s = conf_alloc->size();
-    for(size_t i = 0; i < s; ++i)
-    {
-        ((PetriConfig*)&(*conf_alloc)[i])->~PetriConfig();
-    }
-    delete conf_alloc;
-    delete edge_alloc;
+    // configurations and edges are owned by the (possibly shared) store
+}
+
+std::unique_ptr<BasicDependencyGraph> OnTheFlyDG::workerGraph(uint32_t worker)
+{
+    if(worker >= _store->workers())
+        return nullptr;
+    return std::make_unique<OnTheFlyDG>(*this, worker);
 }
 
 Condition::Result OnTheFlyDG::initialEval()
@@ -53,17 +76,20 @@ Condition::Result OnTheFlyDG::initialEval()
 Condition::Result OnTheFlyDG::fastEval(Condition* query, Marking* unfolded)
 {
     EvaluationContext e(unfolded->marking(), net);
-    return PetriEngine::PQL::evaluate(query, e);
+    auto it = _compiled.find(query);
+    if(it == _compiled.end())
+        it = _compiled.emplace(query, PetriEngine::PQL::CompiledCondition(query)).first;
+    return PetriEngine::PQL::evaluate(it->second, query, e);
 }
 
-std::vector<DependencyGraph::Edge*> OnTheFlyDG::successors(Configuration *c)
+void OnTheFlyDG::successors(Configuration *c, std::vector<Edge*>& succs)
 {
     PetriEngine::PQL::DistanceContext context(net, query_marking.marking());
     PetriConfig *v = static_cast<PetriConfig*>(c);
-    trie.unpack(v->marking, encoder.scratchpad().raw());
+    _store->unpackMarking(v->marking, encoder.scratchpad().raw());
     encoder.decode(query_marking.marking(), encoder.scratchpad().raw());
     //    v->printConfiguration();
-    std::vector<Edge*> succs;
+    succs.clear();
     auto query_type = v->query->getQueryType();
     if(query_type == EVAL){
         assert(false);
@@ -96,7 +122,7 @@ std::vector<DependencyGraph::Edge*> OnTheFlyDG::successors(Configuration *c)
                 auto res = fastEval(c.get(), &query_marking);
                 if(res == Condition::RFALSE)
                 {
-                    return succs;
+                    return;
                 }
                 if(res == Condition::RUNKNOWN)
                 {
@@ -132,7 +158,7 @@ std::vector<DependencyGraph::Edge*> OnTheFlyDG::successors(Configuration *c)
                 if(res == Condition::RTRUE)
                 {
                     succs.push_back(newEdge(*v, 0));
-                    return succs;
+                    return;
                 }
                 if(res == Condition::RUNKNOWN)
                 {
@@ -169,7 +195,7 @@ std::vector<DependencyGraph::Edge*> OnTheFlyDG::successors(Configuration *c)
                     //right side is not temporal, eval it right now!
                     if (r1 == Condition::RTRUE) {    //satisfied, no need to go through successors
                         succs.push_back(newEdge(*v, 0));
-                        return succs;
+                        return;
                     }//else: It's not valid, no need to add any edge, just add successors
                 }
                 else {
@@ -244,7 +270,7 @@ std::vector<DependencyGraph::Edge*> OnTheFlyDG::successors(Configuration *c)
                     bool valid = r == Condition::RTRUE;
                     if (valid) {
                         succs.push_back(newEdge(*v, 0));
-                        return succs;
+                        return;
                     }
                 } else {
                     subquery = newEdge(*v, /*cond->distance(context)*/0);
@@ -347,7 +373,7 @@ std::vector<DependencyGraph::Edge*> OnTheFlyDG::successors(Configuration *c)
                     bool valid = r1 == Condition::RTRUE;
                     if (valid) {
                         succs.push_back(newEdge(*v, 0));
-                        return succs;
+                        return;
                     }   // else: right condition is not satisfied, no need to add an edge
                 }
 
@@ -421,7 +447,7 @@ std::vector<DependencyGraph::Edge*> OnTheFlyDG::successors(Configuration *c)
                     bool valid = r == Condition::RTRUE;
                     if (valid) {
                         succs.push_back(newEdge(*v, 0));
-                        return succs;
+                        return;
                     }
                 } else {
                     Configuration* c = createConfiguration(v->marking, v->getOwner(), (*cond)[0]);
@@ -510,7 +536,6 @@ std::vector<DependencyGraph::Edge*> OnTheFlyDG::successors(Configuration *c)
     {
         ((PetriConfig*)succs[0]->targets[0])->setOwner(v->getOwner());
     }*/
-    return succs;
 }
 
 Configuration* OnTheFlyDG::initialConfiguration()
@@ -536,8 +561,7 @@ void OnTheFlyDG::nextStates(Marking& t_marking, Condition* ptr,
     auto qf = static_cast<QuantifierCondition*>(ptr);
     if(!_partial_order || ptr->getQuantifier() != E || ptr->getPath() != F || PetriEngine::PQL::isTemporal((*qf)[0]))
     {
-        PetriEngine::SuccessorGenerator PNGen(*net);
-        dowork<PetriEngine::SuccessorGenerator>(PNGen, first, pre, foreach);
+        dowork<PetriEngine::SuccessorGenerator>(_gen, first, pre, foreach);
     }
     else
     {
@@ -562,6 +586,7 @@ void OnTheFlyDG::cleanUp()
 void OnTheFlyDG::setQuery(Condition* query)
 {
     this->query = query;
+    _compiled.clear();
     delete[] working_marking.marking();
     delete[] query_marking.marking();
     working_marking.setMarking(nullptr);
@@ -572,35 +597,21 @@ void OnTheFlyDG::setQuery(Condition* query)
 
 size_t OnTheFlyDG::configurationCount() const
 {
-    return _configurationCount;
+    return _store->configurationCount();
 }
 
 size_t OnTheFlyDG::markingCount() const
 {
-    return _markingCount;
+    return _store->markingCount();
 }
 
 size_t OnTheFlyDG::maxTokens() const {
-    return _maxTokens;
+    return _store->maxTokens();
 }
 
 PetriConfig *OnTheFlyDG::createConfiguration(size_t marking, size_t own, Condition* t_query)
 {
-    auto& configs = trie.get_data(marking);
-    for(PetriConfig* c : configs){
-        if(c->query == t_query)
-            return c;
-    }
-
-    _configurationCount++;
-    size_t id = conf_alloc->next(0);
-    char* mem = (*conf_alloc)[id];
-    PetriConfig* newConfig = new (mem) PetriConfig();
-    newConfig->marking = marking;
-    newConfig->query = t_query;
-    newConfig->setOwner(own);
-    configs.push_back(newConfig);
-    return newConfig;
+    return _store->configuration(marking, t_query, own, _worker);
 }
 
 
@@ -615,13 +626,7 @@ size_t OnTheFlyDG::createMarking(Marking& t_marking){
     unsigned char type = encoder.getType(sum, active, allsame, val);
     size_t length = encoder.encode(t_marking.marking(), type);
     binarywrapper_t w = binarywrapper_t(encoder.scratchpad().raw(), length*8);
-    auto tit = trie.insert(w.raw(), w.size());
-    if(tit.first){
-        _markingCount++;
-        _maxTokens = std::max(sum, _maxTokens);
-    }
-
-    return tit.second;
+    return _store->insertMarking(w.raw(), w.size(), sum).second;
 }
 
 void OnTheFlyDG::release(Edge* e)
@@ -637,8 +642,8 @@ void OnTheFlyDG::release(Edge* e)
 }
 
 size_t OnTheFlyDG::owner(Marking& marking, Condition* cond) {
-    // Used for distributed algorithm
-    return 0;
+    // configurations are owned by the worker discovering them
+    return _worker;
 }
 
 
@@ -647,8 +652,7 @@ Edge* OnTheFlyDG::newEdge(Configuration &t_source, uint32_t weight)
     Edge* e = nullptr;
     if(recycle.empty())
     {
-        size_t n = edge_alloc->next(0);
-        e = &(*edge_alloc)[n];
+        e = _store->newEdge(_worker);
     }
     else
     {
@@ -29,6 +29,7 @@ namespace LTL {
             if(_hyper_traces > 1)
                 throw base_error("Hyper-LTL with heuristics or partial order reduction not yet enabled.");
             SpoolingSuccessorGenerator gen(_net, _formula);
+            gen.setIncremental(true);
             EnabledSpooler spooler(_net, gen);
             gen.set_spooler(spooler);
             gen.set_heuristic(_heuristic);
@@ -37,6 +38,7 @@ namespace LTL {
             if(_hyper_traces <= 1)
             {
                 ResumingSuccessorGenerator gen(_net);
+                gen.setIncremental(true);
                 return check_with_generator(gen);
             }
             else
@@ -49,27 +51,44 @@ namespace LTL {
 
     template<typename G>
     bool NestedDepthFirstSearch::check_with_generator(G& gen) {
+        // Spot and BuDDy are not thread-safe, so the workers of a parallel search
+        // build and release the Büchi side of the product under the query lock.
+        auto guard = lock_query();
         ProductSuccessorGenerator prod_gen(_net, _buchi, gen);
+        if (guard.owns_lock())
+            guard.unlock();
         if constexpr (std::is_same<G,CompoundGenerator>::value) {
             LTL::Structures::CompoundStateSet<ptrie::map<Structures::stateid_t, uint8_t>> states(_net, _hyper_traces, _kbound);
             dfs(prod_gen, states);
-            _discovered = states.discovered();
-            _max_tokens = states.max_tokens();
-            _configurations = states.configurations();
-            _markings = states.markings();
+            collect_stats(states);
         }
         else
         {
-            LTL::Structures::BitProductStateSet<ptrie::map<Structures::stateid_t, uint8_t>> states(_net, _kbound);
-            dfs(prod_gen, states);
-            _discovered = states.discovered();
-            _max_tokens = states.max_tokens();
-            _configurations = states.configurations();
-            _markings = states.markings();
+            if (_shared_markings != nullptr) {
+                LTL::Structures::BitProductStateSet<ptrie::map<Structures::stateid_t, uint8_t>, 20,
+                    PetriEngine::Structures::SharedStateSet::View> states(*_shared_markings, _net, _kbound);
+                dfs(prod_gen, states);
+                collect_stats(states);
+            } else {
+                LTL::Structures::BitProductStateSet<ptrie::map<Structures::stateid_t, uint8_t>> states(_net, _kbound);
+                dfs(prod_gen, states);
+                collect_stats(states);
+            }
         }
+        if (guard.mutex() != nullptr)
+            guard.lock();
         return !_violation;
     }
 
+    template<typename S>
+    void NestedDepthFirstSearch::collect_stats(S& states)
+    {
+        _discovered = states.discovered();
+        _max_tokens = states.max_tokens();
+        _configurations = states.configurations();
+        _markings = states.markings();
+    }
+
     template<typename S>
     std::pair<bool,size_t> NestedDepthFirstSearch::mark(S& states, State& state, const uint8_t MARKER)
     {
@@ -99,7 +118,7 @@ namespace LTL {
             auto res = states.add(state);
             if (std::get<0>(res)) {
                 dfs(successor_generator, states, std::get<1>(res));
-                if(_violation)
+                if(_violation || stopped())
                     break;
             }
         }
@@ -116,7 +135,7 @@ namespace LTL {
 
         todo.push_back(stack_entry_t<T>{init, successor_generator.initial_suc_info()});
 
-        while (!todo.empty()) {
+        while (!todo.empty() && !stopped()) {
             auto &top = todo.back();
             states.decode(curState, top._id);
             successor_generator.prepare(&curState, top._sucinfo);
@@ -168,7 +187,7 @@ namespace LTL {
 
         nested_todo.push_back(stack_entry_t<T>{std::get<1>(states.add(state)), successor_generator.initial_suc_info()});
 
-        while (!nested_todo.empty()) {
+        while (!nested_todo.empty() && !stopped()) {
             auto &top = nested_todo.back();
             states.decode(curState, top._id);
             successor_generator.prepare(&curState, top._sucinfo);
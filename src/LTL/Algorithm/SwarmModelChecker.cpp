@@ -0,0 +1,129 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LTL/Algorithm/SwarmModelChecker.h"
+#include "LTL/SuccessorGeneration/RandomHeuristic.h"
+
+#include <exception>
+#include <thread>
+
+namespace LTL {
+
+    SwarmModelChecker::SwarmModelChecker(const PetriEngine::PetriNet& net,
+                                         const PetriEngine::PQL::Condition_ptr &condition,
+                                         const Structures::BuchiAutomaton &buchi,
+                                         uint32_t cores, uint64_t seed, const factory_t& factory)
+    : ModelChecker(net, condition, buchi), _markings(cores * 64)
+    {
+        for (uint32_t i = 0; i < cores; ++i) {
+            _workers.emplace_back(factory());
+            // the first worker follows the configured search order
+            if (i > 0)
+                _heuristics.emplace_back(std::make_unique<RandomHeuristic>(seed == 0 ? 0 : seed + i));
+        }
+    }
+
+    void SwarmModelChecker::set_partial_order(LTLPartialOrder order)
+    {
+        for (auto& w : _workers)
+            w->set_partial_order(order);
+    }
+
+    LTLPartialOrder SwarmModelChecker::used_partial_order() const
+    {
+        return _workers[0]->used_partial_order();
+    }
+
+    bool SwarmModelChecker::check()
+    {
+        _done = false;
+        for (size_t i = 0; i < _workers.size(); ++i) {
+            auto& worker = *_workers[i];
+            worker.set_tracing(_build_trace);
+            worker.set_utilize_weak(_shortcircuitweak);
+            worker.set_heuristic(i == 0 ? _heuristic : _heuristics[i - 1].get());
+            worker.set_worker(_markings, _lock, _done);
+        }
+
+        bool result = true;
+        std::exception_ptr error = nullptr;
+        std::mutex error_lock;
+        auto work = [&](size_t id) {
+            try {
+                auto r = _workers[id]->check();
+                // a worker which was stopped returns an arbitrary answer; only the first to finish counts.
+                if (!_done.exchange(true)) {
+                    _winner = id;
+                    result = r;
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> guard(error_lock);
+                if (error == nullptr)
+                    error = std::current_exception();
+                _done = true;
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < _workers.size(); ++i)
+            threads.emplace_back(work, i);
+        for (auto& t : threads)
+            t.join();
+        if (error != nullptr)
+            std::rethrow_exception(error);
+
+        // the counter-example is the one of the deciding worker
+        _trace = _workers[_winner]->trace();
+        _loop = _workers[_winner]->loop_index();
+        _violation = !result;
+
+        _explored = _expanded = _discovered = _configurations = _max_tokens = 0;
+        for (auto& w : _workers) {
+            _explored += w->get_explored();
+            _expanded += w->get_expanded();
+            _discovered += w->get_discovered();
+            _configurations += w->get_configurations();
+            _max_tokens = std::max(_max_tokens, w->max_tokens());
+        }
+        return result;
+    }
+
+    void SwarmModelChecker::print_stats(std::ostream &os) const
+    {
+        ModelChecker::print_stats(os, _discovered, _max_tokens);
+    }
+
+    size_t SwarmModelChecker::max_tokens() const
+    {
+        return _max_tokens;
+    }
+
+    size_t SwarmModelChecker::get_discovered() const
+    {
+        return _discovered;
+    }
+
+    size_t SwarmModelChecker::get_markings() const
+    {
+        return _markings.size();
+    }
+
+    size_t SwarmModelChecker::get_configurations() const
+    {
+        return _configurations;
+    }
+}
@@ -56,11 +56,16 @@ namespace LTL {
     }
 
     bool TarjanModelChecker::check() {
+        // Spot and BuDDy are not thread-safe, so the workers of a parallel search
+        // build and release the Büchi side of the product under the query lock.
+        auto guard = lock_query();
+        bool res;
         if(_heuristic != nullptr || _order != LTLPartialOrder::None)
         {
             // we need advanced successor generator pipeline (we need to look at successors)
             std::unique_ptr<SuccessorSpooler> spooler;
             SpoolingSuccessorGenerator gen{_net, _formula};
+            gen.setIncremental(true);
             if (_order == LTLPartialOrder::Visible) {
                 spooler = std::make_unique<VisibleLTLStubbornSet>(_net, _formula);
             } else if (_order == LTLPartialOrder::Liebke) {
@@ -68,6 +73,7 @@ namespace LTL {
             } else {
                 spooler = std::make_unique<EnabledSpooler>(_net, gen);
             }
+            spooler->set_query_lock(_query_lock);
 
             gen.set_spooler(*spooler);
 
@@ -77,41 +83,63 @@ namespace LTL {
             if(_order == LTLPartialOrder::Automaton)
             {
                 ReachStubProductSuccessorGenerator succ_gen(_net, _buchi, gen, std::make_unique<EnabledSpooler>(_net, gen));
-                return select_trace_compute(succ_gen);
+                succ_gen.set_query_lock(_query_lock);
+                res = select_trace_compute(succ_gen, guard);
             }
             else {
                 ProductSuccessorGenerator succ_gen(_net, _buchi, gen);
-                return select_trace_compute(succ_gen);
+                res = select_trace_compute(succ_gen, guard);
             }
         }
         else
         {
             ResumingSuccessorGenerator gen{_net};
+            // the search resumes the states on the stack, which stay close to each other
+            gen.setIncremental(true);
             ProductSuccessorGenerator succ_gen(_net, _buchi, gen);
-            return select_trace_compute(succ_gen);
+            res = select_trace_compute(succ_gen, guard);
         }
+        return res;
     }
 
     template<typename SuccGen>
-    bool TarjanModelChecker::select_trace_compute(SuccGen& successorGenerator)
+    bool TarjanModelChecker::select_trace_compute(SuccGen& successorGenerator, std::unique_lock<std::mutex>& guard)
     {
-        return _build_trace ?
-            compute<true, SuccGen>(successorGenerator) :
-            compute<false, SuccGen>(successorGenerator);
+        if (guard.owns_lock())
+            guard.unlock();
+        bool res;
+        if (_shared_markings != nullptr) {
+            using View = PetriEngine::Structures::SharedStateSet::View;
+            if (_build_trace) {
+                LTL::Structures::TraceableBitProductStateSet<20, View> seen(*_shared_markings, _net, _k_bound);
+                res = compute<true>(successorGenerator, seen);
+            } else {
+                LTL::Structures::BitProductStateSet<ptrie::set<Structures::stateid_t,17,32,8>, 20, View> seen(*_shared_markings, _net, _k_bound);
+                res = compute<false>(successorGenerator, seen);
+            }
+        } else {
+            if (_build_trace) {
+                LTL::Structures::TraceableBitProductStateSet<> seen(_net, _k_bound);
+                res = compute<true>(successorGenerator, seen);
+            } else {
+                LTL::Structures::BitProductStateSet<> seen(_net, _k_bound);
+                res = compute<false>(successorGenerator, seen);
+            }
+        }
+        // the generators are destructed by the caller, again under the lock.
+        if (guard.mutex() != nullptr)
+            guard.lock();
+        return res;
     }
 
 
-    template<bool SaveTrace, typename SuccGen>
-    bool TarjanModelChecker::compute(SuccGen& successorGenerator)
+    template<bool SaveTrace, typename StateSet, typename SuccGen>
+    bool TarjanModelChecker::compute(SuccGen& successorGenerator, StateSet& seen)
     {
-
-        using StateSet = std::conditional_t<SaveTrace, LTL::Structures::TraceableBitProductStateSet<>,
-                LTL::Structures::BitProductStateSet<>>;
         using centry_t = std::conditional_t<SaveTrace,
                 tracable_centry_t,
                 plain_centry_t>;
 
-        StateSet seen(_net, _k_bound);
         // master list of state information.
         light_deque<centry_t> cstack;
         // depth-first search stack, contains current search path.
@@ -121,12 +149,12 @@ namespace LTL {
         State working = _factory.new_state();
         State parent = _factory.new_state();
         for (auto &state : initial_states) {
-            if(_violation) break;
+            if(_violation || stopped()) break;
             const auto res = seen.add(state);
             if (std::get<0>(res)) {
                 push(seen, cstack, dstack, successorGenerator, state, std::get<1>(res));
             }
-            while (!dstack.empty() && !_violation) {
+            while (!dstack.empty() && !_violation && !stopped()) {
                 auto &dtop = dstack.back();
                 // write next successor state to working.
                 if (!next_trans(seen, cstack, successorGenerator, working, parent, dtop)) {
@@ -23,6 +23,7 @@
 #include "LTL/SuccessorGeneration/SpoolingSuccessorGenerator.h"
 #include "LTL/Algorithm/NestedDepthFirstSearch.h"
 #include "LTL/Algorithm/TarjanModelChecker.h"
+#include "LTL/Algorithm/SwarmModelChecker.h"
 
 #include "PetriEngine/PQL/PredicateCheckers.h"
 #include "PetriEngine/PQL/PQL.h"
@@ -226,24 +227,30 @@ namespace LTL {
                             const Strategy search_strategy,
                             const LTLHeuristic heuristics_flag,
                             const bool utilize_weak,
-                            const uint64_t seed) {
+                            const uint64_t seed,
+                            const uint32_t cores) {
 
         _heuristic = make_heuristic(_net, _negated_formula, _buchi, search_strategy, heuristics_flag, seed);
 
-        switch (algorithm) {
-            case Algorithm::NDFS:
-            {
-                _checker = std::make_unique<NestedDepthFirstSearch>(_net, _negated_formula, _buchi, k_bound, _traces.size());
-                break;
+        auto make_checker = [&]() -> std::unique_ptr<ModelChecker> {
+            switch (algorithm) {
+                case Algorithm::NDFS:
+                    return std::make_unique<NestedDepthFirstSearch>(_net, _negated_formula, _buchi, k_bound, _traces.size());
+                case Algorithm::Tarjan:
+                    return std::make_unique<TarjanModelChecker>(_net, _negated_formula, _buchi, k_bound, _traces.size());
+                case Algorithm::None:
+                default:
+                    assert(false);
+                    throw base_error("Cannot LTL verify with algorithm None");
             }
-            case Algorithm::Tarjan:
-                _checker = std::make_unique<TarjanModelChecker>(_net, _negated_formula, _buchi, k_bound, _traces.size());
-                break;
-            case Algorithm::None:
-            default:
-                assert(false);
-                std::cerr << "Error: cannot LTL verify with algorithm None";
-        }
+        };
+
+        // upper-bounds are recorded inside the formula and hyper-traces need
+        // the compound successor generator; leave these to a single worker.
+        if (cores > 1 && _traces.size() <= 1 && !containsUpperBounds(_negated_formula))
+            _checker = std::make_unique<SwarmModelChecker>(_net, _negated_formula, _buchi, cores, seed, make_checker);
+        else
+            _checker = make_checker();
         _checker->set_utilize_weak(utilize_weak);
         _checker->set_heuristic(_heuristic.get());
         _checker->set_partial_order(por);
@@ -158,7 +158,13 @@ namespace LTL {
         }
 
 
-        guard_info_t buchi_state = _state_guards[state->get_buchi_state()];
+        // the guards share their atomic propositions with the other workers of a parallel search,
+        // and evaluate-and-set below annotates them.
+        std::unique_lock<std::mutex> guard;
+        if (_query_lock != nullptr)
+            guard = std::unique_lock<std::mutex>(*_query_lock);
+
+        const guard_info_t& buchi_state = _state_guards[state->get_buchi_state()];
 
         PQL::EvaluationContext evaluationContext{_parent->marking(), &_net};
 
@@ -37,6 +37,10 @@ namespace LTL {
             return true;
         }
 
+        std::unique_lock<std::mutex> guard;
+        if (_query_lock != nullptr)
+            guard = std::unique_lock<std::mutex>(*_query_lock);
+
         InterestingLTLTransitionVisitor unsafe{*this, false};
         InterestingTransitionVisitor interesting{*this, false};
 
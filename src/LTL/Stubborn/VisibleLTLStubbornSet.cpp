@@ -33,6 +33,9 @@ namespace LTL {
             _stubborn[_ordering.front()] = true;
             return true;
         }
+        std::unique_lock<std::mutex> guard;
+        if (_query_lock != nullptr)
+            guard = std::unique_lock<std::mutex>(*_query_lock);
         //TODO needed? We do not run Interesting visitor so we do not immediately need it, but is is needed by closure?
         for (auto &q : _queries) {
             LTLEvalAndSetVisitor evalAndSetVisitor{evaluationContext};
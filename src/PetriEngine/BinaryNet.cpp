@@ -0,0 +1,295 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PetriEngine/BinaryNet.h"
+#include "utils/MappedFile.h"
+#include "utils/errors.h"
+
+#include <cstring>
+#include <iomanip>
+#include <memory>
+
+namespace PetriEngine {
+
+    static constexpr char MAGIC[8] = {'V', 'P', 'N', 'B', 'I', 'N', 'E', 'T'};
+    static constexpr uint32_t ENDIAN_MARK = 0x01020304;
+    static constexpr uint32_t COLORED = 1;
+
+    class ImageWriter {
+    public:
+        explicit ImageWriter(std::ostream& out) : _out(out) {}
+
+        void bytes(const void* data, size_t size) {
+            _out.write(static_cast<const char*>(data), size);
+            _pos += size;
+        }
+
+        template<typename T>
+        void value(T v) { bytes(&v, sizeof(T)); }
+
+        void string(const std::string& s) {
+            value<uint32_t>(s.size());
+            bytes(s.data(), s.size());
+        }
+
+        /** Pads to the next multiple of 8, so the arrays can be read in place */
+        void align() {
+            static const char zeros[8] = {};
+            if (_pos % 8 != 0)
+                bytes(zeros, 8 - _pos % 8);
+        }
+
+    private:
+        std::ostream& _out;
+        size_t _pos = 0;
+    };
+
+    class ImageReader {
+    public:
+        ImageReader(const char* data, size_t size, const std::string& file)
+        : _data(data), _size(size), _file(file) {}
+
+        const char* bytes(size_t size) {
+            if (size > _size - _pos)
+                throw base_error("Binary net ", std::quoted(_file), " is truncated");
+            auto data = _data + _pos;
+            _pos += size;
+            return data;
+        }
+
+        template<typename T>
+        T value() {
+            T v;
+            memcpy(&v, bytes(sizeof(T)), sizeof(T));
+            return v;
+        }
+
+        template<typename T>
+        const T* array(size_t n) {
+            align();
+            return reinterpret_cast<const T*>(bytes(n * sizeof(T)));
+        }
+
+        std::string string() {
+            auto size = value<uint32_t>();
+            return std::string(bytes(size), size);
+        }
+
+        void align() {
+            if (_pos % 8 != 0)
+                bytes(8 - _pos % 8);
+        }
+
+    private:
+        const char* _data;
+        size_t _size;
+        size_t _pos = 0;
+        const std::string& _file;
+    };
+
+    // the arcs as stored in the image
+    struct image_arc_t {
+        uint32_t place;
+        uint32_t tokens;
+        uint32_t inhibitor;
+    };
+
+    void BinaryNet::write(std::ostream& out, const PetriNetBuilder& builder, bool colored,
+                          const shared_name_name_map& transition_names,
+                          const shared_place_color_map& place_names)
+    {
+        PetriNetBuilder copy(builder);
+        std::unique_ptr<PetriNet> net{copy.makePetriNet(false)};
+        const uint32_t nplaces = net->_nplaces;
+        const uint32_t ntrans = net->_ntransitions;
+
+        ImageWriter image(out);
+        image.bytes(MAGIC, sizeof(MAGIC));
+        image.value<uint32_t>(VERSION);
+        image.value<uint32_t>(ENDIAN_MARK);
+        image.value<uint32_t>(colored ? COLORED : 0);
+        image.value<uint32_t>(nplaces);
+        image.value<uint32_t>(ntrans);
+        image.value<uint32_t>(net->_ninvariants);
+
+        image.align();
+        image.bytes(net->_transitions.data(), (ntrans + 1) * sizeof(TransPtr));
+        image.align();
+        for (auto& inv : net->_invariants)
+            image.value(image_arc_t{inv.place, inv.tokens, inv.inhibitor});
+        image.align();
+        image.bytes(net->_initialMarking, nplaces * sizeof(MarkVal));
+        image.align();
+        for (uint32_t t = 0; t < ntrans; ++t)
+            image.value<uint8_t>(net->_controllable[t]);
+        image.align();
+        for (uint32_t p = 0; p < nplaces; ++p) {
+            image.value(std::get<0>(net->_placelocations[p]));
+            image.value(std::get<1>(net->_placelocations[p]));
+        }
+        for (uint32_t t = 0; t < ntrans; ++t) {
+            image.value(std::get<0>(net->_transitionlocations[t]));
+            image.value(std::get<1>(net->_transitionlocations[t]));
+        }
+
+        for (uint32_t p = 0; p < nplaces; ++p)
+            image.string(*net->_placenames[p]);
+        for (uint32_t t = 0; t < ntrans; ++t)
+            image.string(*net->_transitionnames[t]);
+
+        image.value<uint32_t>(transition_names.size());
+        for (auto& [name, unfolded] : transition_names) {
+            image.string(*name);
+            image.value<uint32_t>(unfolded.size());
+            for (auto& u : unfolded)
+                image.string(*u);
+        }
+        image.value<uint32_t>(place_names.size());
+        for (auto& [name, unfolded] : place_names) {
+            image.string(*name);
+            image.value<uint32_t>(unfolded.size());
+            for (auto& [color, u] : unfolded) {
+                image.value<uint32_t>(color);
+                image.string(*u);
+            }
+        }
+
+        // what the reducer needs to reconstruct traces
+        const Reducer& reducer = builder.reducer;
+        image.value<uint64_t>(reducer._tnameid);
+        image.value<uint32_t>(reducer._initfire.size());
+        for (auto& t : reducer._initfire)
+            image.string(*t);
+        image.value<uint32_t>(reducer._postfire.size());
+        for (auto& [t, fired] : reducer._postfire) {
+            image.string(t);
+            image.value<uint32_t>(fired.size());
+            for (auto& f : fired)
+                image.string(*f);
+        }
+        image.value<uint32_t>(reducer._transitionsBeforeReduction.size());
+        for (auto& [t, arcs] : reducer._transitionsBeforeReduction) {
+            image.string(t);
+            image.value<uint32_t>(arcs.size());
+            for (auto& arc : arcs) {
+                image.string(*arc.place);
+                image.value<uint64_t>(arc.weight);
+            }
+        }
+    }
+
+    bool BinaryNet::read(const std::string& file, PetriNetBuilder& builder,
+                         shared_name_name_map& transition_names,
+                         shared_place_color_map& place_names)
+    {
+        MappedFile mapped(file);
+        if (!mapped.is_open())
+            throw base_error("Binary net ", std::quoted(file), " could not be opened");
+        ImageReader image(mapped.data(), mapped.size(), file);
+        if (memcmp(image.bytes(sizeof(MAGIC)), MAGIC, sizeof(MAGIC)) != 0)
+            throw base_error("File ", std::quoted(file), " is not a binary net");
+        auto version = image.value<uint32_t>();
+        if (version != VERSION)
+            throw base_error("Binary net ", std::quoted(file), " has version ", version, ", expected ", VERSION);
+        if (image.value<uint32_t>() != ENDIAN_MARK)
+            throw base_error("Binary net ", std::quoted(file), " was written on a machine with another byte order");
+        const bool colored = (image.value<uint32_t>() & COLORED) != 0;
+        const uint32_t nplaces = image.value<uint32_t>();
+        const uint32_t ntrans = image.value<uint32_t>();
+        const uint32_t ninvariants = image.value<uint32_t>();
+
+        auto transitions = image.array<TransPtr>(ntrans + 1);
+        auto invariants = image.array<image_arc_t>(ninvariants);
+        auto initial = image.array<MarkVal>(nplaces);
+        auto controllable = image.array<uint8_t>(ntrans);
+        auto locations = image.array<double>(2 * (nplaces + ntrans));
+        if (transitions[ntrans].inputs != ninvariants)
+            throw base_error("Binary net ", std::quoted(file), " is corrupt");
+
+        auto& strings = builder._string_set;
+        auto name = [&]() {
+            return *strings.insert(std::make_shared<const_string>(image.string())).first;
+        };
+
+        for (uint32_t p = 0; p < nplaces; ++p)
+            builder.addPlace(name(), initial[p], locations[2 * p], locations[2 * p + 1]);
+        for (uint32_t t = 0; t < ntrans; ++t) {
+            auto location = locations + 2 * (nplaces + t);
+            builder.addTransition(name(), controllable[t] ? 0 : 1, location[0], location[1]);
+        }
+        if (builder.numberOfPlaces() != nplaces || builder.numberOfTransitions() != ntrans)
+            throw base_error("Binary net ", std::quoted(file), " has duplicate names");
+
+        for (uint32_t t = 0; t < ntrans; ++t) {
+            Transition& trans = builder._transitions[t];
+            if (transitions[t].inputs > transitions[t].outputs ||
+                transitions[t].outputs > transitions[t + 1].inputs)
+                throw base_error("Binary net ", std::quoted(file), " is corrupt");
+            for (uint32_t i = transitions[t].inputs; i < transitions[t + 1].inputs; ++i) {
+                if (invariants[i].place >= nplaces)
+                    throw base_error("Binary net ", std::quoted(file), " is corrupt");
+                Arc arc;
+                arc.place = invariants[i].place;
+                arc.weight = invariants[i].tokens;
+                Place& place = builder._places[arc.place];
+                if (i < transitions[t].outputs) {
+                    arc.inhib = invariants[i].inhibitor != 0;
+                    trans.pre.push_back(arc);
+                    trans.inhib |= arc.inhib;
+                    place.consumers.push_back(t);
+                    place.inhib |= arc.inhib;
+                }
+                else {
+                    trans.post.push_back(arc);
+                    place.producers.push_back(t);
+                }
+            }
+        }
+        builder.sort();
+
+        for (uint32_t n = image.value<uint32_t>(); n > 0; --n) {
+            auto& unfolded = transition_names[name()];
+            for (uint32_t m = image.value<uint32_t>(); m > 0; --m)
+                unfolded.push_back(name());
+        }
+        for (uint32_t n = image.value<uint32_t>(); n > 0; --n) {
+            auto& unfolded = place_names[name()];
+            for (uint32_t m = image.value<uint32_t>(); m > 0; --m) {
+                auto color = image.value<uint32_t>();
+                unfolded[color] = name();
+            }
+        }
+
+        Reducer& reducer = builder.reducer;
+        reducer._tnameid = image.value<uint64_t>();
+        for (uint32_t n = image.value<uint32_t>(); n > 0; --n)
+            reducer._initfire.push_back(name());
+        for (uint32_t n = image.value<uint32_t>(); n > 0; --n) {
+            auto& fired = reducer._postfire[image.string()];
+            for (uint32_t m = image.value<uint32_t>(); m > 0; --m)
+                fired.push_back(name());
+        }
+        for (uint32_t n = image.value<uint32_t>(); n > 0; --n) {
+            auto& arcs = reducer._transitionsBeforeReduction[image.string()];
+            for (uint32_t m = image.value<uint32_t>(); m > 0; --m) {
+                auto place = name();
+                arcs.emplace_back(place, image.value<uint64_t>());
+            }
+        }
+        return colored;
+    }
+}
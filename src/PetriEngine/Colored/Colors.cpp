@@ -181,21 +181,25 @@ namespace PetriEngine {
         }
 
         const Color& ProductType::operator[](size_t index) const {
-            if (_cache.count(index) < 1) {
-                size_t mod = 1;
-                size_t div = 1;
-
-                std::vector<const Color*> colors;
-                for (auto & constituent : _constituents) {
-                    mod = constituent->size();
-                    colors.push_back(&(*constituent)[(index / div) % mod]);
-                    div *= mod;
-                }
-
-                _cache.emplace(index, Color(this, index, colors));
+            {
+                std::shared_lock lock(_cacheLock);
+                auto it = _cache.find(index);
+                if (it != _cache.end())
+                    return it->second;
+            }
+            size_t mod = 1;
+            size_t div = 1;
+
+            std::vector<const Color*> colors;
+            for (auto & constituent : _constituents) {
+                mod = constituent->size();
+                colors.push_back(&(*constituent)[(index / div) % mod]);
+                div *= mod;
             }
 
-            return _cache.at(index);
+            // the elements of an unordered_map stay in place when it grows
+            std::unique_lock lock(_cacheLock);
+            return _cache.try_emplace(index, this, index, colors).first->second;
         }
 
         const Color* ProductType::getColor(const std::vector<const Color*>& colors) const {
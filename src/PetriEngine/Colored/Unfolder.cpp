@@ -6,6 +6,13 @@
 
 #include "PetriEngine/Colored/BindingGenerator.h"
 
+#include <condition_variable>
+#include <set>
+#include <unordered_set>
+#include <exception>
+#include <mutex>
+#include <thread>
+
 namespace PetriEngine {
     namespace Colored {
 
@@ -54,13 +61,22 @@ namespace PetriEngine {
             return ignorantBuilder.getUnderlying();
         }
 
-        PetriNetBuilder Unfolder::unfold() {
+        PetriNetBuilder Unfolder::unfold(uint32_t threads, bool lazy) {
             PetriNetBuilder ptBuilder(_builder.string_set());
             if (_builder.isColored()) {
                 auto start = std::chrono::high_resolution_clock::now();
 
-                for (uint32_t transitionId = 0; transitionId < _builder.transitions().size(); transitionId++) {
-                    unfoldTransition(ptBuilder, transitionId);
+                if (lazy) {
+                    unfoldLazily(ptBuilder);
+                } else if (threads > 1 && _builder.transitions().size() > 1) {
+                    unfoldInParallel(ptBuilder, threads);
+                } else {
+                    std::vector<unfolded_transition_t> unfolded;
+                    for (uint32_t transitionId = 0; transitionId < _builder.transitions().size(); transitionId++) {
+                        unfolded.clear();
+                        evaluateTransition(transitionId, unfolded);
+                        addTransition(ptBuilder, transitionId, unfolded);
+                    }
                 }
 
                 const auto& unfoldedPlaceMap = ptBuilder.getPlaceNames();
@@ -75,6 +91,73 @@ namespace PetriEngine {
             return ptBuilder;
         }
 
+        void Unfolder::unfoldInParallel(PetriNetBuilder& ptBuilder, uint32_t threads) {
+            const uint32_t ntransitions = _builder.transitions().size();
+            // the workers stay at most this many transitions ahead of the builder
+            const uint32_t window = 4 * threads;
+            std::vector<std::vector<unfolded_transition_t>> unfolded(ntransitions);
+            std::vector<bool> evaluated(ntransitions, false);
+            uint32_t next = 0;
+            uint32_t added = 0;
+            std::exception_ptr error;
+            std::mutex lock;
+            std::condition_variable changed;
+
+            auto worker = [&]() {
+                while (true) {
+                    uint32_t transitionId;
+                    {
+                        std::unique_lock guard(lock);
+                        changed.wait(guard, [&] { return error || next >= ntransitions || next < added + window; });
+                        if (error || next >= ntransitions)
+                            return;
+                        transitionId = next++;
+                    }
+                    std::vector<unfolded_transition_t> result;
+                    try {
+                        evaluateTransition(transitionId, result);
+                    } catch (...) {
+                        std::lock_guard guard(lock);
+                        error = std::current_exception();
+                        changed.notify_all();
+                        return;
+                    }
+                    {
+                        std::lock_guard guard(lock);
+                        unfolded[transitionId] = std::move(result);
+                        evaluated[transitionId] = true;
+                    }
+                    changed.notify_all();
+                }
+            };
+
+            std::vector<std::thread> workers;
+            for (uint32_t i = 0; i < std::min(threads, ntransitions); ++i)
+                workers.emplace_back(worker);
+
+            while (added < ntransitions) {
+                std::vector<unfolded_transition_t> result;
+                {
+                    std::unique_lock guard(lock);
+                    changed.wait(guard, [&] { return error || evaluated[added]; });
+                    if (error)
+                        break;
+                    result = std::move(unfolded[added]);
+                }
+                addTransition(ptBuilder, added, result);
+                {
+                    std::lock_guard guard(lock);
+                    ++added;
+                }
+                changed.notify_all();
+            }
+
+            for (auto& w : workers)
+                w.join();
+            if (error)
+                std::rethrow_exception(error);
+        }
+
         //Due to the way we unfold places, we only unfold places connected to an arc (which makes sense)
         //However, in queries asking about orphan places it cannot find these, as they have not been unfolded
         //so we make a placeholder place which just has tokens equal to the number of colored tokens
@@ -135,58 +218,163 @@ namespace PetriEngine {
             _ptplacenames[place->name][id] = std::move(name);
         }
 
-        void Unfolder::unfoldTransition(PetriNetBuilder& ptBuilder, uint32_t transitionId) {
-            double offset = 0;
+        void Unfolder::unfoldLazily(PetriNetBuilder& ptBuilder) {
+            const auto& places = _builder.places();
+            const auto& transitions = _builder.transitions();
+            auto key = [](uint32_t place, uint32_t id) { return ((uint64_t)place << 32) | id; };
+
+            // the colored transitions with an arc from each place
+            std::vector<std::vector<uint32_t>> consumers(places.size());
+            std::vector<uint32_t> unmarkedInputs(transitions.size(), 0);
+            for (uint32_t t = 0; t < transitions.size(); ++t) {
+                if (transitions[t].skipped) continue;
+                std::set<uint32_t> inputs;
+                for (const auto& arc : transitions[t].input_arcs)
+                    inputs.insert(arc.place);
+                for (auto p : inputs)
+                    consumers[p].push_back(t);
+                unmarkedInputs[t] = inputs.size();
+            }
+
+            // the unfolded places which may hold a token, and the bindings waiting for them
+            std::unordered_set<uint64_t> marked;
+            std::vector<bool> anyMarked(places.size(), false);
+            std::vector<std::vector<unfolded_transition_t>> unfolded(transitions.size());
+            std::vector<std::vector<uint32_t>> missing(transitions.size());
+            std::unordered_map<uint64_t, std::vector<std::pair<uint32_t, uint32_t>>> waiting;
+            std::vector<uint32_t> ready;
+            std::vector<std::pair<uint32_t, uint32_t>> fire;
+            std::vector<std::pair<uint32_t, uint32_t>> newlyMarked;
+
+            auto mark = [&](uint32_t place, uint32_t id) {
+                if (marked.insert(key(place, id)).second)
+                    newlyMarked.emplace_back(place, id);
+            };
+
+            std::vector<uint32_t> tupleIds;
+            for (uint32_t p = 0; p < places.size(); ++p) {
+                if (places[p].skipped) continue;
+                for (const auto& color : places[p].marking) {
+                    if (color.second == 0) continue;
+                    uint32_t id;
+                    unfoldedColor(p, color.first, id, tupleIds);
+                    mark(p, id);
+                }
+            }
+            for (uint32_t t = 0; t < transitions.size(); ++t) {
+                if (!transitions[t].skipped && unmarkedInputs[t] == 0)
+                    ready.push_back(t);
+            }
+
+            while (!ready.empty() || !fire.empty() || !newlyMarked.empty()) {
+                if (!newlyMarked.empty()) {
+                    auto [place, id] = newlyMarked.back();
+                    newlyMarked.pop_back();
+                    if (!anyMarked[place]) {
+                        anyMarked[place] = true;
+                        for (auto t : consumers[place]) {
+                            if (--unmarkedInputs[t] == 0)
+                                ready.push_back(t);
+                        }
+                    }
+                    auto it = waiting.find(key(place, id));
+                    if (it != waiting.end()) {
+                        for (auto [t, b] : it->second) {
+                            if (--missing[t][b] == 0)
+                                fire.emplace_back(t, b);
+                        }
+                        waiting.erase(it);
+                    }
+                } else if (!fire.empty()) {
+                    auto [t, b] = fire.back();
+                    fire.pop_back();
+                    const auto& transition = transitions[t];
+                    auto& binding = unfolded[t][b];
+                    storeBinding(binding.name, binding.binding);
+                    ptBuilder.addTransition(binding.name, transition._player, transition._x, transition._y + 15.0 * b);
+                    for (const auto& arc : binding.arcs) {
+                        addArc(ptBuilder, arc, binding.name);
+                        if (!arc.input && arc.id != SUM_PLACE && arc.weight > 0)
+                            mark(arc.place, arc.id);
+                    }
+                    _pttransitionnames[transition.name].push_back(binding.name);
+                    unfoldInhibitorArc(ptBuilder, transition.name, binding.name);
+                    std::vector<unfolded_arc_t>().swap(binding.arcs);
+                } else {
+                    auto t = ready.back();
+                    ready.pop_back();
+                    evaluateTransition(t, unfolded[t]);
+                    missing[t].resize(unfolded[t].size(), 0);
+                    for (uint32_t b = 0; b < unfolded[t].size(); ++b) {
+                        std::set<uint64_t> inputs;
+                        for (const auto& arc : unfolded[t][b].arcs) {
+                            if (arc.input && arc.id != SUM_PLACE && marked.count(key(arc.place, arc.id)) == 0)
+                                inputs.insert(key(arc.place, arc.id));
+                        }
+                        missing[t][b] = inputs.size();
+                        for (auto k : inputs)
+                            waiting[k].emplace_back(t, b);
+                        if (inputs.empty())
+                            fire.emplace_back(t, b);
+                    }
+                }
+            }
+
+            // the transitions without a binding which can fire are there for the queries
+            for (const auto& transition : transitions) {
+                if (!transition.skipped)
+                    _pttransitionnames[transition.name];
+            }
+        }
+
+        void Unfolder::evaluateTransition(uint32_t transitionId, std::vector<unfolded_transition_t>& unfolded) const {
             const Colored::Transition &transition = _builder.transitions()[transitionId];
             if (transition.skipped) return;
+            auto evaluate = [&](const Colored::BindingMap& b) {
+                auto& t = unfolded.emplace_back();
+                t.name = std::make_shared<const_string>(*transition.name + "_" + std::to_string(unfolded.size() - 1));
+                if (_print_bindings)
+                    t.binding = b;
+                for (const auto& arc : transition.input_arcs) {
+                    evaluateArc(arc, b, t.arcs);
+                }
+                for (const auto& arc : transition.output_arcs) {
+                    evaluateArc(arc, b, t.arcs);
+                }
+            };
             if (_fixed_point.computed() || _partition.computed()) {
                 assert(_fixed_point.variable_map().size() > transitionId);
                 assert(_symmetry.symmetries().size() > transitionId);
                 FixpointBindingGenerator gen(transition, _builder.colors(), _symmetry.symmetries()[transitionId],
                     _fixed_point.variable_map()[transitionId]);
-                size_t i = 0;
-                bool hasBindings = false;
                 for (const auto &b : gen) {
-                    auto name = std::make_shared<const_string>(*transition.name + "_" + std::to_string(i++));
-
-                    storeBinding(name, b);
-                   
-                    hasBindings = true;
-                    ptBuilder.addTransition(name, transition._player, transition._x, transition._y + offset);
-                    offset += 15;
-
-                    for (auto& arc : transition.input_arcs) {
-                        unfoldArc(ptBuilder, arc, b, name);
-                    }
-                    for (auto& arc : transition.output_arcs) {
-                        unfoldArc(ptBuilder, arc, b, name);
-                    }
-
-                    _pttransitionnames[transition.name].push_back(name);
-                    unfoldInhibitorArc(ptBuilder, transition.name, name);
-                }
-                if (!hasBindings) {
-                    _pttransitionnames[transition.name] = std::vector<shared_const_string>();
+                    evaluate(b);
                 }
             } else {
                 NaiveBindingGenerator gen(transition, _builder.colors());
-                size_t i = 0;
                 for (const auto &b : gen) {
-                    auto name = std::make_shared<const_string>(*transition.name + "_" + std::to_string(i++));
-                    ptBuilder.addTransition(name, transition._player, transition._x, transition._y + offset);
-                    offset += 15;
+                    evaluate(b);
+                }
+            }
+        }
 
-                    storeBinding(name, b);
+        void Unfolder::addTransition(PetriNetBuilder& ptBuilder, uint32_t transitionId, const std::vector<unfolded_transition_t>& unfolded) {
+            double offset = 0;
+            const Colored::Transition &transition = _builder.transitions()[transitionId];
+            if (transition.skipped) return;
+            for (const auto& t : unfolded) {
+                storeBinding(t.name, t.binding);
+                ptBuilder.addTransition(t.name, transition._player, transition._x, transition._y + offset);
+                offset += 15;
 
-                    for (const auto& arc : transition.input_arcs) {
-                        unfoldArc(ptBuilder, arc, b, name);
-                    }
-                    for (const auto& arc : transition.output_arcs) {
-                        unfoldArc(ptBuilder, arc, b, name);
-                    }
-                    _pttransitionnames[transition.name].push_back(name);
-                    unfoldInhibitorArc(ptBuilder, transition.name, name);
+                for (const auto& arc : t.arcs) {
+                    addArc(ptBuilder, arc, t.name);
                 }
+                _pttransitionnames[transition.name].push_back(t.name);
+                unfoldInhibitorArc(ptBuilder, transition.name, t.name);
+            }
+            if (unfolded.empty() && (_fixed_point.computed() || _partition.computed())) {
+                _pttransitionnames[transition.name] = std::vector<shared_const_string>();
             }
         }
 
@@ -211,7 +399,7 @@ namespace PetriEngine {
             }
         }
 
-        void Unfolder::unfoldArc(PetriNetBuilder& ptBuilder, const Colored::Arc& arc, const Colored::BindingMap& binding, const shared_const_string& tName) {
+        void Unfolder::evaluateArc(const Colored::Arc& arc, const Colored::BindingMap& binding, std::vector<unfolded_arc_t>& arcs) const {
             const PetriEngine::Colored::Place& place = _builder.places()[arc.place];
             //If the place is stable, the arc does not need to be unfolded.
             //This exploits the fact that since the transition is being unfolded with this binding
@@ -223,46 +411,42 @@ namespace PetriEngine {
             const auto ms = Colored::EvaluationVisitor::evaluate(*arc.expr, context);
             int shadowWeight = 0;
             
-            const Colored::Color *newColor;
             std::vector<uint32_t> tupleIds;
             for (const auto& color : ms) {
                 if (color.second == 0) {
                     continue;
                 }
 
-                if (!_partition.computed() || _partition.partition()[arc.place].isDiagonal()) {
-                    newColor = color.first;
-                } else {
-                    tupleIds.clear();
-                    color.first->getTupleId(tupleIds);
-
-                    _partition.partition()[arc.place].applyPartition(tupleIds);
-                    newColor = place.type->getColor(tupleIds);
-                }
-
                 shadowWeight += color.second;
                 uint32_t id;
-                if (!_partition.computed() || _partition.partition()[arc.place].isDiagonal()) {
-                    id = newColor->getId();
-                } else {
-                    id = _partition.partition()[arc.place].getUniqueIdForColor(newColor);
-                }
-                auto pName = _ptplacenames[place.name][id];
+                auto newColor = unfoldedColor(arc.place, color.first, id, tupleIds);
+                arcs.push_back({arc.place, id, newColor, color.second, arc.input});
+            }
 
-                if (pName == nullptr || pName->empty()) {
-                    unfoldPlace(ptBuilder, &place, newColor, arc.place, id);
-                    pName = _ptplacenames[place.name][id];
-                }
+            // the sum place is made even if no tokens of the binding are moved
+            if (place.inhibitor) {
+                arcs.push_back({arc.place, SUM_PLACE, nullptr, (uint32_t)shadowWeight, arc.input});
+            }
+        }
 
-                if (arc.input) {
-                    ptBuilder.addInputArc(pName, tName, false, color.second);
-                } else {
-                    ptBuilder.addOutputArc(tName, pName, color.second);
-                }
-                ++_nptarcs;
+        // the color of the unfolded place holding the tokens of color, and its id
+        const Colored::Color* Unfolder::unfoldedColor(uint32_t placeId, const Colored::Color* color, uint32_t& id, std::vector<uint32_t>& tupleIds) const {
+            if (!_partition.computed() || _partition.partition()[placeId].isDiagonal()) {
+                id = color->getId();
+                return color;
             }
+            tupleIds.clear();
+            color->getTupleId(tupleIds);
 
-            if (place.inhibitor) {
+            _partition.partition()[placeId].applyPartition(tupleIds);
+            auto newColor = _builder.places()[placeId].type->getColor(tupleIds);
+            id = _partition.partition()[placeId].getUniqueIdForColor(newColor);
+            return newColor;
+        }
+
+        void Unfolder::addArc(PetriNetBuilder& ptBuilder, const unfolded_arc_t& arc, const shared_const_string& tName) {
+            const PetriEngine::Colored::Place& place = _builder.places()[arc.place];
+            if (arc.id == SUM_PLACE) {
                 if (_sumPlacesNames.size() <= arc.place) _sumPlacesNames.resize(arc.place + 1);
                 auto& sumPlaceName = _sumPlacesNames[arc.place];
                 if (sumPlaceName == nullptr || sumPlaceName->empty()) {
@@ -271,16 +455,29 @@ namespace PetriEngine {
                     sumPlaceName = _sumPlacesNames[arc.place] = std::move(newSumPlaceName);
                 }
 
-
-                if (shadowWeight > 0) {
+                if (arc.weight > 0) {
                     if (!arc.input) {
-                        ptBuilder.addOutputArc(tName, sumPlaceName, shadowWeight);
+                        ptBuilder.addOutputArc(tName, sumPlaceName, arc.weight);
                     } else {
-                        ptBuilder.addInputArc(sumPlaceName, tName, false, shadowWeight);
+                        ptBuilder.addInputArc(sumPlaceName, tName, false, arc.weight);
                     }
                     ++_nptarcs;
                 }
+                return;
+            }
+
+            auto pName = _ptplacenames[place.name][arc.id];
+            if (pName == nullptr || pName->empty()) {
+                unfoldPlace(ptBuilder, &place, arc.color, arc.place, arc.id);
+                pName = _ptplacenames[place.name][arc.id];
+            }
+
+            if (arc.input) {
+                ptBuilder.addInputArc(pName, tName, false, arc.weight);
+            } else {
+                ptBuilder.addOutputArc(tName, pName, arc.weight);
             }
+            ++_nptarcs;
         }
 
     
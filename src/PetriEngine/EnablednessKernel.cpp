@@ -0,0 +1,193 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "PetriEngine/EnablednessKernel.h"
+#include "utils/MathExt.h"
+
+#include <algorithm>
+
+// the AVX2 kernel needs the target attribute and __builtin_cpu_supports of GCC and Clang
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define VERIFYPN_AVX2_KERNEL
+#include <immintrin.h>
+#endif
+
+namespace PetriEngine {
+
+    // marks the arcs in [from, to) which the marking does not satisfy
+    static void failedScalar(const uint32_t* places, const uint32_t* weights, const uint32_t* inhibitor,
+                             uint32_t from, uint32_t to, const MarkVal* marking, uint64_t* failed)
+    {
+        for (uint32_t i = from; i < to; ++i) {
+            uint32_t ge = marking[places[i]] >= weights[i] ? ~0u : 0u;
+            uint64_t fail = ge == inhibitor[i];
+            failed[i / 64] |= fail << (i % 64);
+        }
+    }
+
+#ifdef VERIFYPN_AVX2_KERNEL
+    // as failedScalar, eight arcs at a time from a multiple of 8; returns the first arc not handled
+    __attribute__((target("avx2")))
+    static uint32_t failedAVX2(const uint32_t* places, const uint32_t* weights, const uint32_t* inhibitor,
+                               uint32_t from, uint32_t to, const MarkVal* marking, uint64_t* failed)
+    {
+        uint32_t i = from;
+        for (; i + 8 <= to; i += 8) {
+            __m256i idx = _mm256_loadu_si256((const __m256i*)(places + i));
+            __m256i tokens = _mm256_i32gather_epi32((const int*)marking, idx, 4);
+            __m256i weight = _mm256_loadu_si256((const __m256i*)(weights + i));
+            __m256i inhib = _mm256_loadu_si256((const __m256i*)(inhibitor + i));
+            // unsigned tokens >= weight
+            __m256i ge = _mm256_cmpeq_epi32(_mm256_max_epu32(tokens, weight), tokens);
+            // a normal arc fails if not ge, an inhibitor arc if ge
+            __m256i fail = _mm256_cmpeq_epi32(ge, inhib);
+            uint64_t bits = (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(fail));
+            // i is a multiple of 8, so the bits stay within one word
+            failed[i / 64] |= bits << (i % 64);
+        }
+        return i;
+    }
+#endif
+
+    EnablednessKernel::EnablednessKernel(const PetriNet& net)
+    : _net(&net), _nplaces(net.numberOfPlaces()), _ntransitions(net.numberOfTransitions()),
+      _consumers(net._placeToPtrs), _first(net.numberOfTransitions() + 1, 0)
+    {
+        for (uint32_t t = 0; t < _ntransitions; ++t) {
+            _first[t] = _places.size();
+            auto [finv, linv] = net.preset(t);
+            for (; finv != linv; ++finv) {
+                _places.push_back(finv->place);
+                _weights.push_back(finv->tokens);
+                _inhibitor.push_back(finv->inhibitor ? ~0u : 0u);
+            }
+        }
+        _narcs = _places.size();
+        _first[_ntransitions] = _narcs;
+        _failed.resize((_narcs + 63) / 64, 0);
+        _enabled.resize((_ntransitions + 63) / 64, 0);
+        _marking.resize(_nplaces);
+    }
+
+    bool EnablednessKernel::vectorised() {
+#ifdef VERIFYPN_AVX2_KERNEL
+        static const bool avx2 = __builtin_cpu_supports("avx2");
+        return avx2;
+#else
+        return false;
+#endif
+    }
+
+    void EnablednessKernel::failed(uint32_t from, uint32_t to, const MarkVal* marking) {
+#ifdef VERIFYPN_AVX2_KERNEL
+        if (vectorised()) {
+            // arcs before from belong to other transitions, but get the right bits all the same
+            from = failedAVX2(_places.data(), _weights.data(), _inhibitor.data(), from & ~7u, to, marking, _failed.data());
+        }
+#endif
+        failedScalar(_places.data(), _weights.data(), _inhibitor.data(), from, to, marking, _failed.data());
+    }
+
+    void EnablednessKernel::compute(const MarkVal* marking) {
+        std::fill(_failed.begin(), _failed.end(), 0);
+        std::fill(_enabled.begin(), _enabled.end(), 0);
+        for (uint32_t p = 0; p < _nplaces;) {
+            // orphans are currently under "place 0" as a special case
+            if (p != 0 && marking[p] == 0) {
+                ++p;
+                continue;
+            }
+            uint32_t q = p + 1;
+            while (q < _nplaces && marking[q] > 0)
+                ++q;
+            uint32_t ft = _consumers[p], lt = _consumers[q];
+            if (ft != lt) {
+                failed(_first[ft], _first[lt], marking);
+                for (uint32_t t = ft; t < lt; ++t) {
+                    if (!anyFailed(_first[t], _first[t + 1]))
+                        _enabled[t / 64] |= uint64_t{1} << (t % 64);
+                }
+            }
+            p = q;
+        }
+        std::copy(marking, marking + _nplaces, _marking.begin());
+        _valid = true;
+    }
+
+    void EnablednessKernel::update(const MarkVal* marking) {
+        if (!_valid)
+            return compute(marking);
+        _changed.clear();
+        size_t work = 0;
+        for (uint32_t p = 0; p < _nplaces; ++p) {
+            if (_marking[p] == marking[p])
+                continue;
+            _changed.push_back(p);
+            auto [first, last] = _net->consumers(p);
+            work += last - first;
+            // rechecking one at a time does not pay off for large changes
+            if (work > _ntransitions / 4)
+                return compute(marking);
+        }
+        for (auto p : _changed) {
+            _marking[p] = marking[p];
+            auto [first, last] = _net->consumers(p);
+            for (; first != last; ++first) {
+                const uint64_t bit = uint64_t{1} << (*first % 64);
+                if (fireable(*first, marking))
+                    _enabled[*first / 64] |= bit;
+                else
+                    _enabled[*first / 64] &= ~bit;
+            }
+        }
+    }
+
+    bool EnablednessKernel::fireable(uint32_t t, const MarkVal* marking) const {
+        for (uint32_t i = _first[t]; i < _first[t + 1]; ++i) {
+            if ((marking[_places[i]] >= _weights[i]) == (_inhibitor[i] != 0))
+                return false;
+        }
+        return true;
+    }
+
+    bool EnablednessKernel::anyFailed(uint32_t from, uint32_t to) const {
+        if (from == to)
+            return false;
+        uint32_t fw = from / 64;
+        uint32_t lw = (to - 1) / 64;
+        uint64_t lo = ~uint64_t{0} << (from % 64);
+        uint64_t hi = ~uint64_t{0} >> (63 - ((to - 1) % 64));
+        if (fw == lw)
+            return (_failed[fw] & lo & hi) != 0;
+        if ((_failed[fw] & lo) != 0)
+            return true;
+        for (uint32_t w = fw + 1; w < lw; ++w) {
+            if (_failed[w] != 0)
+                return true;
+        }
+        return (_failed[lw] & hi) != 0;
+    }
+
+    uint32_t EnablednessKernel::next(uint32_t from, uint32_t to) const {
+        while (from < to) {
+            uint64_t word = _enabled[from / 64] >> (from % 64);
+            if (word != 0)
+                return std::min<uint32_t>(from + lowestBit(word), to);
+            from = (from / 64 + 1) * 64;
+        }
+        return to;
+    }
+}
@@ -19,39 +19,69 @@ namespace PetriEngine::ExplicitColored {
         const std::unordered_map<std::string, Transition_t>& transitionNameIndices,
         const size_t seed,
         bool createTrace
-    ) : _net(std::move(net)),
+    ) : ExplicitWorklist(net, std::vector{query}, placeNameIndices, transitionNameIndices, seed, createTrace) {}
+
+    ExplicitWorklist::ExplicitWorklist(
+        const ColoredPetriNet& net,
+        const std::vector<PQL::Condition_ptr>& queries,
+        const std::unordered_map<std::string, uint32_t>& placeNameIndices,
+        const std::unordered_map<std::string, Transition_t>& transitionNameIndices,
+        const size_t seed,
+        bool createTrace
+    ) : _undecided(queries.size()),
+        _net(std::move(net)),
         _successorGenerator(ColoredSuccessorGenerator{_net}),
         _seed(seed),
         _createTrace(createTrace)
     {
-        const ExplicitQueryPropositionCompiler queryCompiler(placeNameIndices, transitionNameIndices, _successorGenerator);
-        if (const auto efGammaQuery = dynamic_cast<PQL::EFCondition*>(query.get())) {
-            _quantifier = Quantifier::EF;
-            _gammaQuery = queryCompiler.compile(efGammaQuery->getCond());
-        } else if (const auto agGammaQuery = dynamic_cast<PQL::AGCondition*>(query.get())) {
-            _quantifier = Quantifier::AG;
-            _gammaQuery = queryCompiler.compile(agGammaQuery->getCond());
-        } else {
+        if (queries.empty()) {
             throw explicit_error{ExplicitErrorType::UNSUPPORTED_QUERY};
         }
+        const ExplicitQueryPropositionCompiler queryCompiler(placeNameIndices, transitionNameIndices, _successorGenerator);
+        for (const auto& query : queries) {
+            ExplicitQuery& compiled = _queries.emplace_back();
+            if (const auto efGammaQuery = dynamic_cast<PQL::EFCondition*>(query.get())) {
+                compiled.quantifier = Quantifier::EF;
+                compiled.gammaQuery = queryCompiler.compile(efGammaQuery->getCond());
+            } else if (const auto agGammaQuery = dynamic_cast<PQL::AGCondition*>(query.get())) {
+                compiled.quantifier = Quantifier::AG;
+                compiled.gammaQuery = queryCompiler.compile(agGammaQuery->getCond());
+            } else {
+                throw explicit_error{ExplicitErrorType::UNSUPPORTED_QUERY};
+            }
+        }
     }
 
-    bool ExplicitWorklist::check(const Strategy searchStrategy, const ColoredSuccessorGeneratorOption coloredSuccessorGeneratorOption) {
+    bool ExplicitWorklist::check(const Strategy searchStrategy, const ColoredSuccessorGeneratorOption coloredSuccessorGeneratorOption, const bool encodedWaitingList) {
+        _encodedWaitingList = encodedWaitingList;
         if (coloredSuccessorGeneratorOption == ColoredSuccessorGeneratorOption::FIXED) {
-            return _search<ColoredPetriNetStateFixed>(searchStrategy);
-        }
-        if (coloredSuccessorGeneratorOption == ColoredSuccessorGeneratorOption::EVEN) {
-            return _search<ColoredPetriNetStateEven>(searchStrategy);
+            _search<ColoredPetriNetStateFixed>(searchStrategy);
+        } else if (coloredSuccessorGeneratorOption == ColoredSuccessorGeneratorOption::EVEN) {
+            _search<ColoredPetriNetStateEven>(searchStrategy);
+        } else {
+            throw explicit_error(ExplicitErrorType::UNSUPPORTED_GENERATOR);
         }
-        throw explicit_error(ExplicitErrorType::UNSUPPORTED_GENERATOR);
+        return _queries[0].result == Reachability::AbstractHandler::Satisfied;
     }
 
     const SearchStatistics & ExplicitWorklist::GetSearchStatistics() const {
         return _searchStatistics;
     }
 
-    std::optional<uint64_t> ExplicitWorklist::getCounterExampleId() const {
-        return _counterExampleId;
+    size_t ExplicitWorklist::numberOfQueries() const {
+        return _queries.size();
+    }
+
+    Reachability::AbstractHandler::Result ExplicitWorklist::getResult(const size_t query) const {
+        return _queries[query].result;
+    }
+
+    const SearchStatistics& ExplicitWorklist::getSearchStatistics(const size_t query) const {
+        return _queries[query].searchStatistics;
+    }
+
+    std::optional<uint64_t> ExplicitWorklist::getCounterExampleId(const size_t query) const {
+        return _queries[query].counterExampleId;
     }
 
     std::optional<std::vector<InternalTraceStep>> ExplicitWorklist::getTraceTo(uint64_t counterExampleId) const {
@@ -71,16 +101,61 @@ namespace PetriEngine::ExplicitColored {
         return std::vector(trace.rbegin(), trace.rend());
     }
 
-    bool ExplicitWorklist::_check(const ColoredPetriNetMarking& state, size_t id) const {
-        return _gammaQuery->eval(_successorGenerator, state, id);
+    // Retires every query decided by state, returns true when no query is left
+    bool ExplicitWorklist::_check(const ColoredPetriNetMarking& state, size_t id) {
+        for (auto& query : _queries) {
+            if (query.result != Reachability::AbstractHandler::Unknown) {
+                continue;
+            }
+            const bool earlyTerminationCondition = query.quantifier == Quantifier::EF;
+            if (query.gammaQuery->eval(_successorGenerator, state, id) == earlyTerminationCondition) {
+                query.result = earlyTerminationCondition
+                    ? Reachability::AbstractHandler::Satisfied
+                    : Reachability::AbstractHandler::NotSatisfied;
+                query.counterExampleId = id;
+                query.searchStatistics = _searchStatistics;
+                --_undecided;
+            }
+        }
+        return _undecided == 0;
+    }
+
+    // Decides the queries no state decided once the search is over
+    void ExplicitWorklist::_decideRemaining(const bool fullStatespace) {
+        for (auto& query : _queries) {
+            if (query.result != Reachability::AbstractHandler::Unknown) {
+                continue;
+            }
+            if (fullStatespace) {
+                query.result = query.quantifier == Quantifier::AG
+                    ? Reachability::AbstractHandler::Satisfied
+                    : Reachability::AbstractHandler::NotSatisfied;
+            }
+            query.searchStatistics = _searchStatistics;
+        }
+    }
+
+    // Moves the guide of a heuristic search to the first undecided query once its query is decided
+    template <template <typename> typename WaitingList, typename T>
+    void ExplicitWorklist::_guideBy(WaitingList<T>& waiting) {
+        if constexpr (std::is_same_v<WaitingList<T>, BestFSStructure<T>>) {
+            if (_queries[_guide].result == Reachability::AbstractHandler::Unknown) {
+                return;
+            }
+            while (_guide < _queries.size() && _queries[_guide].result != Reachability::AbstractHandler::Unknown) {
+                ++_guide;
+            }
+            if (_guide < _queries.size()) {
+                waiting.setQuery(_queries[_guide].gammaQuery, _queries[_guide].quantifier == Quantifier::AG);
+            }
+        }
     }
 
     template <template <typename> typename WaitingList, typename T>
-    bool ExplicitWorklist::_genericSearch(WaitingList<T> waiting) {
+    void ExplicitWorklist::_genericSearch(WaitingList<T> waiting) {
         ptrie::set<uint8_t> passed;
         ColoredEncoder encoder = ColoredEncoder{_net.getPlaces()};
         const auto& initialState = _net.initial();
-        const auto earlyTerminationCondition = _quantifier == Quantifier::EF;
 
         auto size = encoder.encode(initialState);
         passed.insert(encoder.data(), size);
@@ -97,12 +172,13 @@ namespace PetriEngine::ExplicitColored {
         _searchStatistics.exploredStates = 1;
         _searchStatistics.discoveredStates = 1;
 
-        if (_check(initialState, 0) == earlyTerminationCondition) {
-            _counterExampleId = 0;
-            return _getResult(true, encoder.isFullStatespace());
+        if (_check(initialState, 0)) {
+            return;
         }
+        _guideBy(waiting);
         if (_net.getTransitionCount() == 0) {
-            return _getResult(false, encoder.isFullStatespace());
+            _decideRemaining(encoder.isFullStatespace());
+            return;
         }
 
         while (!waiting.empty()){
@@ -131,12 +207,12 @@ namespace PetriEngine::ExplicitColored {
                     _stateMap.transitions.emplace(successor.id, traceStep);
                 }
                 _searchStatistics.exploredStates += 1;
-                if (_check(marking, successor.id) == earlyTerminationCondition) {
-                    _searchStatistics.endWaitingStates = waiting.size();
-                    _searchStatistics.biggestEncoding = encoder.getBiggestEncoding();
-                    _counterExampleId = successor.id;
-                    return _getResult(true, encoder.isFullStatespace());
+                _searchStatistics.endWaitingStates = waiting.size();
+                _searchStatistics.biggestEncoding = encoder.getBiggestEncoding();
+                if (_check(marking, successor.id)) {
+                    return;
                 }
+                _guideBy(waiting);
                 waiting.add(std::move(successor));
                 passed.insert(encoder.data(), size);
                 _searchStatistics.peakWaitingStates = std::max(waiting.size(), _searchStatistics.peakWaitingStates);
@@ -145,11 +221,114 @@ namespace PetriEngine::ExplicitColored {
 
         _searchStatistics.endWaitingStates = waiting.size();
         _searchStatistics.biggestEncoding = encoder.getBiggestEncoding();
-        return _getResult(false, encoder.isFullStatespace());
+        _decideRemaining(encoder.isFullStatespace());
+    }
+
+    template <template <typename> typename WaitingList, typename T>
+    void ExplicitWorklist::_encodedSearch(WaitingList<EncodedState> waiting) {
+        ptrie::set_stable<ptrie::uchar, size_t, 17, 128, 4> passed;
+        ColoredEncoder encoder = ColoredEncoder{_net.getPlaces()};
+        const auto& initialState = _net.initial();
+        std::vector<ptrie::uchar> decoding(UINT16_MAX + 1);
+        // States too big for the encoding are only stored truncated, so they wait with their full marking
+        std::unordered_map<size_t, ColoredPetriNetMarking> unencoded;
+        const auto add = [&](EncodedState state, const ColoredPetriNetMarking& marking) {
+            if constexpr (std::is_same_v<WaitingList<EncodedState>, BestFSStructure<EncodedState>>) {
+                waiting.add(state, marking);
+            } else {
+                waiting.add(state);
+            }
+        };
+
+        auto size = encoder.encode(initialState);
+        add(EncodedState {passed.insert(encoder.data(), size).second, 0}, initialState);
+
+        _searchStatistics.exploredStates = 1;
+        _searchStatistics.discoveredStates = 1;
+
+        if (_check(initialState, 0)) {
+            return;
+        }
+        _guideBy(waiting);
+        if (_net.getTransitionCount() == 0) {
+            _decideRemaining(encoder.isFullStatespace());
+            return;
+        }
+
+        // The marking of the state added last, so a depth first search does not decode it again
+        ColoredPetriNetMarking lastMarking = initialState;
+        size_t lastId = 0;
+        while (!waiting.empty()) {
+            const auto popped = waiting.next();
+            waiting.remove();
+            ColoredPetriNetMarking marking;
+            if (popped.id == lastId) {
+                marking = std::move(lastMarking);
+                lastId = std::numeric_limits<size_t>::max();
+            } else if (auto it = unencoded.find(popped.id); it != unencoded.end()) {
+                marking = std::move(it->second);
+                unencoded.erase(it);
+            } else {
+                passed.unpack(popped.encodingId, decoding.data());
+                marking = encoder.decode(decoding.data());
+            }
+            auto state = [&] {
+                if constexpr (std::is_same_v<T, ColoredPetriNetStateEven>) {
+                    return ColoredPetriNetStateEven{std::move(marking), _net.getTransitionCount()};
+                } else {
+                    return ColoredPetriNetStateFixed{std::move(marking)};
+                }
+            }();
+            state.id = popped.id;
+
+            while (true) {
+                auto [successor, traceStep] = _successorGenerator.next(state);
+                if (state.done()) {
+                    _successorGenerator.shrinkState(state.id);
+                    break;
+                }
+
+                if constexpr (std::is_same_v<T, ColoredPetriNetStateEven>) {
+                    if (state.shuffle) {
+                        state.shuffle = false;
+                        continue;
+                    }
+                }
+
+                successor.shrink();
+                size = encoder.encode(successor.marking);
+                _searchStatistics.discoveredStates++;
+                auto [isNew, encodingId] = passed.insert(encoder.data(), size);
+                if (!isNew) {
+                    continue;
+                }
+                if (_createTrace) {
+                    _stateMap.transitions.emplace(successor.id, traceStep);
+                }
+                _searchStatistics.exploredStates += 1;
+                _searchStatistics.endWaitingStates = waiting.size();
+                _searchStatistics.biggestEncoding = encoder.getBiggestEncoding();
+                if (_check(successor.marking, successor.id)) {
+                    return;
+                }
+                _guideBy(waiting);
+                add(EncodedState {encodingId, successor.id}, successor.marking);
+                if (size == UINT16_MAX) {
+                    unencoded.emplace(successor.id, successor.marking);
+                }
+                lastMarking = std::move(successor.marking);
+                lastId = successor.id;
+                _searchStatistics.peakWaitingStates = std::max(waiting.size(), _searchStatistics.peakWaitingStates);
+            }
+        }
+
+        _searchStatistics.endWaitingStates = waiting.size();
+        _searchStatistics.biggestEncoding = encoder.getBiggestEncoding();
+        _decideRemaining(encoder.isFullStatespace());
     }
 
     template<typename SuccessorGeneratorState>
-    bool ExplicitWorklist::_search(const Strategy searchStrategy) {
+    void ExplicitWorklist::_search(const Strategy searchStrategy) {
         switch (searchStrategy) {
             case Strategy::DEFAULT:
             case Strategy::DFS:
@@ -166,44 +345,50 @@ namespace PetriEngine::ExplicitColored {
     }
 
     template <typename T>
-    bool ExplicitWorklist::_dfs() {
+    void ExplicitWorklist::_dfs() {
+        if (_encodedWaitingList) {
+            return _encodedSearch<DFSStructure, T>(DFSStructure<EncodedState> {});
+        }
         return _genericSearch<DFSStructure>(DFSStructure<T> {});
     }
 
     template <typename T>
-    bool ExplicitWorklist::_bfs() {
+    void ExplicitWorklist::_bfs() {
+        if (_encodedWaitingList) {
+            return _encodedSearch<BFSStructure, T>(BFSStructure<EncodedState> {});
+        }
         return _genericSearch<BFSStructure>(BFSStructure<T> {});
     }
 
     template <typename T>
-    bool ExplicitWorklist::_rdfs() {
+    void ExplicitWorklist::_rdfs() {
+        if (_encodedWaitingList) {
+            return _encodedSearch<RDFSStructure, T>(RDFSStructure<EncodedState>(_seed));
+        }
         return _genericSearch<RDFSStructure>(RDFSStructure<T>(_seed));
     }
 
+    // The heuristic is guided by the first undecided query of the batch
     template <typename T>
-    bool ExplicitWorklist::_bestfs() {
+    void ExplicitWorklist::_bestfs() {
+        _guide = 0;
+        if (_encodedWaitingList) {
+            return _encodedSearch<BestFSStructure, T>(
+                BestFSStructure<EncodedState>(
+                    _seed,
+                    _queries[_guide].gammaQuery,
+                    _queries[_guide].quantifier == Quantifier::AG
+                    )
+                );
+        }
         return _genericSearch<BestFSStructure>(
             BestFSStructure<T>(
                 _seed,
-                _gammaQuery,
-                _quantifier == Quantifier::AG
+                _queries[_guide].gammaQuery,
+                _queries[_guide].quantifier == Quantifier::AG
                 )
             );
     }
-
-    bool ExplicitWorklist::_getResult(const bool found, const bool fullStatespace) const {
-        Reachability::ResultPrinter::Result res;
-        if (!found && !fullStatespace) {
-            res = Reachability::ResultPrinter::Result::Unknown;
-        }else {
-            res = (
-           (!found && _quantifier == Quantifier::AG) ||
-           (found && _quantifier == Quantifier::EF))
-               ? Reachability::ResultPrinter::Result::Satisfied
-               : Reachability::ResultPrinter::Result::NotSatisfied;
-        }
-        return res == Reachability::ResultPrinter::Result::Satisfied;
-    }
 }
 
 #endif //NAIVEWORKLIST_CPP
\ No newline at end of file
@@ -76,7 +76,7 @@ namespace PetriEngine::ExplicitColored {
                 _traceStream << "\t</transition>" << std::endl;
             }
             _traceStream << "\t<marking>" << std::endl;
-            _printMarkings(trace.cpnBuilder, step);
+            _printMarkings(*trace.cpnBuilder, step);
             _traceStream << "\t</marking>" << std::endl;
         }
         _traceStream << "</trace>" << std::endl;
@@ -14,13 +14,24 @@ namespace PetriEngine::ExplicitColored {
         const Condition_ptr& query,
         options_t& options,
         IColoredResultPrinter* resultPrinter
+    ) const {
+        return checkQueries({query}, options, {resultPrinter})[0];
+    }
+
+    std::vector<ExplicitColoredModelChecker::Result> ExplicitColoredModelChecker::checkQueries(
+        const std::vector<Condition_ptr>& queries,
+        options_t& options,
+        const std::vector<IColoredResultPrinter*>& resultPrinters
     ) const {
         std::stringstream pnmlModelStream;
-        Result result = Result::UNKNOWN;
+        std::vector results(queries.size(), Result::UNKNOWN);
         std::ifstream modelFile(options.modelfile);
         pnmlModelStream << modelFile.rdbuf();
         std::string pnmlModel = std::move(pnmlModelStream).str();
         bool isOverApproximationOnly = false;
+        const auto resultPrinter = [&](const size_t query) {
+            return query < resultPrinters.size() ? resultPrinters[query] : nullptr;
+        };
 
         if (options.strategy == Strategy::OverApprox) {
             isOverApproximationOnly = true;
@@ -29,46 +40,48 @@ namespace PetriEngine::ExplicitColored {
 
         if (options.enablecolreduction) {
             std::stringstream reducedPnml;
-            _reduce(pnmlModel, reducedPnml, query, options);
+            _reduce(pnmlModel, reducedPnml, queries, options);
             pnmlModel = std::move(reducedPnml).str();
         }
 
         if (options.queryReductionTimeout > 0) {
-            result = checkColorIgnorantLP(pnmlModel, query, options);
-            if (result != Result::UNKNOWN) {
-                if (resultPrinter) {
-                    resultPrinter->printNonExplicitResult(
+            for (size_t i = 0; i < queries.size(); ++i) {
+                results[i] = checkColorIgnorantLP(pnmlModel, queries[i], options);
+                if (results[i] != Result::UNKNOWN && resultPrinter(i)) {
+                    resultPrinter(i)->printNonExplicitResult(
                         {"COLOR_IGNORANT", "QUERY_REDUCTION", "SAT_SMT", "LP_APPROX" },
-                        result == Result::SATISFIED
+                        results[i] == Result::SATISFIED
                             ? AbstractHandler::Result::Satisfied
                             : AbstractHandler::Result::NotSatisfied
                     );
                 }
-                return result;
             }
         }
         if (isOverApproximationOnly) {
-            return Result::UNKNOWN;
+            return results;
         }
 
-        SearchStatistics searchStatistics;
-        auto [newResult, trace] = explicitColorCheck(pnmlModel, query, options, &searchStatistics);
-        result = newResult;
-        if (result != Result::UNKNOWN) {
-            if (resultPrinter) {
-                resultPrinter->printResult(
-                    searchStatistics,
-                    result == Result::SATISFIED
-                        ? AbstractHandler::Result::Satisfied
-                        : AbstractHandler::Result::NotSatisfied,
-                    trace.has_value()
-                        ? &trace.value()
-                        : nullptr
-                );
+        // the queries left are explored together
+        std::vector<size_t> remaining;
+        for (size_t i = 0; i < queries.size(); ++i) {
+            if (results[i] == Result::UNKNOWN) {
+                remaining.push_back(i);
             }
-            return result;
         }
-        return Result::UNKNOWN;
+        if (remaining.empty()) {
+            return results;
+        }
+        std::vector<IColoredResultPrinter*> remainingPrinters;
+        std::vector<Condition_ptr> remainingQueries;
+        for (const auto i : remaining) {
+            remainingQueries.push_back(queries[i]);
+            remainingPrinters.push_back(resultPrinter(i));
+        }
+        const auto explicitResults = explicitColorCheck(pnmlModel, remainingQueries, options, remainingPrinters);
+        for (size_t i = 0; i < remaining.size(); ++i) {
+            results[remaining[i]] = explicitResults[i];
+        }
+        return results;
     }
 
     ExplicitColoredModelChecker::Result ExplicitColoredModelChecker::checkColorIgnorantLP(
@@ -238,13 +251,14 @@ namespace PetriEngine::ExplicitColored {
         return Result::UNKNOWN;
     }
 
-    std::pair<ExplicitColoredModelChecker::Result, std::optional<ExplicitColoredTraceContext>> ExplicitColoredModelChecker::explicitColorCheck(
+    std::vector<ExplicitColoredModelChecker::Result> ExplicitColoredModelChecker::explicitColorCheck(
         const std::string& pnmlModel,
-        const Condition_ptr& query,
+        const std::vector<Condition_ptr>& queries,
         options_t& options,
-        SearchStatistics* searchStatistics
+        const std::vector<IColoredResultPrinter*>& resultPrinters
     ) const {
-        ExplicitColoredPetriNetBuilder cpnBuilder;
+        auto cpnBuilderPtr = std::make_shared<ExplicitColoredPetriNetBuilder>();
+        auto& cpnBuilder = *cpnBuilderPtr;
         auto pnmlModelStream = std::istringstream {pnmlModel};
         cpnBuilder.parse_model(pnmlModelStream);
 
@@ -254,44 +268,62 @@ namespace PetriEngine::ExplicitColored {
         case ColoredPetriNetBuilderStatus::TOO_MANY_BINDINGS:
             std::cout << "The colored petri net has too many bindings to be represented" << std::endl
                     << "TOO_MANY_BINDINGS" << std::endl;
-            return std::make_pair(Result::UNKNOWN, std::nullopt);
+            return std::vector(queries.size(), Result::UNKNOWN);
         default:
             throw base_error("Unknown builder error ", static_cast<uint32_t>(buildStatus));
         }
 
         auto net = cpnBuilder.takeNet();
 
-        ExplicitWorklist worklist(net, query, cpnBuilder.getPlaceIndices(), cpnBuilder.getTransitionIndices(), options.seed(), options.trace != TraceLevel::None);
-        bool result = worklist.check(options.strategy, options.colored_sucessor_generator);
-
-        if (searchStatistics) {
-            *searchStatistics = worklist.GetSearchStatistics();
-        }
+        ExplicitWorklist worklist(net, queries, cpnBuilder.getPlaceIndices(), cpnBuilder.getTransitionIndices(), options.seed(), options.trace != TraceLevel::None);
+        worklist.check(options.strategy, options.colored_sucessor_generator, options.colored_encoded_waiting_list);
+
+        std::vector<Result> results;
+        for (size_t i = 0; i < queries.size(); ++i) {
+            const auto result = worklist.getResult(i);
+            results.push_back(
+                result == AbstractHandler::Result::Satisfied
+                    ? Result::SATISFIED
+                    : result == AbstractHandler::Result::NotSatisfied
+                        ? Result::UNSATISFIED
+                        : Result::UNKNOWN
+            );
+            if (results.back() == Result::UNKNOWN || i >= resultPrinters.size() || resultPrinters[i] == nullptr) {
+                continue;
+            }
 
-        std::optional<ExplicitColoredTraceContext> traceContext = std::nullopt;
-        if (options.trace != TraceLevel::None) {
-            auto counterExample = worklist.getCounterExampleId();
+            std::optional<ExplicitColoredTraceContext> traceContext = std::nullopt;
+            if (options.trace != TraceLevel::None) {
+                auto counterExample = worklist.getCounterExampleId(i);
 
-            if (counterExample.has_value()) {
-                auto internalTrace  = worklist.getTraceTo(counterExample.value());
-                if (internalTrace.has_value()) {
-                    traceContext.emplace(_translateTraceStep(internalTrace.value(), cpnBuilder, net), std::move(cpnBuilder));
+                if (counterExample.has_value()) {
+                    auto internalTrace  = worklist.getTraceTo(counterExample.value());
+                    if (internalTrace.has_value()) {
+                        traceContext.emplace(_translateTraceStep(internalTrace.value(), cpnBuilder, net), cpnBuilderPtr);
+                    }
                 }
             }
+            resultPrinters[i]->printResult(
+                worklist.getSearchStatistics(i),
+                result,
+                traceContext.has_value()
+                    ? &traceContext.value()
+                    : nullptr
+            );
         }
-        return std::make_pair(result ? Result::SATISFIED : Result::UNSATISFIED, std::move(traceContext));
+        return results;
     }
 
     void ExplicitColoredModelChecker::_reduce(
         const std::string& pnmlModel,
         std::stringstream& out,
-        const Condition_ptr& query,
+        const std::vector<Condition_ptr>& reductionQueries,
         options_t& options
     ) const {
         PetriEngine::ColoredPetriNetBuilder cpnBuilder(_stringSet);
         std::stringstream pnmlModelStream {pnmlModel};
         cpnBuilder.parse_model(pnmlModelStream);
-        auto queries = std::vector{query};
+        auto queries = reductionQueries;
         const bool result = reduceColored(cpnBuilder, queries, options.logic, options.colReductionTimeout, _fullStatisticOut,
                       options.enablecolreduction, options.colreductions);
         std::stringstream cpnResult;
@@ -0,0 +1,104 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PetriEngine/NetCache.h"
+#include "PetriEngine/BinaryNet.h"
+#include "utils/errors.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+namespace PetriEngine {
+
+    NetCache::Key& NetCache::Key::add(const void* data, size_t size) {
+        auto bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            _hash ^= bytes[i];
+            _hash *= 1099511628211ULL;
+        }
+        return *this;
+    }
+
+    std::string NetCache::Key::str() const {
+        static const char digits[] = "0123456789abcdef";
+        std::string result(16, '0');
+        for (size_t i = 0; i < 16; ++i)
+            result[i] = digits[(_hash >> (60 - 4 * i)) & 0xF];
+        return result;
+    }
+
+    std::string NetCache::file(const Key& key) const {
+        return (std::filesystem::path(_directory) / (key.str() + ".vpnnet")).string();
+    }
+
+    std::string NetCache::find(const Key& key) const {
+        auto path = file(key);
+        std::error_code ec;
+        return std::filesystem::is_regular_file(path, ec) ? path : std::string();
+    }
+
+    std::unique_ptr<NetCache::net_t> NetCache::load(const Key& key, shared_string_set& string_set) const {
+        auto path = find(key);
+        if (path.empty())
+            return nullptr;
+        auto net = std::make_unique<net_t>(string_set);
+        net->file = path;
+        try {
+            net->colored = BinaryNet::read(path, net->builder, net->transition_names, net->place_names);
+        } catch (const base_error& err) {
+            std::cerr << "Warning: ignoring " << path << " in the net cache: " << err.what() << std::endl;
+            return nullptr;
+        }
+        return net;
+    }
+
+    void NetCache::store(const Key& key, const PetriNetBuilder& builder, bool colored,
+                         const shared_name_name_map& transition_names,
+                         const shared_place_color_map& place_names) const
+    {
+        auto path = file(key);
+        std::stringstream tmp;
+#ifndef _WIN32
+        tmp << path << "." << getpid() << ".tmp";
+#else
+        tmp << path << ".tmp";
+#endif
+        std::error_code ec;
+        std::filesystem::create_directories(_directory, ec);
+        {
+            std::ofstream out(tmp.str(), std::ios::binary);
+            if (out)
+                BinaryNet::write(out, builder, colored, transition_names, place_names);
+            if (!out) {
+                std::cerr << "Warning: could not write " << tmp.str() << " to the net cache" << std::endl;
+                std::filesystem::remove(tmp.str(), ec);
+                return;
+            }
+        }
+        std::filesystem::rename(tmp.str(), path, ec);
+        if (ec) {
+            std::cerr << "Warning: could not store " << path << " in the net cache: " << ec.message() << std::endl;
+            std::filesystem::remove(tmp.str(), ec);
+        }
+    }
+}
@@ -0,0 +1,276 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PetriEngine/PQL/CompiledCondition.h"
+#include "PetriEngine/PQL/Expressions.h"
+
+#include <algorithm>
+
+namespace PetriEngine { namespace PQL {
+
+    // labels of the end of the program
+    static constexpr uint32_t ACCEPT = 0;
+    static constexpr uint32_t REJECT = 1;
+
+    static Condition::Result negate(Condition::Result r)
+    {
+        if (r == Condition::RTRUE) return Condition::RFALSE;
+        if (r == Condition::RFALSE) return Condition::RTRUE;
+        return Condition::RUNKNOWN;
+    }
+
+    CompiledCondition::CompiledCondition(const Condition* condition)
+    {
+        _labels = {0, 0};
+        _valid = compileTop(condition);
+        if (!_valid) {
+            _program.clear();
+            _terms.clear();
+            _bounds.clear();
+        }
+        else {
+            const uint32_t end = _program.size();
+            _labels[ACCEPT] = end;
+            _labels[REJECT] = end + 1;
+            for (auto& i : _program) {
+                i._on_true = _labels[i._on_true];
+                i._on_false = _labels[i._on_false];
+            }
+        }
+        _labels.clear();
+        _labels.shrink_to_fit();
+    }
+
+    uint32_t CompiledCondition::label()
+    {
+        _labels.push_back(0);
+        return _labels.size() - 1;
+    }
+
+    void CompiledCondition::emit(op_t op, uint32_t on_true, uint32_t on_false, uint32_t first, uint32_t last, int64_t constant)
+    {
+        _program.push_back(instruction_t{op, on_true, on_false, first, last, constant});
+    }
+
+    bool CompiledCondition::compileTop(const Condition* condition)
+    {
+        if (auto shallow = dynamic_cast<const ShallowCondition*>(condition))
+            return shallow->getCompiled() && compileTop(shallow->getCompiled().get());
+
+        if (auto neg = dynamic_cast<const NotCondition*>(condition)) {
+            if (!compileTop((*neg)[0].get()))
+                return false;
+            _on_accept = negate(_on_accept);
+            _on_reject = negate(_on_reject);
+            return true;
+        }
+
+        const auto type = condition->type();
+        // existential operators only decide a satisfied state formula, universal only a violated one
+        if (type == type_id<EFCondition>() || type == type_id<AFCondition>() ||
+            type == type_id<ECondition>() || type == type_id<FCondition>()) {
+            if (!compileTop((*static_cast<const SimpleQuantifierCondition*>(condition))[0].get()))
+                return false;
+            if (_on_accept != Condition::RTRUE) _on_accept = Condition::RUNKNOWN;
+            if (_on_reject != Condition::RTRUE) _on_reject = Condition::RUNKNOWN;
+            return true;
+        }
+        if (type == type_id<EGCondition>() || type == type_id<AGCondition>() ||
+            type == type_id<ACondition>() || type == type_id<GCondition>()) {
+            if (!compileTop((*static_cast<const SimpleQuantifierCondition*>(condition))[0].get()))
+                return false;
+            if (_on_accept != Condition::RFALSE) _on_accept = Condition::RUNKNOWN;
+            if (_on_reject != Condition::RFALSE) _on_reject = Condition::RUNKNOWN;
+            return true;
+        }
+        return compile(condition, ACCEPT, REJECT);
+    }
+
+    bool CompiledCondition::compile(const Condition* condition, uint32_t on_true, uint32_t on_false)
+    {
+        if (auto shallow = dynamic_cast<const ShallowCondition*>(condition))
+            return shallow->getCompiled() && compile(shallow->getCompiled().get(), on_true, on_false);
+
+        if (auto neg = dynamic_cast<const NotCondition*>(condition))
+            return compile((*neg)[0].get(), on_false, on_true);
+
+        if (auto logical = dynamic_cast<const LogicalCondition*>(condition)) {
+            const bool conjunction = condition->type() == type_id<AndCondition>();
+            if (logical->empty()) {
+                emit(CONSTANT, on_true, on_false, 0, 0, conjunction);
+                return true;
+            }
+            // all but the last operand continue with the next one, unless they decide the result
+            for (size_t i = 0; i + 1 < logical->size(); ++i) {
+                const uint32_t next = label();
+                if (!compile((*logical)[i].get(), conjunction ? next : on_true, conjunction ? on_false : next))
+                    return false;
+                _labels[next] = _program.size();
+            }
+            return compile(logical->getOperands().back().get(), on_true, on_false);
+        }
+
+        if (auto conj = dynamic_cast<const CompareConjunction*>(condition)) {
+            const uint32_t first = _bounds.size();
+            for (auto& c : conj->constraints())
+                _bounds.push_back(bound_t{c._place, c._lower, c._upper});
+            if (conj->isNegated())
+                emit(BOUNDS, on_false, on_true, first, _bounds.size());
+            else
+                emit(BOUNDS, on_true, on_false, first, _bounds.size());
+            return true;
+        }
+
+        if (auto compare = dynamic_cast<const CompareCondition*>(condition)) {
+            // lhs - rhs compared to zero
+            linear_t lhs, rhs;
+            if (!linearize((*compare)[0].get(), lhs) || !linearize((*compare)[1].get(), rhs))
+                return false;
+            for (auto& t : rhs._terms)
+                lhs._terms.push_back(term_t{t._place, -t._coefficient});
+            std::sort(lhs._terms.begin(), lhs._terms.end(), [](auto& a, auto& b) { return a._place < b._place; });
+            const uint32_t first = _terms.size();
+            for (auto& t : lhs._terms) {
+                if (_terms.size() > first && _terms.back()._place == t._place)
+                    _terms.back()._coefficient += t._coefficient;
+                else
+                    _terms.push_back(t);
+                if (_terms.back()._coefficient == 0)
+                    _terms.pop_back();
+            }
+
+            op_t op;
+            const auto type = condition->type();
+            if (type == type_id<LessThanCondition>())
+                op = LESS;
+            else if (type == type_id<LessThanOrEqualCondition>())
+                op = LESS_EQUAL;
+            else if (type == type_id<EqualCondition>())
+                op = EQUAL;
+            else if (type == type_id<NotEqualCondition>())
+                op = NOT_EQUAL;
+            else
+                return false;
+            emit(op, on_true, on_false, first, _terms.size(), lhs._constant - rhs._constant);
+            return true;
+        }
+
+        if (auto boolean = dynamic_cast<const BooleanCondition*>(condition)) {
+            emit(CONSTANT, on_true, on_false, 0, 0, boolean->value);
+            return true;
+        }
+
+        if (dynamic_cast<const DeadlockCondition*>(condition)) {
+            emit(DEADLOCK, on_true, on_false);
+            return true;
+        }
+
+        // temporal operators below the top, upper bounds and path selections
+        return false;
+    }
+
+    bool CompiledCondition::linearize(const Expr* expr, linear_t& result) const
+    {
+        const auto type = expr->type();
+        if (type == type_id<LiteralExpr>()) {
+            result._constant = static_cast<const LiteralExpr*>(expr)->value();
+            return true;
+        }
+        if (type == type_id<UnfoldedIdentifierExpr>()) {
+            auto id = static_cast<const UnfoldedIdentifierExpr*>(expr);
+            if (id->offset() < 0)
+                return false;
+            result._terms.push_back(term_t{(uint32_t)id->offset(), 1});
+            return true;
+        }
+        if (type == type_id<IdentifierExpr>()) {
+            auto& compiled = static_cast<const IdentifierExpr*>(expr)->compiled();
+            return compiled && linearize(compiled.get(), result);
+        }
+        if (type == type_id<MinusExpr>()) {
+            if (!linearize((*static_cast<const MinusExpr*>(expr))[0].get(), result))
+                return false;
+            result._constant = -result._constant;
+            for (auto& t : result._terms)
+                t._coefficient = -t._coefficient;
+            return true;
+        }
+        if (type == type_id<SubtractExpr>()) {
+            auto sub = static_cast<const SubtractExpr*>(expr);
+            if (!linearize((*sub)[0].get(), result))
+                return false;
+            for (size_t i = 1; i < sub->operands(); ++i) {
+                linear_t operand;
+                if (!linearize((*sub)[i].get(), operand))
+                    return false;
+                result._constant -= operand._constant;
+                for (auto& t : operand._terms)
+                    result._terms.push_back(term_t{t._place, -t._coefficient});
+            }
+            return true;
+        }
+        if (type == type_id<PlusExpr>()) {
+            auto plus = static_cast<const PlusExpr*>(expr);
+            result._constant = plus->constant();
+            for (auto& p : plus->places())
+                result._terms.push_back(term_t{p.first, 1});
+            for (size_t i = 0; i < plus->operands(); ++i) {
+                linear_t operand;
+                if (!linearize((*plus)[i].get(), operand))
+                    return false;
+                result._constant += operand._constant;
+                result._terms.insert(result._terms.end(), operand._terms.begin(), operand._terms.end());
+            }
+            return true;
+        }
+        if (type == type_id<MultiplyExpr>()) {
+            // linear only if at most one factor depends on the marking
+            auto mult = static_cast<const MultiplyExpr*>(expr);
+            int64_t factor = mult->constant();
+            bool linear = false;
+            if (mult->places().size() == 1) {
+                result._terms.push_back(term_t{mult->places().front().first, 1});
+                linear = true;
+            }
+            else if (mult->places().size() > 1)
+                return false;
+            for (size_t i = 0; i < mult->operands(); ++i) {
+                linear_t operand;
+                if (!linearize((*mult)[i].get(), operand))
+                    return false;
+                if (operand._terms.empty()) {
+                    factor *= operand._constant;
+                    continue;
+                }
+                if (linear)
+                    return false;
+                linear = true;
+                result = std::move(operand);
+            }
+            if (!linear) {
+                result._constant = factor;
+                return true;
+            }
+            result._constant *= factor;
+            for (auto& t : result._terms)
+                t._coefficient *= factor;
+            return true;
+        }
+        // path selections and anything else
+        return false;
+    }
+} }
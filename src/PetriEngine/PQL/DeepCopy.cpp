@@ -0,0 +1,285 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PetriEngine/PQL/DeepCopy.h"
+
+namespace PetriEngine { namespace PQL {
+
+    Condition_ptr deepCopy(const Condition_ptr& condition) {
+        DeepCopyVisitor visitor;
+        return visitor.copy(condition);
+    }
+
+    Expr_ptr deepCopy(const Expr_ptr& expr) {
+        DeepCopyVisitor visitor;
+        return visitor.copy(expr);
+    }
+
+    Condition_ptr DeepCopyVisitor::copy(const Condition_ptr& condition) {
+        if (condition == nullptr)
+            return nullptr;
+        Visitor::visit(this, condition);
+        return std::move(_condition);
+    }
+
+    Expr_ptr DeepCopyVisitor::copy(const Expr_ptr& expr) {
+        if (expr == nullptr)
+            return nullptr;
+        Visitor::visit(this, expr);
+        return std::move(_expr);
+    }
+
+    // every node is copied with its annotations, then its children are replaced by copies
+
+    template<typename T>
+    std::shared_ptr<T> DeepCopyVisitor::quantifier(const T* element) {
+        auto c = std::make_shared<T>(*element);
+        c->_cond = copy(element->_cond);
+        return c;
+    }
+
+    template<typename T>
+    std::shared_ptr<T> DeepCopyVisitor::until(const T* element) {
+        auto c = std::make_shared<T>(*element);
+        c->_cond1 = copy(element->_cond1);
+        c->_cond2 = copy(element->_cond2);
+        return c;
+    }
+
+    template<typename T>
+    std::shared_ptr<T> DeepCopyVisitor::logical(const T* element) {
+        auto c = std::make_shared<T>(*element);
+        for (auto& cond : c->_conds)
+            cond = copy(cond);
+        return c;
+    }
+
+    template<typename T>
+    std::shared_ptr<T> DeepCopyVisitor::compare(const T* element) {
+        auto c = std::make_shared<T>(*element);
+        c->_expr1 = copy(element->_expr1);
+        c->_expr2 = copy(element->_expr2);
+        return c;
+    }
+
+    template<typename T>
+    std::shared_ptr<T> DeepCopyVisitor::shallow(const T* element) {
+        auto c = std::make_shared<T>(*element);
+        c->_compiled = copy(element->_compiled);
+        return c;
+    }
+
+    template<typename T>
+    std::shared_ptr<T> DeepCopyVisitor::nary(const T* element) {
+        auto c = std::make_shared<T>(*element);
+        for (auto& expr : c->_exprs)
+            expr = copy(expr);
+        return c;
+    }
+
+    void DeepCopyVisitor::_accept(const NotCondition *element) {
+        auto c = std::make_shared<NotCondition>(*element);
+        c->_cond = copy(element->_cond);
+        _condition = c;
+    }
+
+    void DeepCopyVisitor::_accept(const AndCondition *element) {
+        _condition = logical(element);
+    }
+
+    void DeepCopyVisitor::_accept(const OrCondition *element) {
+        _condition = logical(element);
+    }
+
+    void DeepCopyVisitor::_accept(const LessThanCondition *element) {
+        _condition = compare(element);
+    }
+
+    void DeepCopyVisitor::_accept(const LessThanOrEqualCondition *element) {
+        _condition = compare(element);
+    }
+
+    void DeepCopyVisitor::_accept(const EqualCondition *element) {
+        _condition = compare(element);
+    }
+
+    void DeepCopyVisitor::_accept(const NotEqualCondition *element) {
+        _condition = compare(element);
+    }
+
+    void DeepCopyVisitor::_accept(const DeadlockCondition *element) {
+        _condition = std::make_shared<DeadlockCondition>(*element);
+    }
+
+    void DeepCopyVisitor::_accept(const CompareConjunction *element) {
+        _condition = std::make_shared<CompareConjunction>(*element);
+    }
+
+    void DeepCopyVisitor::_accept(const UnfoldedUpperBoundsCondition *element) {
+        _condition = std::make_shared<UnfoldedUpperBoundsCondition>(*element);
+    }
+
+    void DeepCopyVisitor::_accept(const BooleanCondition *element) {
+        _condition = std::make_shared<BooleanCondition>(*element);
+    }
+
+    void DeepCopyVisitor::_accept(const ControlCondition *condition) {
+        _condition = quantifier(condition);
+    }
+
+    void DeepCopyVisitor::_accept(const EFCondition *condition) {
+        _condition = quantifier(condition);
+    }
+
+    void DeepCopyVisitor::_accept(const EGCondition *condition) {
+        _condition = quantifier(condition);
+    }
+
+    void DeepCopyVisitor::_accept(const AGCondition *condition) {
+        _condition = quantifier(condition);
+    }
+
+    void DeepCopyVisitor::_accept(const AFCondition *condition) {
+        _condition = quantifier(condition);
+    }
+
+    void DeepCopyVisitor::_accept(const EXCondition *condition) {
+        _condition = quantifier(condition);
+    }
+
+    void DeepCopyVisitor::_accept(const AXCondition *condition) {
+        _condition = quantifier(condition);
+    }
+
+    void DeepCopyVisitor::_accept(const EUCondition *condition) {
+        _condition = until(condition);
+    }
+
+    void DeepCopyVisitor::_accept(const AUCondition *condition) {
+        _condition = until(condition);
+    }
+
+    void DeepCopyVisitor::_accept(const ACondition *condition) {
+        _condition = quantifier(condition);
+    }
+
+    void DeepCopyVisitor::_accept(const ECondition *condition) {
+        _condition = quantifier(condition);
+    }
+
+    void DeepCopyVisitor::_accept(const GCondition *condition) {
+        _condition = quantifier(condition);
+    }
+
+    void DeepCopyVisitor::_accept(const FCondition *condition) {
+        _condition = quantifier(condition);
+    }
+
+    void DeepCopyVisitor::_accept(const XCondition *condition) {
+        _condition = quantifier(condition);
+    }
+
+    void DeepCopyVisitor::_accept(const UntilCondition *condition) {
+        _condition = until(condition);
+    }
+
+    void DeepCopyVisitor::_accept(const AllPaths *element) {
+        auto c = std::make_shared<AllPaths>(*element);
+        c->_child = copy(element->_child);
+        _condition = c;
+    }
+
+    void DeepCopyVisitor::_accept(const ExistPath *element) {
+        auto c = std::make_shared<ExistPath>(*element);
+        c->_child = copy(element->_child);
+        _condition = c;
+    }
+
+    void DeepCopyVisitor::_accept(const PathSelectCondition *element) {
+        auto c = std::make_shared<PathSelectCondition>(*element);
+        c->_child = copy(element->_child);
+        _condition = c;
+    }
+
+    void DeepCopyVisitor::_accept(const UnfoldedFireableCondition *element) {
+        _condition = shallow(element);
+    }
+
+    void DeepCopyVisitor::_accept(const FireableCondition *element) {
+        _condition = shallow(element);
+    }
+
+    void DeepCopyVisitor::_accept(const UpperBoundsCondition *element) {
+        _condition = shallow(element);
+    }
+
+    void DeepCopyVisitor::_accept(const LivenessCondition *element) {
+        _condition = shallow(element);
+    }
+
+    void DeepCopyVisitor::_accept(const KSafeCondition *element) {
+        auto c = shallow(element);
+        c->_bound = copy(element->_bound);
+        _condition = c;
+    }
+
+    void DeepCopyVisitor::_accept(const QuasiLivenessCondition *element) {
+        _condition = shallow(element);
+    }
+
+    void DeepCopyVisitor::_accept(const StableMarkingCondition *element) {
+        _condition = shallow(element);
+    }
+
+    void DeepCopyVisitor::_accept(const UnfoldedIdentifierExpr *element) {
+        _expr = std::make_shared<UnfoldedIdentifierExpr>(*element);
+    }
+
+    void DeepCopyVisitor::_accept(const LiteralExpr *element) {
+        _expr = std::make_shared<LiteralExpr>(*element);
+    }
+
+    void DeepCopyVisitor::_accept(const PlusExpr *element) {
+        _expr = nary(element);
+    }
+
+    void DeepCopyVisitor::_accept(const MultiplyExpr *element) {
+        _expr = nary(element);
+    }
+
+    void DeepCopyVisitor::_accept(const MinusExpr *element) {
+        auto c = std::make_shared<MinusExpr>(*element);
+        c->_expr = copy(element->_expr);
+        _expr = c;
+    }
+
+    void DeepCopyVisitor::_accept(const SubtractExpr *element) {
+        _expr = nary(element);
+    }
+
+    void DeepCopyVisitor::_accept(const IdentifierExpr *element) {
+        auto c = std::make_shared<IdentifierExpr>(*element);
+        c->_compiled = copy(element->_compiled);
+        _expr = c;
+    }
+
+    void DeepCopyVisitor::_accept(const PathSelectExpr *element) {
+        auto c = std::make_shared<PathSelectExpr>(*element);
+        c->_child = copy(element->_child);
+        _expr = c;
+    }
+} }
@@ -0,0 +1,244 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PetriEngine/PQL/IncrementalDistance.h"
+#include "PetriEngine/PQL/Expressions.h"
+#include "PetriEngine/PetriNet.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace PetriEngine { namespace PQL {
+
+    IncrementalDistance::IncrementalDistance(const PetriNet& net, const Condition* query)
+    : _net(net), _query(query)
+    {
+        _leaves.resize(net.numberOfPlaces());
+        uint32_t root;
+        _valid = query != nullptr && build(query, false, root);
+        if (!_valid) {
+            _nodes.clear();
+            _children.clear();
+            _leaves.clear();
+            return;
+        }
+        _parents.resize(_nodes.size(), std::numeric_limits<uint32_t>::max());
+        for (uint32_t n = 0; n < _nodes.size(); ++n) {
+            for (uint32_t c = _nodes[n]._first; c < _nodes[n]._last; ++c)
+                _parents[_children[c]] = n;
+        }
+        _affected.resize(net.numberOfTransitions());
+        _known.resize(net.numberOfTransitions(), false);
+        _parent.resize(_nodes.size(), 0);
+        _values.resize(_nodes.size(), 0);
+    }
+
+    uint32_t IncrementalDistance::prepare(const MarkVal* marking)
+    {
+        for (uint32_t n = 0; n < _nodes.size(); ++n)
+            _values[n] = compute(_nodes[n], marking);
+        _parent = _values;
+        return _values.back();
+    }
+
+    uint32_t IncrementalDistance::distance(const MarkVal* marking, uint32_t t)
+    {
+        auto& nodes = affected(t);
+        for (auto n : nodes)
+            _values[n] = compute(_nodes[n], marking);
+        const uint32_t result = _values.back();
+        for (auto n : nodes)
+            _values[n] = _parent[n];
+        return result;
+    }
+
+    uint32_t IncrementalDistance::compute(const node_t& node, const MarkVal* marking) const
+    {
+        switch (node._kind) {
+            case LEAF: {
+                DistanceContext context(&_net, marking);
+                if (node._negated)
+                    context.negate();
+                return node._leaf->distance(context);
+            }
+            case SUM: {
+                // wraps around like the sums of Condition::distance
+                uint32_t val = 0;
+                for (uint32_t c = node._first; c < node._last; ++c)
+                    val += _values[_children[c]];
+                return val;
+            }
+            default: {
+                uint32_t val = std::numeric_limits<uint32_t>::max();
+                for (uint32_t c = node._first; c < node._last; ++c)
+                    val = std::min(val, _values[_children[c]]);
+                return val;
+            }
+        }
+    }
+
+    const std::vector<uint32_t>& IncrementalDistance::affected(uint32_t t)
+    {
+        if (_known[t])
+            return _affected[t];
+        _known[t] = true;
+
+        // the places whose marking is changed by t
+        std::vector<std::pair<uint32_t, int64_t>> change;
+        auto pre = _net.preset(t);
+        for (; pre.first != pre.second; ++pre.first) {
+            if (!pre.first->inhibitor)
+                change.emplace_back(pre.first->place, -(int64_t)pre.first->tokens);
+        }
+        auto post = _net.postset(t);
+        for (; post.first != post.second; ++post.first)
+            change.emplace_back(post.first->place, post.first->tokens);
+        std::sort(change.begin(), change.end());
+
+        std::vector<bool> marked(_nodes.size(), false);
+        for (size_t i = 0; i < change.size();) {
+            const uint32_t place = change[i].first;
+            int64_t delta = 0;
+            for (; i < change.size() && change[i].first == place; ++i)
+                delta += change[i].second;
+            if (delta == 0)
+                continue;
+            for (auto n : _leaves[place]) {
+                // the ancestors of a marked node are marked already
+                for (; n != std::numeric_limits<uint32_t>::max() && !marked[n]; n = _parents[n])
+                    marked[n] = true;
+            }
+        }
+        for (uint32_t n = 0; n < _nodes.size(); ++n) {
+            if (marked[n])
+                _affected[t].push_back(n);
+        }
+        return _affected[t];
+    }
+
+    void IncrementalDistance::addLeaf(const Condition* condition, bool negated, std::vector<uint32_t>&& places, uint32_t& node)
+    {
+        node = _nodes.size();
+        _nodes.push_back(node_t{LEAF, negated, condition, 0, 0});
+        std::sort(places.begin(), places.end());
+        places.erase(std::unique(places.begin(), places.end()), places.end());
+        for (auto p : places)
+            _leaves[p].push_back(node);
+    }
+
+    bool IncrementalDistance::build(const Condition* condition, bool negated, uint32_t& node)
+    {
+        if (auto shallow = dynamic_cast<const ShallowCondition*>(condition))
+            return shallow->getCompiled() && build(shallow->getCompiled().get(), negated, node);
+
+        if (auto neg = dynamic_cast<const NotCondition*>(condition))
+            return build((*neg)[0].get(), !negated, node);
+
+        const auto type = condition->type();
+        if (type == type_id<EFCondition>() || type == type_id<EGCondition>() || type == type_id<EXCondition>() ||
+            type == type_id<ACondition>() || type == type_id<FCondition>() || type == type_id<XCondition>())
+            return build((*static_cast<const SimpleQuantifierCondition*>(condition))[0].get(), negated, node);
+        if (type == type_id<AFCondition>() || type == type_id<AXCondition>() ||
+            type == type_id<AGCondition>() || type == type_id<GCondition>())
+            return build((*static_cast<const SimpleQuantifierCondition*>(condition))[0].get(), !negated, node);
+        if (type == type_id<EUCondition>() || type == type_id<UntilCondition>())
+            return build((*static_cast<const UntilCondition*>(condition))[1].get(), negated, node);
+
+        std::vector<uint32_t> children;
+        kind_t kind;
+        if (type == type_id<AUCondition>()) {
+            auto until = static_cast<const UntilCondition*>(condition);
+            for (size_t i = 0; i < 2; ++i) {
+                uint32_t child;
+                if (!build((*until)[i].get(), !negated, child))
+                    return false;
+                children.push_back(child);
+            }
+            kind = SUM;
+        }
+        else if (auto logical = dynamic_cast<const LogicalCondition*>(condition)) {
+            for (auto& c : *logical) {
+                uint32_t child;
+                if (!build(c.get(), negated, child))
+                    return false;
+                children.push_back(child);
+            }
+            const bool conjunction = type == type_id<AndCondition>();
+            kind = conjunction != negated ? SUM : MIN;
+        }
+        else if (auto conj = dynamic_cast<const CompareConjunction*>(condition)) {
+            std::vector<uint32_t> ps;
+            for (auto& c : conj->constraints())
+                ps.push_back(c._place);
+            addLeaf(condition, negated, std::move(ps), node);
+            return true;
+        }
+        else if (auto compare = dynamic_cast<const CompareCondition*>(condition)) {
+            std::vector<uint32_t> ps;
+            if (!places((*compare)[0].get(), ps) || !places((*compare)[1].get(), ps))
+                return false;
+            addLeaf(condition, negated, std::move(ps), node);
+            return true;
+        }
+        else if (type == type_id<BooleanCondition>() || type == type_id<DeadlockCondition>()) {
+            addLeaf(condition, negated, {}, node);
+            return true;
+        }
+        else {
+            // upper bounds depend on more than the marking, and E has no distance
+            return false;
+        }
+
+        node = _nodes.size();
+        _nodes.push_back(node_t{kind, negated, nullptr, (uint32_t)_children.size(), (uint32_t)(_children.size() + children.size())});
+        _children.insert(_children.end(), children.begin(), children.end());
+        return true;
+    }
+
+    bool IncrementalDistance::places(const Expr* expr, std::vector<uint32_t>& places) const
+    {
+        const auto type = expr->type();
+        if (type == type_id<LiteralExpr>())
+            return true;
+        if (type == type_id<UnfoldedIdentifierExpr>()) {
+            auto id = static_cast<const UnfoldedIdentifierExpr*>(expr);
+            if (id->offset() < 0 || (uint32_t)id->offset() >= _net.numberOfPlaces())
+                return false;
+            places.push_back(id->offset());
+            return true;
+        }
+        if (type == type_id<IdentifierExpr>()) {
+            auto& compiled = static_cast<const IdentifierExpr*>(expr)->compiled();
+            return compiled && this->places(compiled.get(), places);
+        }
+        if (type == type_id<MinusExpr>())
+            return this->places((*static_cast<const MinusExpr*>(expr))[0].get(), places);
+        if (auto commutative = dynamic_cast<const CommutativeExpr*>(expr)) {
+            for (auto& p : commutative->places())
+                places.push_back(p.first);
+        }
+        if (auto nary = dynamic_cast<const NaryExpr*>(expr)) {
+            for (auto& e : nary->expressions()) {
+                if (!this->places(e.get(), places))
+                    return false;
+            }
+            return true;
+        }
+        // path selections
+        return false;
+    }
+} }
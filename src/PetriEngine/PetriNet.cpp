@@ -177,6 +177,23 @@ namespace PetriEngine {
         }
     }
 
+    void PetriNet::constructConsumers()
+    {
+        _consumerPtrs.assign(_nplaces + 1, 0);
+        for (uint32_t t = 0; t < _ntransitions; ++t) {
+            for (uint32_t i = _transitions[t].inputs; i < _transitions[t].outputs; ++i)
+                ++_consumerPtrs[_invariants[i].place + 1];
+        }
+        for (uint32_t p = 0; p < _nplaces; ++p)
+            _consumerPtrs[p + 1] += _consumerPtrs[p];
+        _consumers.resize(_consumerPtrs[_nplaces]);
+        std::vector<uint32_t> next(_consumerPtrs.begin(), _consumerPtrs.end() - 1);
+        for (uint32_t t = 0; t < _ntransitions; ++t) {
+            for (uint32_t i = _transitions[t].inputs; i < _transitions[t].outputs; ++i)
+                _consumers[next[_invariants[i].place]++] = t;
+        }
+    }
+
     void PetriNet::toXML(std::ostream& out)
     {
         out << "<?xml version=\"1.0\"?>\n"
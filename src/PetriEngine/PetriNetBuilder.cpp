@@ -42,6 +42,8 @@ namespace PetriEngine {
     : _placenames(other._placenames), _transitionnames(other._transitionnames),
        _placelocations(other._placelocations), _transitionlocations(other._transitionlocations),
        _transitions(other._transitions), _places(other._places),
+       _originalNumberOfPlaces(other._originalNumberOfPlaces),
+       _originalNumberOfTransitions(other._originalNumberOfTransitions),
        initialMarking(other.initialMarking), reducer(this), _string_set(other._string_set)
     {
 
@@ -476,6 +478,7 @@ namespace PetriEngine {
             }
         }
         net->sort();
+        net->constructConsumers();
 
         for(size_t t = 0; t < net->numberOfTransitions(); ++t)
         {
@@ -584,4 +587,29 @@ namespace PetriEngine {
         reducer.saveInitialNet();
     }
 
+    void PetriNetBuilder::clear()
+    {
+        _placenames.clear();
+        _transitionnames.clear();
+        _placelocations.clear();
+        _transitionlocations.clear();
+        _transitions.clear();
+        _places.clear();
+        initialMarking.clear();
+        reducer = Reducer(this);
+    }
+
+    void PetriNetBuilder::takeNet(PetriNetBuilder&& other)
+    {
+        _placenames = std::move(other._placenames);
+        _transitionnames = std::move(other._transitionnames);
+        _placelocations = std::move(other._placelocations);
+        _transitionlocations = std::move(other._transitionlocations);
+        _transitions = std::move(other._transitions);
+        _places = std::move(other._places);
+        initialMarking = std::move(other.initialMarking);
+        reducer = Reducer(this);
+        reducer.copyTraces(other.reducer);
+    }
+
 } // PetriEngine
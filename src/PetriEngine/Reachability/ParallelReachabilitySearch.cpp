@@ -0,0 +1,115 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "PetriEngine/Reachability/ParallelReachabilitySearch.h"
+#include "PetriEngine/PQL/PredicateCheckers.h"
+
+#include <algorithm>
+
+using namespace PetriEngine::PQL;
+using namespace PetriEngine::Structures;
+
+namespace PetriEngine {
+    namespace Reachability {
+
+        bool ParallelReachabilitySearch::checkQueriesShared(std::vector<std::shared_ptr<PQL::Condition > >& queries,
+                                              std::vector<ResultPrinter::Result>& results,
+                                              State& state, searchstate_t& ss,
+                                              SharedStateSet& shared,
+                                              Structures::StateSetInterface* states)
+        {
+            if(!ss.usequeries) return false;
+
+            for(size_t i = 0; i < queries.size(); ++i)
+            {
+                if(_decided[i] || !satisfies(queries, i, state, ss))
+                    continue;
+
+                std::lock_guard<std::mutex> guard(_result_lock);
+                if(results[i] != ResultPrinter::Unknown)
+                    continue;
+                auto r = _callback.handle(i, queries[i].get(), ResultPrinter::Satisfied, &states->maxPlaceBound(),
+                                          _expanded, _explored, shared.discovered(), states->maxTokens(),
+                                          states, 0, _initial.marking(), false);
+                results[i] = r.first;
+                _decided[i] = true;
+                if(r.second || --_undecided == 0)
+                {
+                    _stop = true;
+                    return true;
+                }
+            }
+
+            nextHeuristicQuery(ss, queries.size(), [&](size_t q) { return _decided[q].load(); });
+            return _stop;
+        }
+
+#define TRYREACHPAR_MC    (queries, results, usequeries, printstats, seed, initPotencies)
+#define TRYREACH_MC(X)    if(stubbornreduction) return tryReachParallel<X, ReducingSuccessorGenerator> TRYREACHPAR_MC ; \
+                          else return tryReachParallel<X, SuccessorGenerator> TRYREACHPAR_MC ;
+
+        bool ParallelReachabilitySearch::search(
+                    std::vector<std::shared_ptr<PQL::Condition > >& queries,
+                    std::vector<ResultPrinter::Result>& results,
+                    Strategy strategy,
+                    bool stubbornreduction,
+                    bool statespacesearch,
+                    StatisticsLevel printstats,
+                    bool keep_trace,
+                    size_t seed,
+                    int64_t depthRandomWalk,
+                    const int64_t incRandomWalk,
+                    const std::vector<MarkVal>& initPotencies)
+        {
+            // traces require a single parent per marking and upper-bounds are
+            // recorded inside the query objects; leave these and the approximate
+            // and external passed-lists to the sequential search
+            bool sequential = _cores <= 1 || keep_trace || strategy == Strategy::RandomWalk ||
+                _compaction != StateCompaction::None || !_external_directory.empty() ||
+                std::any_of(queries.begin(), queries.end(), [](auto& q) { return containsUpperBounds(q); });
+            if(sequential)
+                return ReachabilitySearch::search(queries, results, strategy, stubbornreduction,
+                                                  statespacesearch, printstats, keep_trace, seed,
+                                                  depthRandomWalk, incRandomWalk, initPotencies);
+
+            bool usequeries = !statespacesearch;
+
+            // if we are searching for bounds
+            if(!usequeries) strategy = Strategy::BFS;
+
+            switch(strategy)
+            {
+                case Strategy::DFS:
+                    TRYREACH_MC(DFSQueue)
+                    break;
+                case Strategy::BFS:
+                    TRYREACH_MC(BFSQueue)
+                    break;
+                case Strategy::HEUR:
+                    TRYREACH_MC(HeuristicQueue)
+                    break;
+                case Strategy::RDFS:
+                    TRYREACH_MC(RDFSQueue)
+                    break;
+                case Strategy::RPFS:
+                    TRYREACH_MC(RandomPotencyQueue)
+                    break;
+                default:
+                    throw base_error("Unsupported search strategy");
+            }
+        }
+    }
+}
@@ -0,0 +1,185 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "PetriEngine/Reachability/PortfolioSearch.h"
+#include "PetriEngine/Reachability/ReachabilitySearch.h"
+#include "PetriEngine/TAR/TARReachability.h"
+#include "PetriEngine/STSolver.h"
+#include "PetriEngine/PQL/Contexts.h"
+#include "PetriEngine/PQL/DeepCopy.h"
+#include "PetriEngine/PQL/Expressions.h"
+#include "PetriEngine/PQL/Simplifier.h"
+#include "PetriEngine/Simplification/LPCache.h"
+#include "utils/MemoryBudget.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <thread>
+
+using namespace PetriEngine::PQL;
+
+namespace PetriEngine {
+    namespace Reachability {
+
+        // the LP member has nothing else to do, so it gets a multiple of the usual budgets
+        constexpr uint32_t LP_BUDGET_SCALE = 4;
+
+        std::pair<AbstractHandler::Result, bool> PortfolioSearch::Handler::handle(
+            size_t index, PQL::Condition* query, Result result, const std::vector<uint32_t>* maxPlaceBound,
+            size_t expandedStates, size_t exploredStates, size_t discoveredStates,
+            int maxTokens, Structures::StateSetInterface* stateset, size_t lastmarking, const MarkVal* initialMarking, bool trace)
+        {
+            if (result != Satisfied && result != NotSatisfied)
+                return std::make_pair(result, false);
+
+            std::lock_guard<std::mutex> guard(_race._result_lock);
+            if (_race._winner == nullptr) {
+                // the members see a single query, report it under its real index
+                _race._winner = _name;
+                _race._result = _target.handle(_index, query, result, maxPlaceBound, expandedStates, exploredStates,
+                                               discoveredStates, maxTokens, stateset, lastmarking, initialMarking, false).first;
+                _race._abort = true;
+            }
+            return std::make_pair(_race._result, true);
+        }
+
+        void PortfolioSearch::solve(std::vector<std::shared_ptr<PQL::Condition> >& queries,
+                                    std::vector<ResultPrinter::Result>& results)
+        {
+            for (size_t i = 0; i < queries.size(); ++i) {
+                if (results[i] == ResultPrinter::Unknown)
+                    results[i] = race(i, queries[i]);
+            }
+        }
+
+        ResultPrinter::Result PortfolioSearch::race(size_t index, const std::shared_ptr<PQL::Condition>& query)
+        {
+            race_t race;
+            std::vector<std::unique_ptr<Handler>> handlers;
+            std::vector<std::function<void(AbstractHandler&)>> members;
+            auto add = [&](const char* name, std::function<void(AbstractHandler&)> member) {
+                handlers.emplace_back(std::make_unique<Handler>(race, _printer, index, name));
+                members.emplace_back(std::move(member));
+            };
+
+            auto explicitSearch = [&](Strategy strategy, size_t seed) {
+                return [&, strategy, seed](AbstractHandler& handler) {
+                    std::vector<PQL::Condition_ptr> qs{deepCopy(query)};
+                    std::vector<ResultPrinter::Result> res(1, ResultPrinter::Unknown);
+                    ReachabilitySearch search(_net, handler, _options.kbound);
+                    search.setAbort(&race._abort);
+                    search.reachable(qs, res, strategy, _options.stubbornreduction, false,
+                                     StatisticsLevel::None, false, seed,
+                                     _options.depthRandomWalk, _options.incRandomWalk);
+                };
+            };
+            add("heuristic search", explicitSearch(Strategy::HEUR, _options.seed()));
+            add("random walk", explicitSearch(Strategy::RandomWalk, _options.seed()));
+
+            if (_net.numberOfPlaces() > 0 && !_net.has_inhibitor()) {
+                add("trace abstraction refinement", [&](AbstractHandler& handler) {
+                    std::vector<PQL::Condition_ptr> qs{deepCopy(query)};
+                    std::vector<ResultPrinter::Result> res(1, ResultPrinter::Unknown);
+                    TARReachabilitySearch search(handler, _net, _reducer, _options.kbound);
+                    search.setAbort(&race._abort);
+                    search.reachable(qs, res, StatisticsLevel::None, false);
+                });
+            }
+
+            if (dynamic_cast<DeadlockCondition*>(query.get()) != nullptr) {
+                add("siphon-trap analysis", [&](AbstractHandler& handler) {
+                    auto q = deepCopy(query);
+                    STSolver solver(handler, _net, q.get(), _options.siphonDepth);
+                    solver.setAbort(&race._abort);
+                    solver.solve(_options.siphontrapTimeout > 0 ? _options.siphontrapTimeout
+                                                                : std::numeric_limits<uint32_t>::max());
+                    solver.printResult();
+                });
+            }
+
+            if (_options.queryReductionTimeout > 0) {
+                add("linear over-approximation", [&](AbstractHandler& handler) {
+                    std::unique_ptr<MarkVal[]> m0(_net.makeInitialMarking());
+                    Simplification::LPCache cache;
+                    SimplificationContext context(m0.get(), &_net,
+                                                  _options.queryReductionTimeout * LP_BUDGET_SCALE,
+                                                  _options.lpsolveTimeout * LP_BUDGET_SCALE, &cache);
+                    if (context.markingOutOfBounds())
+                        return;
+                    context.setAbort(&race._abort);
+                    auto q = deepCopy(query);
+                    auto simplified = PQL::simplify(std::make_shared<EFCondition>(q), context);
+                    if (simplified.formula->isTriviallyTrue())
+                        handler.handle(0, q.get(), ResultPrinter::Satisfied);
+                    else if (simplified.formula->isTriviallyFalse())
+                        handler.handle(0, q.get(), ResultPrinter::NotSatisfied);
+                });
+            }
+
+            std::exception_ptr error = nullptr;
+            std::mutex lock;
+            std::condition_variable finished;
+            size_t running = members.size();
+            auto run = [&](size_t id) {
+                try {
+                    members[id](*handlers[id]);
+                } catch (...) {
+                    std::lock_guard<std::mutex> guard(lock);
+                    if (error == nullptr)
+                        error = std::current_exception();
+                    race._abort = true;
+                }
+                std::lock_guard<std::mutex> guard(lock);
+                --running;
+                finished.notify_all();
+            };
+
+            const size_t baseline = MemoryBudget::resident();
+            const size_t budget = _options.portfolioMemory * 1024 * 1024;
+            bool exceeded = false;
+            std::vector<std::thread> threads;
+            for (size_t i = 0; i < members.size(); ++i)
+                threads.emplace_back(run, i);
+            {
+                // watch the memory of the race until all members are done
+                std::unique_lock<std::mutex> guard(lock);
+                while (!finished.wait_for(guard, std::chrono::milliseconds(50), [&] { return running == 0; })) {
+                    if (budget > 0 && !race._abort && MemoryBudget::resident() > baseline + budget) {
+                        exceeded = true;
+                        race._abort = true;
+                    }
+                }
+            }
+            for (auto& t : threads)
+                t.join();
+            if (error != nullptr)
+                std::rethrow_exception(error);
+
+            if (_options.printstatistics == StatisticsLevel::Full) {
+                if (race._winner != nullptr)
+                    std::cout << "Query solved by " << race._winner << " in the portfolio." << std::endl << std::endl;
+                else if (exceeded)
+                    std::cout << "Portfolio exceeded its memory budget of " << _options.portfolioMemory
+                              << " MB." << std::endl << std::endl;
+            }
+            return race._result;
+        }
+    }
+}
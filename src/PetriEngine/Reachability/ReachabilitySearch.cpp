@@ -32,6 +32,19 @@ using namespace PetriEngine::Structures;
 namespace PetriEngine {
     namespace Reachability {
 
+        bool ReachabilitySearch::satisfies(std::vector<std::shared_ptr<PQL::Condition > >& queries, size_t i,
+                                           State& state, searchstate_t& ss)
+        {
+            if(ss.compiled.size() != queries.size())
+            {
+                ss.compiled.clear();
+                for(auto& q : queries)
+                    ss.compiled.emplace_back(q.get());
+            }
+            EvaluationContext ec(state.marking(), &_net);
+            return PetriEngine::PQL::evaluate(ss.compiled[i], queries[i].get(), ec) == Condition::RTRUE;
+        }
+
         bool ReachabilitySearch::checkQueries(std::vector<std::shared_ptr<PQL::Condition > >& queries,
                                               std::vector<ResultPrinter::Result>& results,
                                               State& state, searchstate_t& ss,
@@ -44,8 +57,7 @@ namespace PetriEngine {
             {
                 if(results[i] == ResultPrinter::Unknown)
                 {
-                    EvaluationContext ec(state.marking(), &_net);
-                    if(PetriEngine::PQL::evaluate(queries[i].get(), ec) == Condition::RTRUE)
+                    if(satisfies(queries, i, state, ss))
                     {
                         auto r = doCallback(queries[i], i, ResultPrinter::Satisfied, ss, states);
                         results[i] = r.first;
@@ -57,20 +69,8 @@ namespace PetriEngine {
                         alldone = false;
                     }
                 }
-                if( i == ss.heurquery &&
-                    results[i] != ResultPrinter::Unknown)
-                {
-                    if(queries.size() >= 2)
-                    {
-                        for(size_t n = 1; n < queries.size(); ++n)
-                        {
-                            ss.heurquery = (ss.heurquery + n) % queries.size();
-                            if(results[i] == ResultPrinter::Unknown)
-                                break;
-                        }
-                    }
-                }
             }
+            nextHeuristicQuery(ss, queries.size(), [&](size_t q) { return results[q] != ResultPrinter::Unknown; });
             return alldone;
         }
 
@@ -97,6 +97,20 @@ namespace PetriEngine {
                         << "\texpanded states:   " << ss.expandedStates << std::endl
                         << "\tmax tokens:        " << states->maxTokens() << std::endl;
 
+            if (auto* approx = dynamic_cast<Structures::ApproximateStateSet*>(states)) {
+                std::cout << "\tstored states:     " << approx->size()
+                          << (approx->bitstate() ? " (bitstate)" : " (hash compaction)") << std::endl
+                          << "\ttable fill:        " << approx->fill() * 100 << "%"
+                          << (approx->full() ? " (full, new states were dropped)" : "") << std::endl
+                          << "\texpected omitted states: " << approx->expectedOmissions() << std::endl
+                          << "\tprobability of omission: " << approx->omissionProbability() << std::endl;
+            }
+            if (auto* external = dynamic_cast<Structures::ExternalStateSet*>(states)) {
+                std::cout << "\tstored states:     " << external->size() << " (external)" << std::endl
+                          << "\tlayers:            " << external->layers() << std::endl
+                          << "\tmax disk usage:    " << external->diskUsage() << " bytes" << std::endl;
+            }
+
             if (statisticsLevel != StatisticsLevel::Full)
                 return;
 
@@ -129,6 +143,8 @@ namespace PetriEngine {
 
 #define TRYREACHPAR    (queries, results, usequeries, printstats, seed, initPotencies)
 #define TEMPPAR(X, Y)  if(keep_trace) return tryReach<X, Structures::TracableStateSet, Y> TRYREACHPAR ; \
+                       else if(_compaction != StateCompaction::None) return tryReach<X, Structures::ApproximateStateSet, Y> TRYREACHPAR ; \
+                       else if(_marking_store) return tryReach<X, Structures::MarkingStoreStateSet, Y> TRYREACHPAR ; \
                        else return tryReach<X, Structures::StateSet, Y> TRYREACHPAR ;
 #define TRYREACH(X)    if(stubbornreduction) TEMPPAR(X, ReducingSuccessorGenerator) \
                        else TEMPPAR(X, SuccessorGenerator)
@@ -155,12 +171,73 @@ namespace PetriEngine {
                     int64_t depthRandomWalk,
                     const int64_t incRandomWalk,
                     const std::vector<MarkVal>& initPotencies)
+        {
+            _memory_exceeded = false;
+            _memory_stopped = false;
+            bool res = search(queries, results, strategy, stubbornreduction, statespacesearch, printstats,
+                              keep_trace, seed, depthRandomWalk, incRandomWalk, initPotencies);
+            // the sequential searches continue in a passed-list needing less memory themselves, see explore;
+            // a parallel search cannot hand over the waiting-lists of its workers, so it is restarted,
+            // keeping the queries decided so far
+            while (_memory_exceeded && !aborted()) {
+                _memory_exceeded = false;
+                auto policy = memoryPolicy(keep_trace, statespacesearch);
+                _callback.memoryExceeded(policy);
+                if (policy == MemoryPolicy::Stop) {
+                    _memory_stopped = true;
+                    break;
+                }
+                // if the budget is exceeded again we stop
+                _memory_policy = MemoryPolicy::Stop;
+                if (policy == MemoryPolicy::Compact) {
+                    _compaction = StateCompaction::Hash;
+                    _bitstate_bytes = std::max<size_t>(MemoryBudget::limit() / 4, 1);
+                }
+                else
+                    setExternalMemory(_spill_directory, std::max<size_t>(MemoryBudget::limit() / 4, 1));
+                MemoryBudget::reset();
+                res = search(queries, results, strategy, stubbornreduction, statespacesearch, printstats,
+                             keep_trace, seed, depthRandomWalk, incRandomWalk, initPotencies);
+            }
+            return res;
+        }
+
+        MemoryPolicy ReachabilitySearch::memoryPolicy(bool keep_trace, bool statespacesearch) const
+        {
+            if (keep_trace || _compaction != StateCompaction::None || !_external_directory.empty())
+                return MemoryPolicy::Stop;
+            if (_memory_policy == MemoryPolicy::Compact && statespacesearch)
+                return MemoryPolicy::Stop;
+            return _memory_policy;
+        }
+
+        bool ReachabilitySearch::search(
+                    std::vector<std::shared_ptr<PQL::Condition > >& queries,
+                    std::vector<ResultPrinter::Result>& results,
+                    Strategy strategy,
+                    bool stubbornreduction,
+                    bool statespacesearch,
+                    StatisticsLevel printstats,
+                    bool keep_trace,
+                    size_t seed,
+                    int64_t depthRandomWalk,
+                    const int64_t incRandomWalk,
+                    const std::vector<MarkVal>& initPotencies)
         {
             bool usequeries = !statespacesearch;
 
             // if we are searching for bounds
             if(!usequeries) strategy = Strategy::BFS;
 
+            // the external passed-list detects duplicates a layer at a time, so the search is breadth-first
+            if(!_external_directory.empty() && strategy != Strategy::RandomWalk)
+            {
+                if(stubbornreduction)
+                    return tryReach<BFSQueue, Structures::ExternalStateSet, ReducingSuccessorGenerator> TRYREACHPAR ;
+                else
+                    return tryReach<BFSQueue, Structures::ExternalStateSet, SuccessorGenerator> TRYREACHPAR ;
+            }
+
             switch(strategy)
             {
                 case Strategy::DFS:
@@ -161,6 +161,24 @@ namespace PetriEngine {
             return std::make_pair(retval, false);
         }
 
+        void ResultPrinter::memoryExceeded(MemoryPolicy policy)
+        {
+            std::cout << "\nMemory budget of " << options->maxMemory << " MB exceeded; ";
+            switch (policy) {
+                case MemoryPolicy::Compact:
+                    std::cout << "continuing the search with hash compaction, "
+                              << "so only satisfiable reachability queries can be decided.\n" << std::endl;
+                    break;
+                case MemoryPolicy::Spill:
+                    std::cout << "continuing the search with the states on disk in "
+                              << options->spillDirectory << ".\n" << std::endl;
+                    break;
+                case MemoryPolicy::Stop:
+                    std::cout << "stopping the search, the remaining queries are UNKNOWN.\n" << std::endl;
+                    break;
+            }
+        }
+
         std::string ResultPrinter::printTechniques() {
             std::string out;
 
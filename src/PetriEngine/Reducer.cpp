@@ -167,12 +167,15 @@ namespace PetriEngine {
     {
         Transition& trans = getTransition(t);
         assert(!trans.skip);
+        touchTransition(t);
         for(auto p : trans.post)
         {
+            touchPlace(p.place);
             eraseTransition(parent->_places[p.place].producers, t);
         }
         for(auto p : trans.pre)
         {
+            touchPlace(p.place);
             eraseTransition(parent->_places[p.place].consumers, t);
         }
         trans.post.clear();
@@ -188,8 +191,10 @@ namespace PetriEngine {
         Place& pl = parent->_places[place];
         assert(!pl.skip);
         pl.skip = true;
+        touchPlace(place);
         for(auto& t : pl.consumers)
         {
+            touchTransition(t);
             Transition& trans = getTransition(t);
             auto ait = getInArc(place, trans);
             if(ait != trans.pre.end() && ait->place == place)
@@ -198,6 +203,7 @@ namespace PetriEngine {
 
         for(auto& t : pl.producers)
         {
+            touchTransition(t);
             Transition& trans = getTransition(t);
             auto ait = getOutArc(trans, place);
             if(ait != trans.post.end() && ait->place == place)
@@ -213,6 +219,7 @@ namespace PetriEngine {
         Place& place = parent->_places[p];
         Transition& trans = parent->_transitions[t];
 
+        touchArc(p, t);
         eraseTransition(place.consumers, t);
 
         Arc a;
@@ -228,6 +235,7 @@ namespace PetriEngine {
         Place& place = parent->_places[p];
         Transition& trans = parent->_transitions[t];
 
+        touchArc(p, t);
         eraseTransition(place.producers, t);
 
         Arc a;
@@ -238,6 +246,62 @@ namespace PetriEngine {
         assert(consistent());
     }
 
+    void Reducer::touchPlace(uint32_t place)
+    {
+        if(place >= _pchanged.size())
+            _pchanged.resize(parent->_places.size(), _generation);
+        _pchanged[place] = _generation;
+    }
+
+    void Reducer::touchTransition(uint32_t transition)
+    {
+        if(transition >= _tchanged.size())
+            _tchanged.resize(parent->_transitions.size(), _generation);
+        _tchanged[transition] = _generation;
+    }
+
+    void Reducer::touchInhibitor(uint32_t place)
+    {
+        touchPlace(place);
+        for(auto t : parent->_places[place].consumers)
+            touchTransition(t);
+        for(auto t : parent->_places[place].producers)
+            touchTransition(t);
+    }
+
+    bool Reducer::placeChanged(uint32_t place, uint32_t since) const
+    {
+        auto changed = [&](uint32_t t) {
+            return transitionTouched(t, since);
+        };
+        if(placeTouched(place, since))
+            return true;
+        const Place& pl = parent->_places[place];
+        return std::any_of(pl.consumers.begin(), pl.consumers.end(), changed) ||
+               std::any_of(pl.producers.begin(), pl.producers.end(), changed);
+    }
+
+    bool Reducer::transitionChanged(uint32_t transition, uint32_t since) const
+    {
+        auto changed = [&](const Arc& a) {
+            return placeTouched(a.place, since);
+        };
+        if(transitionTouched(transition, since))
+            return true;
+        const Transition& trans = parent->_transitions[transition];
+        return std::any_of(trans.pre.begin(), trans.pre.end(), changed) ||
+               std::any_of(trans.post.begin(), trans.post.end(), changed);
+    }
+
+    void Reducer::resetTracking()
+    {
+        // everything is stamped after generation 0, the last scan of no rule
+        _generation = 1;
+        _pchanged.assign(parent->_places.size(), _generation);
+        _tchanged.assign(parent->_transitions.size(), _generation);
+        _scanA = _scanB = _scanC = _scanD = _scanEP = _scanF = _scanFNO = _scanG = 0;
+    }
+
     bool Reducer::consistent()
     {
 #ifndef NDEBUG
@@ -303,6 +367,8 @@ namespace PetriEngine {
     bool Reducer::ReducebyRuleA(uint32_t* placeInQuery) {
         // Rule A  - find transition t that has exactly one place in pre and post and remove one of the places (and t)
         bool continueReductions = false;
+        const uint32_t since = _fullRescan ? 0 : _scanA;
+        const uint32_t scan = _generation++;
         const size_t numberoftransitions = parent->numberOfTransitions();
         for (uint32_t t = 0; t < numberoftransitions; t++) {
             if(hasTimedout()) return false;
@@ -320,6 +386,9 @@ namespace PetriEngine {
             // A2. Check that pPre goes only to t
             if(parent->_places[pPre].consumers.size() != 1) continue;
 
+            // nothing around t changed since the last scan
+            if(!transitionChanged(t, since)) continue;
+
             // A3. We have weight of more than one on input
             // and is empty on output (should not happen).
             auto w = trans.pre[0].weight;
@@ -374,6 +443,7 @@ namespace PetriEngine {
             {
                 // UA2. move the token for the initial marking, makes things simpler.
                 parent->initialMarking[pPost.place] += ((parent->initialMarking[pPre]/w) * pPost.weight);
+                touchPlace(pPost.place);
             }
             parent->initialMarking[pPre] = 0;
 
@@ -409,11 +479,13 @@ namespace PetriEngine {
                         dest->weight += ((source.weight/w) * pPost.weight);
                     }
                     assert(dest->weight > 0);
+                    touchArc(pPost.place, _t);
                 }
             }
             // UA1. remove place
             skipPlace(pPre);
         } // end of Rule A main for-loop
+        _scanA = scan;
         return continueReductions;
     }
 
@@ -421,6 +493,8 @@ namespace PetriEngine {
 
         // Rule B - find place p that has exactly one transition in pre and exactly one in post and remove the place
         bool continueReductions = false;
+        const uint32_t since = _fullRescan ? 0 : _scanB;
+        const uint32_t scan = _generation++;
         const size_t numberofplaces = parent->numberOfPlaces();
         for (uint32_t p = 0; p < numberofplaces; p++) {
             if(hasTimedout()) return false;
@@ -436,6 +510,9 @@ namespace PetriEngine {
                 place.producers.size() < 1)
                 continue; // no orphan removal
 
+            // nothing around p changed since the last scan
+            if(!placeChanged(p, since)) continue;
+
             auto tIn = place.consumers[0];
 
             // B1. producer is not consumer
@@ -551,6 +628,8 @@ namespace PetriEngine {
 
                  // UB1. Remove place p
                 parent->initialMarking[p] = 0;
+                touchPlace(p);
+                touchTransition(tOut);
                 // We need to remember that when tOut fires, tIn fires just after.
                 // this should fix the trace
 
@@ -573,6 +652,7 @@ namespace PetriEngine {
                         std::sort(parent->_places[arc.place].producers.begin(),
                                   parent->_places[arc.place].producers.end());
                     }
+                    touchArc(arc.place, tOut);
                 }
                 for (auto& arc : in.pre) { // remove tPost
                     if(arc.place == p)
@@ -594,6 +674,7 @@ namespace PetriEngine {
                         std::sort(parent->_places[arc.place].consumers.begin(),
                                   parent->_places[arc.place].consumers.end());
                     }
+                    touchArc(arc.place, tOut);
                 }
 
                 for(auto it = out.post.begin(); it != out.post.end(); ++it)
@@ -620,6 +701,7 @@ namespace PetriEngine {
                 skipTransition(tIn);
             }
         } // end of Rule B main for-loop
+        _scanB = scan;
         assert(consistent());
         return continueReductions;
     }
@@ -627,6 +709,8 @@ namespace PetriEngine {
     bool Reducer::ReducebyRuleC(uint32_t* placeInQuery) {
         // Rule C - Places in parallel where one accumulates tokens while the others disable their post set
         bool continueReductions = false;
+        const uint32_t since = _fullRescan ? 0 : _scanC;
+        const uint32_t scan = _generation++;
         _pflags.resize(parent->_places.size(), 0);
         std::fill(_pflags.begin(), _pflags.end(), 0);
 
@@ -646,6 +730,8 @@ namespace PetriEngine {
                     if (pout.skip) break;
                     auto pid_inner = parent->_transitions[tid_outer].post[aid_inner].place;
                     if (parent->_places[pid_inner].skip) continue;
+                    // neither place changed since the last scan
+                    if (!placeTouched(pid_outer, since) && !placeTouched(pid_inner, since)) continue;
 
                     for (size_t swp = 0; swp < 2; ++swp) {
                         if (hasTimedout()) return false;
@@ -751,6 +837,7 @@ namespace PetriEngine {
                 }
             }
         }
+        _scanC = scan;
         assert(consistent());
         return continueReductions;
     }
@@ -759,6 +846,8 @@ namespace PetriEngine {
         // Rule D - two transitions with the same pre and post and same inhibitor arcs
         // This does not alter the trace.
         bool continueReductions = false;
+        const uint32_t since = _fullRescan ? 0 : _scanD;
+        const uint32_t scan = _generation++;
         _tflags.resize(parent->_transitions.size(), 0);
         std::fill(_tflags.begin(), _tflags.end(), 0);
         bool has_empty_trans = false;
@@ -799,6 +888,9 @@ namespace PetriEngine {
                 // D2. No inhibitors
                 if (tin.inhib) continue;
 
+                // neither transition changed since the last scan
+                if (!transitionTouched(touter, since) && !transitionTouched(tinner, since)) continue;
+
                 for (size_t swp = 0; swp < 2; ++swp) {
                     if(hasTimedout()) return false;
 
@@ -939,6 +1031,7 @@ namespace PetriEngine {
                 }
             }
         } // end of main for loop for rule D
+        _scanD = scan;
         assert(consistent());
         return continueReductions;
     }
@@ -946,6 +1039,8 @@ namespace PetriEngine {
     bool Reducer::ReducebyRuleEP(uint32_t* placeInQuery) {
         // Rule P is an extension on Rule E
         bool continueReductions = false;
+        const uint32_t since = _fullRescan ? 0 : _scanEP;
+        const uint32_t scan = _generation++;
         const size_t numberofplaces = parent->numberOfPlaces();
         for(uint32_t p = 0; p < numberofplaces; ++p)
         {
@@ -954,6 +1049,7 @@ namespace PetriEngine {
             if(place.skip) continue;
             // If more producers, we are guaranteed that one producer have a positive effect on the place, and as such E1 precondition is false
             if(place.producers.size() > place.consumers.size()) continue;
+            if(!placeChanged(p, since)) continue;
 
             bool ok = true;
 
@@ -1027,6 +1123,7 @@ namespace PetriEngine {
                 skipInArc(p, tran);
             }
         }
+        _scanEP = scan;
         assert(consistent());
         return continueReductions;
     }
@@ -1050,6 +1147,8 @@ namespace PetriEngine {
 
     bool Reducer::ReducebyRuleF(uint32_t* placeInQuery) {
         bool continueReductions = false;
+        const uint32_t since = _fullRescan ? 0 : _scanF;
+        const uint32_t scan = _generation++;
         const size_t numberofplaces = parent->numberOfPlaces();
         for(uint32_t p = 0; p < numberofplaces; ++p)
         {
@@ -1059,6 +1158,7 @@ namespace PetriEngine {
             if(place.inhib) continue;
             if(place.producers.size() < place.consumers.size()) continue;
             if(placeInQuery[p] != 0) continue;
+            if(!placeChanged(p, since)) continue;
 
             bool ok = true;
             for(uint32_t cons : place.consumers)
@@ -1094,6 +1194,7 @@ namespace PetriEngine {
             }
 
         }
+        _scanF = scan;
         assert(consistent());
         return continueReductions;
     }
@@ -1105,6 +1206,8 @@ namespace PetriEngine {
         // transitions that are always inhibited (Rule O). If all arcs to a place is removed,
         // then we remove the place too (Rule F).
         bool continueReductions = false;
+        const uint32_t since = _fullRescan ? 0 : _scanFNO;
+        const uint32_t scan = _generation++;
         const size_t numberofplaces = parent->numberOfPlaces();
 
         for (uint32_t p = 0; p < numberofplaces; ++p)
@@ -1112,6 +1215,7 @@ namespace PetriEngine {
             if (hasTimedout()) return false;
             Place& place = parent->_places[p];
             if (place.skip) continue;
+            if (!placeChanged(p, since)) continue;
 
             bool removePlace = placeInQuery[p] == 0;
 
@@ -1222,11 +1326,13 @@ namespace PetriEngine {
                 continueReductions = true;
                 _ruleF++;
             }
-            else if (inhibArcs == 0)
+            else if (inhibArcs == 0 && place.inhib)
             {
                 place.inhib = false;
+                touchInhibitor(p);
             }
         }
+        _scanFNO = scan;
         assert(consistent());
         return continueReductions;
     }
@@ -1234,6 +1340,8 @@ namespace PetriEngine {
     bool Reducer::ReducebyRuleG(uint32_t* placeInQuery, bool remove_loops, bool remove_consumers) {
         if(!remove_loops) return false;
         bool continueReductions = false;
+        const uint32_t since = _fullRescan ? 0 : _scanG;
+        const uint32_t scan = _generation++;
         for(uint32_t t = 0; t < parent->numberOfTransitions(); ++t)
         {
             if(hasTimedout()) return false;
@@ -1242,6 +1350,7 @@ namespace PetriEngine {
             if(trans.inhib) continue;
             if(trans.pre.size() < trans.post.size()) continue;
             if(!remove_loops && trans.pre.size() == 0) continue;
+            if(!transitionChanged(t, since)) continue;
 
             auto postit = trans.post.begin();
             auto preit = trans.pre.begin();
@@ -1309,6 +1418,7 @@ namespace PetriEngine {
             ++_ruleG;
             skipTransition(t);
         }
+        _scanG = scan;
         assert(consistent());
         return continueReductions;
     }
@@ -1464,6 +1574,7 @@ namespace PetriEngine {
                     }
                 }
                 parent->initialMarking[p1] += parent->initialMarking[p2];
+                touchPlace(p1);
                 skipPlace(p2);
                 assert(placeInQuery[p2] == 0);
             }
@@ -1594,13 +1705,16 @@ namespace PetriEngine {
                 auto& trans = getTransition(t);
                 auto arc = getInArc(p, trans);
                 arc->weight /= mod;
+                touchTransition(t);
             }
             for(auto& t : parent->_places[p].producers)
             {
                 auto& trans = getTransition(t);
                 auto arc = getOutArc(trans, p);
                 arc->weight /= mod;
+                touchTransition(t);
             }
+            touchPlace(p);
             parent->initialMarking[p] /= mod;
             any = true;
         }
@@ -2182,16 +2296,19 @@ namespace PetriEngine {
                 }
                 else
                 {
+                    touchPlace(p);
                     for(auto t : place.consumers)
                     {
                         auto& trans = getTransition(t);
                         auto inArc = getInArc(p, trans);
+                        touchTransition(t);
                         trans.pre.erase(inArc);
                     }
                     for(auto t : place.producers)
                     {
                         auto& trans = getTransition(t);
                         auto arc = getOutArc(trans, p);
+                        touchTransition(t);
                         trans.post.erase(arc);
                     }
                     continue_reductions |= (place.consumers.size() + place.producers.size()) > 0;
@@ -2221,6 +2338,7 @@ namespace PetriEngine {
                         else if((_pflags[p] & CAN_INC) == 0 && inArc->weight > parent->initialMarking[p])
                         {
                             // inhibitor is useless
+                            touchArc(p, t);
                             trans.pre.erase(inArc);
                             place.consumers.erase(place.consumers.begin() + i);
                             ++_ruleP;
@@ -2250,6 +2368,7 @@ namespace PetriEngine {
                         auto out = getOutArc(trans, p);
                         if(out != std::end(trans.post))
                         {
+                            touchArc(p, t);
                             if(out->weight > inArc->weight)
                             {
                                 out->weight -= inArc->weight;
@@ -2362,10 +2481,12 @@ namespace PetriEngine {
             for (const Arc& prearc : tran.pre)
             {
                 parent->initialMarking[prearc.place] -= prearc.weight * k;
+                touchPlace(prearc.place);
             }
             for (const Arc& postarc : tran.post)
             {
                 parent->initialMarking[postarc.place] += postarc.weight * k;
+                touchPlace(postarc.place);
             }
             if(reconstructTrace)
             {
@@ -2526,6 +2647,10 @@ namespace PetriEngine {
                         parent->_places[arc.place].addConsumer(id);
                     for(const auto& arc : newtran.post)
                         parent->_places[arc.place].addProducer(id);
+                    for(const auto& arc : newtran.pre)
+                        touchArc(arc.place, id);
+                    for(const auto& arc : newtran.post)
+                        touchArc(arc.place, id);
                 }
 
                 skipTransition(prod_id);
@@ -2764,6 +2889,13 @@ namespace PetriEngine {
                             }
                             for(const auto& arc : newtran.post)
                                 parent->_places[arc.place].addProducer(id);
+                            for(const auto& arc : newtran.pre)
+                            {
+                                if(arc.inhib) touchInhibitor(arc.place);
+                                else touchArc(arc.place, id);
+                            }
+                            for(const auto& arc : newtran.post)
+                                touchArc(arc.place, id);
                         }
                     } else {
                         // Rule T updates
@@ -2811,6 +2943,13 @@ namespace PetriEngine {
 
                         for(const auto& arc : newtran.post)
                             parent->_places[arc.place].addProducer(id);
+                        for(const auto& arc : newtran.pre)
+                        {
+                            if(arc.inhib) touchInhibitor(arc.place);
+                            else touchArc(arc.place, id);
+                        }
+                        for(const auto& arc : newtran.post)
+                            touchArc(arc.place, id);
                     }
                 }
                 skipTransition(originalConsumers[n]);
@@ -2842,6 +2981,7 @@ namespace PetriEngine {
         this->_timeout = timeout;
         _timer = std::chrono::high_resolution_clock::now();
         assert(consistent());
+        resetTracking();
         constexpr uint32_t explosion_limiter = 6;
 
         this->reconstructTrace = reconstructTrace;
@@ -3017,14 +3157,25 @@ restart:
         _transitionsBeforeReduction.reserve(parent->_transitions.size());
         uint32_t i = 0;
         for (const auto& trans : parent->_transitions) {
+            // transitions of a net loaded with trace data already have their arcs before the first reduction
+            auto [it, inserted] = _transitionsBeforeReduction.try_emplace(*getTransitionName(i));
             for (const auto& arc : trans.pre) {
-                if (!arc.inhib)
-                    _transitionsBeforeReduction[*getTransitionName(i)].emplace_back(getPlaceName(arc.place), arc.weight);
+                if (inserted && !arc.inhib)
+                    it->second.emplace_back(getPlaceName(arc.place), arc.weight);
             }
             ++i;
         }
     }
 
+    void Reducer::copyTraces(const Reducer& other) {
+        _skippedPlaces = other._skippedPlaces;
+        _skippedTransitions = other._skippedTransitions;
+        _initfire = other._initfire;
+        _postfire = other._postfire;
+        _transitionsBeforeReduction = other._transitionsBeforeReduction;
+        _tnameid = other._tnameid;
+    }
+
     void Reducer::postFire(std::ostream& out, const std::string& transition) const
     {
         auto it = _postfire.find(transition);
@@ -4,7 +4,7 @@
 
 namespace PetriEngine {     
     
-    STSolver::STSolver(Reachability::ResultPrinter& printer, const PetriNet& net, PQL::Condition * query, uint32_t depth) : printer(printer), _query(query), _net(net){
+    STSolver::STSolver(Reachability::AbstractHandler& printer, const PetriNet& net, PQL::Condition * query, uint32_t depth) : printer(printer), _query(query), _net(net){
         if(depth == 0){
             _siphonDepth = _net._nplaces;
         } else {
@@ -148,7 +148,7 @@ namespace PetriEngine {
     
     bool STSolver::siphonTrap(std::vector<size_t> siphon, const std::vector<bool>& has_st, const std::set<size_t>& preset, const std::set<size_t>& postset)
     {
-        if(timeout())
+        if(timeout() || aborted())
             return false;
 
         // we can use an inclussion-check to avoid recomputation 
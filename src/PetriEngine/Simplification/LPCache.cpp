@@ -7,20 +7,102 @@
 
 #include "PetriEngine/Simplification/LPCache.h"
 #include "PetriEngine/Simplification/LinearProgram.h"
+#include "PetriEngine/PQL/Contexts.h"
 
+#include <glpk.h>
 
 namespace PetriEngine {
     namespace Simplification {
-        
-            
+        // programs found impossible which are remembered for later programs
+        constexpr size_t max_impossible = 1024;
+        // rows left behind by earlier programs before the state equation is cleaned
+        constexpr int max_retired_rows = 256;
+
         LPCache::LPCache() {
         }
 
 
         LPCache::~LPCache() {
+            if (_lp != nullptr)
+                glp_delete_prob(_lp);
+        }
+
+        glp_prob* LPCache::stateEquation(const PQL::SimplificationContext& context)
+        {
+            if (_lp != nullptr && _net == context.net() && _marking == context.marking())
+                return _lp;
+            if (_lp != nullptr)
+                glp_delete_prob(_lp);
+            _impossible.clear();
+            _net = nullptr;
+            _marking = nullptr;
+            _lp = context.buildBase();
+            if (_lp == nullptr)
+                return nullptr;
+            _net = context.net();
+            _marking = context.marking();
+            _baseRows = glp_get_num_rows(_lp);
+
+            // Set objective, kind and bounds
+            const uint32_t nCol = _net->numberOfTransitions();
+            for (size_t i = 1; i <= nCol; i++) {
+                glp_set_obj_coef(_lp, i, 1);
+                glp_set_col_kind(_lp, i, GLP_IV);
+                glp_set_col_bnds(_lp, i, GLP_LO, 0, std::numeric_limits<double>::infinity());
+            }
+            glp_set_obj_dir(_lp, GLP_MIN);
+            return _lp;
+        }
+
+        void LPCache::releaseRows(glp_prob* lp, int first)
+        {
+            // Removing a basic row keeps the basis valid, removing a non-basic one does not.
+            // The non-basic rows are instead relaxed to free rows and kept until there are too many.
+            std::vector<int> rows(1);
+            const int nRow = glp_get_num_rows(lp);
+            for (int r = first; r <= nRow; ++r) {
+                if (glp_get_row_stat(lp, r) == GLP_BS)
+                    rows.push_back(r);
+                else
+                    glp_set_row_bnds(lp, r, GLP_FR, 0, 0);
+            }
+            if (nRow - (int)(rows.size() - 1) - _baseRows > max_retired_rows) {
+                rows.resize(1);
+                for (int r = _baseRows + 1; r <= nRow; ++r)
+                    rows.push_back(r);
+                glp_del_rows(lp, rows.size() - 1, rows.data());
+                glp_std_basis(lp);
+            }
+            else if (rows.size() > 1)
+                glp_del_rows(lp, rows.size() - 1, rows.data());
+        }
+
+        bool LPCache::knownImpossible(const LinearProgram& program) const
+        {
+            const auto& eqs = program.equations();
+            for (const auto& other : _impossible) {
+                // both are sorted by row, other must be contained in program and be no tighter
+                auto it = eqs.begin();
+                bool contained = true;
+                for (const auto& eq : other.equations()) {
+                    while (it != eqs.end() && it->row < eq.row)
+                        ++it;
+                    if (it == eqs.end() || it->row != eq.row ||
+                        it->lower < eq.lower || it->upper > eq.upper) {
+                        contained = false;
+                        break;
+                    }
+                }
+                if (contained)
+                    return true;
+            }
+            return false;
+        }
+
+        void LPCache::addImpossible(const LinearProgram& program)
+        {
+            if (_impossible.size() < max_impossible)
+                _impossible.push_back(program);
         }
-     
-        
     }
 }
-
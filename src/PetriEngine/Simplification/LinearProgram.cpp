@@ -46,8 +46,19 @@ namespace PetriEngine {
 
         constexpr auto infty = std::numeric_limits<REAL>::infinity();
 
+        static int solve(glp_prob* lp, const glp_smcp& settings)
+        {
+            auto result = glp_simplex(lp, &settings);
+            if (result == GLP_EBADB || result == GLP_ESING || result == GLP_ECOND)
+            {
+                // the basis kept from the previous program does not fit this one, start over
+                glp_std_basis(lp);
+                result = glp_simplex(lp, &settings);
+            }
+            return result;
+        }
+
         bool LinearProgram::isImpossible(const PQL::SimplificationContext& context, uint32_t solvetime) {
-            bool use_ilp = true;
             auto net = context.net();
 
             if (_result != result_t::UKNOWN)
@@ -72,11 +83,20 @@ namespace PetriEngine {
             for (size_t i = 0; i <= nCol; ++i)
                 indir[i] = i;
 
-            auto lp = context.makeBaseLP();
+            LPCache local;
+            auto cache = context.cache() != nullptr ? context.cache() : &local;
+            auto lp = cache->stateEquation(context);
             if (lp == nullptr)
                 return false;
 
-            int rowno = 1 + net->numberOfPlaces();
+            if (cache->knownImpossible(*this))
+            {
+                _result = result_t::IMPOSSIBLE;
+                return true;
+            }
+
+            const int first = glp_get_num_rows(lp) + 1;
+            int rowno = first;
             glp_add_rows(lp, _equations.size());
             for (const auto& eq : _equations) {
                 auto l = eq.row->write_indir(row, indir);
@@ -91,7 +111,7 @@ namespace PetriEngine {
                         if (eq.lower > eq.upper)
                         {
                             _result = result_t::IMPOSSIBLE;
-                            glp_delete_prob(lp);
+                            cache->releaseRows(lp, first);
                             return true;
                         }
                         glp_set_row_bnds(lp, rowno, GLP_DB, eq.lower, eq.upper);
@@ -106,20 +126,13 @@ namespace PetriEngine {
                 if (context.timeout())
                 {
                     // std::cerr << "glpk: construction timeout" << std::endl;
-                    glp_delete_prob(lp);
+                    cache->releaseRows(lp, first);
                     return false;
                 }
             }
 
-            // Set objective, kind and bounds
-            for (size_t i = 1; i <= nCol; i++) {
-                glp_set_obj_coef(lp, i, 1);
-                glp_set_col_kind(lp, i, use_ilp ? GLP_IV : GLP_CV);
-                glp_set_col_bnds(lp, i, GLP_LO, 0, infty);
-            }
-
-            // Minimize the objective
-            glp_set_obj_dir(lp, GLP_MIN);
+            // The objective, kind and bounds of the columns are set by the cache,
+            // the simplex starts from the basis the previous program ended in
             auto stime = glp_time();
             glp_smcp settings;
             glp_init_smcp(&settings);
@@ -127,7 +140,7 @@ namespace PetriEngine {
             settings.tm_lim = timeout;
             settings.presolve = GLP_OFF;
             settings.msg_lev = 0;
-            auto result = glp_simplex(lp, &settings);
+            auto result = solve(lp, settings);
             if (result == GLP_ETMLIM)
             {
                 _result = result_t::UKNOWN;
@@ -174,14 +187,15 @@ namespace PetriEngine {
             {
                 _result = result_t::IMPOSSIBLE;
             }
-            glp_delete_prob(lp);
+            if (_result == result_t::IMPOSSIBLE)
+                cache->addImpossible(*this);
+            cache->releaseRows(lp, first);
 
             return _result == result_t::IMPOSSIBLE;
         }
 
         void LinearProgram::solvePotency(const PQL::SimplificationContext& context, std::vector<uint32_t>& potencies)
         {
-            bool use_ilp = false; // No need to call the ILP solver
             auto net = context.net();
 
             if (_equations.size() == 0 || context.potencyTimeout())
@@ -196,11 +210,14 @@ namespace PetriEngine {
             for (size_t i = 0; i <= nCol; ++i)
                 indir[i] = i;
 
-            auto lp = context.makeBaseLP();
+            LPCache local;
+            auto cache = context.cache() != nullptr ? context.cache() : &local;
+            auto lp = cache->stateEquation(context);
             if (lp == nullptr)
                 return;
 
-            int rowno = 1 + net->numberOfPlaces();
+            const int first = glp_get_num_rows(lp) + 1;
+            int rowno = first;
             glp_add_rows(lp, _equations.size());
             for (const auto& eq : _equations)
             {
@@ -215,7 +232,7 @@ namespace PetriEngine {
                     {
                         if (eq.lower > eq.upper)
                         {
-                            glp_delete_prob(lp);
+                            cache->releaseRows(lp, first);
                             return;
                         }
                         glp_set_row_bnds(lp, rowno, GLP_DB, eq.lower, eq.upper);
@@ -229,28 +246,20 @@ namespace PetriEngine {
 
                 if (context.potencyTimeout())
                 {
-                    glp_delete_prob(lp);
+                    cache->releaseRows(lp, first);
                     return;
                 }
             }
 
-            // Set objective, kind and bounds
-            for (size_t i = 1; i <= nCol; i++)
-            {
-                glp_set_obj_coef(lp, i, 1); // We want to minimize the sum of the number of transitions fired
-                glp_set_col_kind(lp, i, use_ilp ? GLP_IV : GLP_CV);
-                glp_set_col_bnds(lp, i, GLP_LO, 0, infty);
-            }
-
-            // Minimize the objective
-            glp_set_obj_dir(lp, GLP_MIN);
+            // The cache minimizes the sum of the number of transitions fired,
+            // only the LP relaxation is solved so the integer kind of the columns is ignored
             glp_smcp settings;
             glp_init_smcp(&settings);
             auto timeout = context.getPotencyTimeout() * 1000;
             settings.tm_lim = timeout;
             settings.presolve = GLP_OFF;
             settings.msg_lev = 0;
-            auto result = glp_simplex(lp, &settings);
+            auto result = solve(lp, settings);
 
             // if (result == GLP_ETMLIM): do nothing
             if (result == 0)
@@ -271,7 +280,7 @@ namespace PetriEngine {
                 //}
             }
 
-            glp_delete_prob(lp);
+            cache->releaseRows(lp, first);
         }
 
         std::vector<std::pair<double,bool>> LinearProgram::bounds(const PQL::SimplificationContext& context, uint32_t solvetime, const std::vector<uint32_t>& places)
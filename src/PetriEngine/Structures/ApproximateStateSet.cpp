@@ -0,0 +1,214 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "PetriEngine/Structures/ApproximateStateSet.h"
+#include "PetriEngine/Simplification/MurmurHash2.h"
+
+#include <cstring>
+#include <iostream>
+
+namespace PetriEngine {
+    namespace Structures {
+
+        constexpr uint64_t HASH_SEED = 0x5bd1e995;
+        constexpr uint64_t SECOND_HASH_SEED = 0x9e3779b97f4a7c15;
+
+        ApproximateStateSet::ApproximateStateSet(const PetriNet& net, uint32_t kbound, int nplaces)
+        : EncodingStateSetInterface(net, kbound, nplaces)
+        {
+        }
+
+        void ApproximateStateSet::setTable(size_t bytes, uint32_t hashes)
+        {
+            assert(_stored == 0);
+            size_t words = 1;
+            while (words * 2 * sizeof(uint64_t) <= bytes)
+                words *= 2;
+            _hashes = hashes;
+            _table.assign(words, 0);
+            _mask = hashes == 0 ? words - 1 : words * 64 - 1;
+        }
+
+        double ApproximateStateSet::fill() const
+        {
+            if (_hashes == 0)
+                return _stored / static_cast<double>(_table.size());
+            return _set_bits / (_mask + 1.0);
+        }
+
+        double ApproximateStateSet::collisionProbability() const
+        {
+            if (_hashes == 0) // any of the stored fingerprints
+                return _stored / 18446744073709551616.0;
+            // all the bits of the marking are set already
+            return std::pow(static_cast<double>(_set_bits) / (_mask + 1.0), _hashes);
+        }
+
+        bool ApproximateStateSet::contains(uint64_t h1, uint64_t h2) const
+        {
+            if (_hashes == 0) {
+                for (size_t i = h1 & _mask;; i = (i + 1) & _mask) {
+                    if (_table[i] == h1)
+                        return true;
+                    if (_table[i] == 0)
+                        return false;
+                }
+            }
+            for (uint32_t i = 0; i < _hashes; ++i) {
+                size_t bit = (h1 + i * h2) & _mask;
+                if ((_table[bit / 64] & (uint64_t{1} << (bit % 64))) == 0)
+                    return false;
+            }
+            return true;
+        }
+
+        bool ApproximateStateSet::insert(uint64_t h1, uint64_t h2)
+        {
+            if (_hashes == 0) {
+                size_t i = h1 & _mask;
+                for (; _table[i] != 0; i = (i + 1) & _mask) {
+                    if (_table[i] == h1)
+                        return false;
+                }
+                // keep the probe sequences short; once full, new markings are dropped
+                if ((_stored + 1) * 8 > _table.size() * 7) {
+                    if (_dropped++ == 0)
+                        std::cerr << "Warning: the table of " << _table.size() << " fingerprints is full, "
+                                  << "new states are dropped; increase --bitstate-size" << std::endl;
+                    return false;
+                }
+                _table[i] = h1;
+                ++_stored;
+                return true;
+            }
+            bool fresh = false;
+            for (uint32_t i = 0; i < _hashes; ++i) {
+                size_t bit = (h1 + i * h2) & _mask;
+                uint64_t& word = _table[bit / 64];
+                uint64_t flag = uint64_t{1} << (bit % 64);
+                if ((word & flag) == 0) {
+                    word |= flag;
+                    ++_set_bits;
+                    fresh = true;
+                }
+            }
+            if (fresh)
+                ++_stored;
+            return fresh;
+        }
+
+        std::pair<bool, size_t> ApproximateStateSet::add(const State& state)
+        {
+            _discovered++;
+
+            MarkVal sum = 0;
+            bool allsame = true;
+            uint32_t val = 0;
+            uint32_t active = 0;
+            uint32_t last = 0;
+            markingStats(state.marking(), sum, allsame, val, active, last);
+
+            if (_maxTokens < sum)
+                _maxTokens = sum;
+
+            //Check that we're within k-bound
+            if (_kbound != 0 && sum > _kbound)
+                return std::pair<bool, size_t>(false, std::numeric_limits<size_t>::max());
+
+            const int length = _nplaces * sizeof(MarkVal);
+            uint64_t h1 = MurmurHash64A(state.marking(), length, HASH_SEED);
+            // 0 marks an empty slot for hash compaction, and the steps of the bit-probes must be odd
+            uint64_t h2 = _hashes == 0 ? 0 : MurmurHash64A(state.marking(), length, SECOND_HASH_SEED) | 1;
+            if (_hashes == 0 && h1 == 0)
+                h1 = 1;
+
+            const double collision = collisionProbability();
+            if (!insert(h1, h2))
+                return std::pair<bool, size_t>(false, std::numeric_limits<size_t>::max());
+            _omissions += collision;
+
+            unsigned char type = _encoder.getType(sum, active, allsame, val);
+            size_t bytes = _encoder.encode(state.marking(), type);
+            auto* raw = _encoder.scratchpad().const_raw();
+            size_t id = _first + _offsets.size();
+            _offsets.push_back(_base + _encodings.size());
+            _released.push_back(false);
+            _encodings.insert(_encodings.end(), raw, raw + bytes);
+
+            // update the max token bound for each place in the net (only for newly discovered markings)
+            for (uint32_t i = 0; i < _net.numberOfPlaces(); i++)
+            {
+                _maxPlaceBound[i] = std::max<MarkVal>( state.marking()[i],
+                                                        _maxPlaceBound[i]);
+            }
+            return std::pair<bool, size_t>(true, id);
+        }
+
+        void ApproximateStateSet::decode(State& state, size_t id)
+        {
+            if (id < _first + _head || id >= _first + _offsets.size() || _released[id - _first])
+                throw base_error("Marking ", id, " is no longer stored by the approximate passed-list");
+            size_t i = id - _first;
+            size_t begin = _offsets[i] - _base;
+            size_t end = i + 1 < _offsets.size() ? _offsets[i + 1] - _base : _encodings.size();
+            // decode from the scratchpad, which is padded with zeros like the encodings of the ptries
+            _encoder.scratchpad().zero();
+            memcpy(_encoder.scratchpad().raw(), _encodings.data() + begin, end - begin);
+            _encoder.decode(state.marking(), _encoder.scratchpad().raw());
+        }
+
+        std::pair<bool, size_t> ApproximateStateSet::lookup(State& state)
+        {
+            const int length = _nplaces * sizeof(MarkVal);
+            uint64_t h1 = MurmurHash64A(state.marking(), length, HASH_SEED);
+            uint64_t h2 = _hashes == 0 ? 0 : MurmurHash64A(state.marking(), length, SECOND_HASH_SEED) | 1;
+            if (_hashes == 0 && h1 == 0)
+                h1 = 1;
+            return std::make_pair(contains(h1, h2), std::numeric_limits<size_t>::max());
+        }
+
+        void ApproximateStateSet::release(size_t id)
+        {
+            if (id < _first + _head || id >= _first + _offsets.size())
+                return;
+            _released[id - _first] = true;
+            // a depth-first search releases the newest markings
+            while (_offsets.size() > _head && _released.back()) {
+                _encodings.resize(_offsets.back() - _base);
+                _offsets.pop_back();
+                _released.pop_back();
+            }
+            // a breadth-first search releases the oldest
+            while (_head < _offsets.size() && _released[_head])
+                ++_head;
+            if (_head == _offsets.size()) {
+                _first += _offsets.size();
+                _offsets.clear();
+                _released.clear();
+                _encodings.clear();
+                _head = 0;
+                _base = 0;
+            } else if (_head * 2 > _offsets.size()) {
+                _encodings.erase(_encodings.begin(), _encodings.begin() + (_offsets[_head] - _base));
+                _base = _offsets[_head];
+                _offsets.erase(_offsets.begin(), _offsets.begin() + _head);
+                _released.erase(_released.begin(), _released.begin() + _head);
+                _first += _head;
+                _head = 0;
+            }
+        }
+    }
+}
@@ -0,0 +1,349 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "PetriEngine/Structures/ExternalStateSet.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <queue>
+#include <random>
+
+namespace PetriEngine {
+    namespace Structures {
+
+        using record_length_t = uint16_t;
+
+        static int compareRecords(const unsigned char* a, size_t alength, const unsigned char* b, size_t blength)
+        {
+            int c = memcmp(a, b, std::min(alength, blength));
+            if (c != 0)
+                return c;
+            return (alength > blength) - (alength < blength);
+        }
+
+        // sequential reader of a file of length-prefixed encodings
+        class record_reader_t {
+        public:
+            explicit record_reader_t(const std::string& path)
+            : _in(path, std::ios::binary)
+            {
+                advance();
+            }
+
+            bool valid() const { return _valid; }
+
+            const std::vector<unsigned char>& record() const { return _record; }
+
+            void advance()
+            {
+                record_length_t length;
+                _valid = static_cast<bool>(_in.read(reinterpret_cast<char*>(&length), sizeof(length)));
+                if (!_valid)
+                    return;
+                _record.resize(length);
+                if (!_in.read(reinterpret_cast<char*>(_record.data()), length))
+                    throw base_error("Truncated file in the external passed-list");
+            }
+
+        private:
+            std::ifstream _in;
+            std::vector<unsigned char> _record;
+            bool _valid = false;
+        };
+
+        class record_writer_t {
+        public:
+            explicit record_writer_t(const std::string& path)
+            : _path(path), _out(path, std::ios::binary | std::ios::trunc)
+            {
+                if (!_out)
+                    throw base_error("Could not create ", path, " for the external passed-list");
+            }
+
+            void write(const unsigned char* record, size_t length)
+            {
+                record_length_t l = length;
+                _out.write(reinterpret_cast<const char*>(&l), sizeof(l));
+                _out.write(reinterpret_cast<const char*>(record), length);
+                _bytes += sizeof(l) + length;
+                ++_records;
+            }
+
+            void close()
+            {
+                _out.close();
+                if (!_out)
+                    throw base_error("Could not write ", _path, " for the external passed-list");
+            }
+
+            size_t bytes() const { return _bytes; }
+            size_t records() const { return _records; }
+
+        private:
+            std::string _path;
+            std::ofstream _out;
+            size_t _bytes = 0;
+            size_t _records = 0;
+        };
+
+        ExternalStateSet::ExternalStateSet(const PetriNet& net, uint32_t kbound, const std::string& directory, size_t memory)
+        : StateSetInterface(net, kbound), _encoder(_nplaces, kbound), _memory(memory)
+        {
+            // several instances may share the directory
+            std::random_device rd;
+            _prefix = directory + "/verifypn-" + std::to_string(rd()) + std::to_string(rd());
+        }
+
+        ExternalStateSet::~ExternalStateSet()
+        {
+            _layer.reset();
+            for (size_t i = 1; i <= _runs.size(); ++i)
+                std::remove(file("run", i).c_str());
+            std::remove(file("passed").c_str());
+            std::remove(file("layer").c_str());
+            std::remove(file("next").c_str());
+        }
+
+        std::string ExternalStateSet::file(const char* kind, size_t n) const
+        {
+            return _prefix + "-" + kind + (n == 0 ? "" : std::to_string(n));
+        }
+
+        std::pair<bool, size_t> ExternalStateSet::add(const State& state)
+        {
+            _discovered++;
+
+            MarkVal sum = 0;
+            bool allsame = true;
+            uint32_t val = 0;
+            uint32_t active = 0;
+            for (uint32_t i = 0; i < _nplaces; ++i) {
+                const MarkVal m = state.marking()[i];
+                if (m == 0)
+                    continue;
+                if (val != 0 && m != val)
+                    allsame = false;
+                val = std::max(m, val);
+                ++active;
+                sum += m;
+            }
+
+            if (_maxTokens < sum)
+                _maxTokens = sum;
+
+            //Check that we're within k-bound
+            if (_kbound != 0 && sum > _kbound)
+                return std::make_pair(false, std::numeric_limits<size_t>::max());
+
+            // duplicates are only known once merged, so the bounds include them
+            for (uint32_t i = 0; i < _net.numberOfPlaces(); i++)
+            {
+                _maxPlaceBound[i] = std::max<MarkVal>( state.marking()[i],
+                                                        _maxPlaceBound[i]);
+            }
+
+            unsigned char type = _encoder.getType(sum, active, allsame, val);
+            size_t length = _encoder.encode(state.marking(), type);
+            if (length > std::numeric_limits<record_length_t>::max())
+                throw base_error("Marking could not be encoded into less than 2^16 bytes, current limit of the external passed-list");
+
+            _records.push_back(_buffer.size());
+            record_length_t l = length;
+            auto* raw = _encoder.scratchpad().const_raw();
+            _buffer.insert(_buffer.end(), reinterpret_cast<const unsigned char*>(&l), reinterpret_cast<const unsigned char*>(&l) + sizeof(l));
+            _buffer.insert(_buffer.end(), raw, raw + length);
+
+            if (_buffer.size() + _records.size() * sizeof(size_t) >= _memory)
+                flush();
+            return std::make_pair(true, std::numeric_limits<size_t>::max());
+        }
+
+        void ExternalStateSet::flush()
+        {
+            if (_records.empty())
+                return;
+            auto length = [this](size_t offset) {
+                record_length_t l;
+                memcpy(&l, _buffer.data() + offset, sizeof(l));
+                return l;
+            };
+            auto less = [&](size_t a, size_t b) {
+                return compareRecords(_buffer.data() + a + sizeof(record_length_t), length(a),
+                                      _buffer.data() + b + sizeof(record_length_t), length(b)) < 0;
+            };
+            std::sort(_records.begin(), _records.end(), less);
+
+            record_writer_t run(file("run", _runs.size() + 1));
+            for (size_t i = 0; i < _records.size(); ++i) {
+                if (i > 0 && !less(_records[i - 1], _records[i]))
+                    continue;
+                run.write(_buffer.data() + _records[i] + sizeof(record_length_t), length(_records[i]));
+            }
+            run.close();
+            _runs.push_back(run.bytes());
+            _disk += run.bytes();
+            _max_disk = std::max(_max_disk, _disk);
+
+            _buffer.clear();
+            _records.clear();
+        }
+
+        // k-way merges sorted inputs, emitting each distinct record once with the first input holding it
+        template<typename F>
+        static void mergeInputs(std::vector<std::unique_ptr<record_reader_t>>& inputs, F&& emit)
+        {
+            auto greater = [&](size_t a, size_t b) {
+                auto& ra = inputs[a]->record();
+                auto& rb = inputs[b]->record();
+                int c = compareRecords(ra.data(), ra.size(), rb.data(), rb.size());
+                return c > 0 || (c == 0 && a > b);
+            };
+            std::priority_queue<size_t, std::vector<size_t>, decltype(greater)> heap(greater);
+            for (size_t i = 0; i < inputs.size(); ++i) {
+                if (inputs[i]->valid())
+                    heap.push(i);
+            }
+
+            std::vector<unsigned char> last;
+            bool first = true;
+            while (!heap.empty()) {
+                size_t i = heap.top();
+                heap.pop();
+                auto& record = inputs[i]->record();
+                if (first || record != last) {
+                    first = false;
+                    last = record;
+                    emit(last, i);
+                }
+                inputs[i]->advance();
+                if (inputs[i]->valid())
+                    heap.push(i);
+            }
+        }
+
+        void ExternalStateSet::combine()
+        {
+            // merge in passes, so the final merge (which also reads the passed-list) keeps few files open
+            while (_runs.size() >= max_merge_width) {
+                std::vector<size_t> runs;
+                for (size_t first = 1; first <= _runs.size(); first += max_merge_width) {
+                    const size_t last = std::min(_runs.size(), first + max_merge_width - 1);
+                    const size_t into = runs.size() + 1;
+                    if (first == last) {
+                        if (std::rename(file("run", first).c_str(), file("run", into).c_str()) != 0)
+                            throw base_error("Could not replace ", file("run", into), " of the external passed-list");
+                        runs.push_back(_runs[first - 1]);
+                        continue;
+                    }
+                    std::vector<std::unique_ptr<record_reader_t>> inputs;
+                    for (size_t i = first; i <= last; ++i)
+                        inputs.emplace_back(std::make_unique<record_reader_t>(file("run", i)));
+                    record_writer_t run(file("combined"));
+                    mergeInputs(inputs, [&](const std::vector<unsigned char>& record, size_t) {
+                        run.write(record.data(), record.size());
+                    });
+                    inputs.clear();
+                    run.close();
+                    _max_disk = std::max(_max_disk, _disk + run.bytes());
+
+                    for (size_t i = first; i <= last; ++i) {
+                        _disk -= _runs[i - 1];
+                        std::remove(file("run", i).c_str());
+                    }
+                    if (std::rename(file("combined").c_str(), file("run", into).c_str()) != 0)
+                        throw base_error("Could not replace ", file("run", into), " of the external passed-list");
+                    runs.push_back(run.bytes());
+                    _disk += run.bytes();
+                }
+                _runs = std::move(runs);
+            }
+        }
+
+        void ExternalStateSet::merge()
+        {
+            combine();
+
+            // the passed-list is input 0, the runs follow
+            std::vector<std::unique_ptr<record_reader_t>> inputs;
+            inputs.emplace_back(std::make_unique<record_reader_t>(file("passed")));
+            for (size_t i = 1; i <= _runs.size(); ++i)
+                inputs.emplace_back(std::make_unique<record_reader_t>(file("run", i)));
+
+            record_writer_t passed(file("passed", 1));
+            record_writer_t layer(file("next"));
+            // the passed-list comes first among equal records
+            mergeInputs(inputs, [&](const std::vector<unsigned char>& record, size_t i) {
+                passed.write(record.data(), record.size());
+                if (i != 0)
+                    layer.write(record.data(), record.size());
+            });
+            inputs.clear();
+            passed.close();
+            layer.close();
+            _max_disk = std::max(_max_disk, _disk + passed.bytes() + layer.bytes());
+
+            for (size_t i = 1; i <= _runs.size(); ++i)
+                std::remove(file("run", i).c_str());
+            _runs.clear();
+            std::remove(file("passed").c_str());
+            if (std::rename(file("passed", 1).c_str(), file("passed").c_str()) != 0)
+                throw base_error("Could not replace ", file("passed"), " of the external passed-list");
+            std::remove(file("layer").c_str());
+            if (std::rename(file("next").c_str(), file("layer").c_str()) != 0)
+                throw base_error("Could not replace ", file("layer"), " of the external passed-list");
+            _passed = passed.records();
+            _disk = passed.bytes() + layer.bytes();
+        }
+
+        bool ExternalStateSet::nextLayer()
+        {
+            _layer.reset();
+            flush();
+            if (_runs.empty())
+                return false;
+            merge();
+            _layer = std::make_unique<std::ifstream>(file("layer"), std::ios::binary);
+            if (_layer->peek() == std::ifstream::traits_type::eof())
+                return false;
+            ++_layers;
+            return true;
+        }
+
+        void ExternalStateSet::passCollected()
+        {
+            _layer.reset();
+            flush();
+            if (!_runs.empty())
+                merge();
+        }
+
+        bool ExternalStateSet::next(State& state)
+        {
+            if (!_layer)
+                return false;
+            record_length_t length;
+            if (!_layer->read(reinterpret_cast<char*>(&length), sizeof(length)))
+                return false;
+            // decode from the scratchpad, which is padded with zeros like the encodings of the ptries
+            _encoder.scratchpad().zero();
+            if (!_layer->read(reinterpret_cast<char*>(_encoder.scratchpad().raw()), length))
+                throw base_error("Truncated file in the external passed-list");
+            _encoder.decode(state.marking(), _encoder.scratchpad().raw());
+            return true;
+        }
+    }
+}
@@ -0,0 +1,69 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "PetriEngine/Structures/MarkingStore.h"
+
+#include <string_view>
+
+namespace PetriEngine {
+    namespace Structures {
+
+        MarkingStore::MarkingStore(size_t shards)
+        : _tries(shards)
+        {
+        }
+
+        size_t MarkingStore::shard_of(const uchar* data, size_t size) const
+        {
+            if(_tries.size() == 1) return 0;
+            auto h = std::hash<std::string_view>{}(std::string_view((const char*)data, size));
+            return h % _tries.size();
+        }
+
+        std::pair<bool, size_t> MarkingStore::insert(const uchar* data, size_t size)
+        {
+            auto id = shard_of(data, size);
+            auto res = _tries.apply(id, [&](ptrie_t& trie) { return trie.insert(data, size); });
+            if(res.first)
+                ++_size;
+            return std::make_pair(res.first, res.second * _tries.size() + id);
+        }
+
+        std::pair<bool, size_t> MarkingStore::exists(const uchar* data, size_t size)
+        {
+            auto id = shard_of(data, size);
+            auto res = _tries.apply(id, [&](ptrie_t& trie) { return trie.exists(data, size); });
+            return std::make_pair(res.first, res.second * _tries.size() + id);
+        }
+
+        void MarkingStore::unpack(size_t id, uchar* destination)
+        {
+            _tries.apply(id % _tries.size(), [&](ptrie_t& trie) { trie.unpack(id / _tries.size(), destination); });
+        }
+
+        std::pair<bool, size_t> MarkingStoreStateSet::passed_t::insert(const uchar* data, size_t size)
+        {
+            auto id = _store->insert(data, size).second;
+            return std::make_pair(_passed.insert(id).second, id);
+        }
+
+        std::pair<bool, size_t> MarkingStoreStateSet::passed_t::exists(const uchar* data, size_t size)
+        {
+            auto res = _store->exists(data, size);
+            return std::make_pair(res.first && _passed.count(res.second) > 0, res.second);
+        }
+    }
+}
@@ -37,12 +37,26 @@ namespace PetriEngine {
             _size++;
         }
 
+        void PotencyQueue::expand(PQL::DistanceContext *context, const PQL::Condition *query) {
+            if (!_distance || _distance->query() != query)
+                _distance = std::make_shared<PQL::IncrementalDistance>(*context->net(), query);
+            if (_distance->valid())
+                _distance->prepare(context->marking());
+        }
+
+        uint32_t PotencyQueue::distance(PQL::DistanceContext *context, const PQL::Condition *query, uint32_t t) {
+            // the query may have changed since the expansion began
+            if (!_distance || !_distance->valid() || _distance->query() != query)
+                return query->distance(*context);
+            return _distance->distance(context->marking(), t);
+        }
+
         bool PotencyQueue::empty() const {
             return _size == 0;
         }
 
         void PotencyQueue::_initializePotencies(size_t nTransitions, uint32_t initValue) {
-            _queues = std::vector<std::priority_queue<weighted_t>>(nTransitions != 0 ? nTransitions : 1);
+            _queues = std::vector<queue_t>(nTransitions != 0 ? nTransitions : 1);
 
             _potencies.reserve(nTransitions);
             for (uint32_t i = 0; i < nTransitions; i++) {
@@ -52,7 +66,7 @@ namespace PetriEngine {
         }
 
         void PotencyQueue::_initializePotencies(const std::vector<MarkVal> &initPotencies) {
-            _queues = std::vector<std::priority_queue<weighted_t>>(initPotencies.size() != 0 ? initPotencies.size() : 1);
+            _queues = std::vector<queue_t>(initPotencies.size() != 0 ? initPotencies.size() : 1);
 
             _potencies.reserve(initPotencies.size());
             for (auto potency : initPotencies) {
@@ -73,7 +87,11 @@ namespace PetriEngine {
 
         void
         RandomPotencyQueue::push(size_t id, PQL::DistanceContext *context, const PQL::Condition *query, uint32_t t) {
-            uint32_t dist = query->distance(*context);
+            // the queue of a parallel worker may only receive states stolen from the others
+            if (_potencies.empty())
+                this->_initializePotencies(context->net()->numberOfTransitions(), 100);
+
+            uint32_t dist = distance(context, query, t);
 
             if (dist < _currentParentDist) {
                 _potencies[t] += _currentParentDist - dist;
@@ -163,6 +163,23 @@ namespace PetriEngine {
             _queue.emplace(dist, (uint32_t)id);
         }
 
+        void HeuristicQueue::expand(PQL::DistanceContext* context, const PQL::Condition* query)
+        {
+            if(!_distance || _distance->query() != query)
+                _distance = std::make_shared<PQL::IncrementalDistance>(*context->net(), query);
+            if(_distance->valid())
+                _distance->prepare(context->marking());
+        }
+
+        void HeuristicQueue::push(size_t id, PQL::DistanceContext* context,
+            const PQL::Condition* query, uint32_t t)
+        {
+            // the query may have changed since the expansion began
+            if(!_distance || !_distance->valid() || _distance->query() != query)
+                return push(id, context, query);
+            _queue.emplace(_distance->distance(context->marking(), t), (uint32_t)id);
+        }
+
         bool HeuristicQueue::empty() const {
             return _queue.empty();
         }
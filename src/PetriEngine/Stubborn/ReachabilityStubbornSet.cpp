@@ -32,6 +32,9 @@ namespace PetriEngine {
             return true;
         }
         assert(!_queries.empty());
+        std::unique_lock<std::mutex> guard;
+        if (_query_lock != nullptr)
+            guard = std::unique_lock<std::mutex>(*_query_lock);
         for (auto &q : _queries) {
             PetriEngine::PQL::evaluateAndSet(q, PQL::EvaluationContext((*_parent).marking(), &_net));
 
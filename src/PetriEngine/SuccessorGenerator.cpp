@@ -36,9 +36,20 @@ namespace PetriEngine {
         _parent = state;
         _suc_pcounter = pcounter;
         _suc_tcounter = tcounter;
+        _has_enabled = false;
         return true;
     }
 
+    void SuccessorGenerator::computeEnabled() {
+        if (!_kernel)
+            _kernel.emplace(_net);
+        if (_incremental)
+            _kernel->update((*_parent).marking());
+        else
+            _kernel->compute((*_parent).marking());
+        _has_enabled = true;
+    }
+
     void SuccessorGenerator::reset() {
         _suc_pcounter = 0;
         _suc_tcounter = std::numeric_limits<uint32_t>::max();
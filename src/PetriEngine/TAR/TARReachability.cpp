@@ -118,7 +118,7 @@ namespace PetriEngine {
                 state.set_interpolants(_traceset.maximize(_traceset.initial()));
                 waiting.push_back(state);
             }
-            while (!waiting.empty())
+            while (!waiting.empty() && !aborted())
             {
                 if(popDone(waiting, _stepno))
                     continue;  // we have reached the end of the edge-iterator for this part of the trace
@@ -249,6 +249,8 @@ namespace PetriEngine {
             do
             {
                 auto [finished, satisfied] = runTAR(printtrace, solver, use_trans);
+                if(aborted())
+                    return false;
                 if(finished)
                 {
                     if(!satisfied)
@@ -483,6 +485,8 @@ namespace PetriEngine {
                     }
                     Solver solver(_net, state.marking(), queries[i].get(), used);
                     bool res = tryReach(printtrace, solver);
+                    if(aborted())
+                        return;
                     if(res)
                         results[i] = ResultPrinter::Satisfied;
                     else
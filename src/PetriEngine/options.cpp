@@ -84,6 +84,10 @@ void options_t::print(std::ostream& optionsOut) {
 
     optionsOut << ",Struct_Red_Timout=" << reductionTimeout;
 
+    if (reducePerQuery) {
+        optionsOut << ",Reduce_Per_Query=ENABLED";
+    }
+
     if (stubbornreduction) {
         optionsOut << ",Stubborn_Reduction=ENABLED";
     } else {
@@ -110,6 +114,35 @@ void options_t::print(std::ostream& optionsOut) {
 
     optionsOut << ",LPSolve_Timeout=" << lpsolveTimeout;
 
+    if (portfolio) {
+        optionsOut << ",Portfolio=ENABLED,PortfolioMemory=" << portfolioMemory;
+    }
+
+    if (stateCompaction == StateCompaction::Hash) {
+        optionsOut << ",State_Compaction=HASH";
+    } else if (stateCompaction == StateCompaction::Bitstate) {
+        optionsOut << ",State_Compaction=BITSTATE,BitstateSize=" << bitstateSize << ",BitstateHashes=" << bitstateHashes;
+    }
+
+    if (!externalMemory.empty()) {
+        optionsOut << ",External_Memory=" << externalMemory << ",ExternalMemoryBudget=" << externalMemoryBudget;
+    }
+
+    if (!netCache.empty()) {
+        optionsOut << ",Net_Cache=" << netCache;
+    }
+
+    if (maxMemory > 0) {
+        optionsOut << ",Max_Memory=" << maxMemory << ",Memory_Policy=";
+        if (memoryPolicy == MemoryPolicy::Compact) {
+            optionsOut << "COMPACT";
+        } else if (memoryPolicy == MemoryPolicy::Spill) {
+            optionsOut << "SPILL,SpillDirectory=" << spillDirectory;
+        } else {
+            optionsOut << "STOP";
+        }
+    }
+
 
     if (usedctl) {
         if (ctlalgorithm == CTL::CZero) {
@@ -138,6 +171,9 @@ void options_t::print(std::ostream& optionsOut) {
         } else if (colored_sucessor_generator == ColoredSuccessorGeneratorOption::FIXED) {
             optionsOut << ",ColoredSuccessorGenerator=FIXED";
         }
+        if (colored_encoded_waiting_list) {
+            optionsOut << ",ColoredWaitingList=ENCODED";
+        }
     }
 
     optionsOut << "\n";
@@ -178,6 +214,9 @@ void printHelp() {
         "                                       - 1  aggressive reduction (default)\n"
         "                                       - 2  user defined reduction sequence, eg -b 2 1,0 to use colored rules B,A only, and in that order\n"
         "  -d, --reduction-timeout <timeout>    Timeout for structural reductions in seconds (default 60)\n"
+        "  --reduce-per-query                   Reduce a copy of the net for each group of queries mentioning the same places,\n"
+        "                                       instead of one net for all queries (copies are reduced on --cores threads).\n"
+        "                                       One net is still used with --write-reduced, --trace-replay or --net-cache\n"
         "  -D, --colreduction-timeout <timeout> Timeout for colored structural reductions in seconds (default 60)\n"
         "  -q, --query-reduction <timeout>      Query reduction timeout in seconds (default 30)\n"
         "                                       write -q 0 to disable query reduction\n"
@@ -200,6 +239,25 @@ void printHelp() {
         "                                       - aut            Automaton-driven heuristic. Guides search toward states\n"
         "                                                        that satisfy progressing formulae in the automaton.\n"
         "                                       - fire-count     Prioritises transitions that were fired less often.\n"
+        "  --state-compaction <type>            Store the passed states approximately in the reachability engine;\n"
+        "                                       some states may be missed, so only reachable queries can be answered\n"
+        "                                       - hash      64-bit fingerprints of the states (hash compaction)\n"
+        "                                       - bitstate  bits in a fixed size table (bitstate hashing)\n"
+        "  --bitstate-size <megabytes>          Size of the fingerprint or bitstate table, which never grows (default 512)\n"
+        "  --bitstate-hashes <number>           Number of bits set per state in the bitstate table (default 3)\n"
+        "  --external-memory <directory>        Keep the passed states of the reachability engine on disk in <directory>,\n"
+        "                                       removing duplicates a breadth-first layer at a time\n"
+        "  --external-memory-budget <megabytes> Memory for the new states of a layer before they are written to disk\n"
+        "                                       (default 1024)\n"
+        "  --max-memory <megabytes>             Memory budget of the reachability engine (default 0, unbounded);\n"
+        "                                       when it is exceeded the search continues as given by --memory-policy\n"
+        "  --memory-policy <policy>             What to do when the memory budget is exceeded (default compact);\n"
+        "                                       a search exceeding it again is stopped with the queries UNKNOWN\n"
+        "                                       - compact  continue with the states found so far in a hash compaction table\n"
+        "                                       - spill    continue with the states found so far on disk, see --external-memory\n"
+        "                                       (a search on several cores is restarted instead)\n"
+        "                                       - stop     stop with the remaining queries UNKNOWN\n"
+        "  --spill-directory <directory>        Directory used by --memory-policy spill (default .)\n"
         "  -a, --siphon-trap <timeout>          Siphon-Trap analysis timeout in seconds (default 0)\n"
         "      --siphon-depth <place count>     Search depth of siphon (default 0, which counts all places)\n"
         "  -n, --no-statistics                  Do not display any statistics (default is to display it)\n"
@@ -209,6 +267,8 @@ void printHelp() {
         "  -ctl, --ctl-algorithm [<type>]       Verify CTL properties\n"
         "                                       - local     Liu and Smolka's on-the-fly algorithm\n"
         "                                       - czero     local with certain zero extension (default)\n"
+        "                                                   With --cores the workers compute successors concurrently,\n"
+        "                                                   but propagate assignments one at a time under a single lock.\n"
         "  -ltl, --ltl-algorithm [<type>]       Verify LTL properties (default tarjan). If omitted the queries are assumed to be CTL.\n"
         "                                       - ndfs      Nested depth first search algorithm\n"
         "                                       - tarjan    On-the-fly Tarjan's algorithm\n"
@@ -221,16 +281,25 @@ void printHelp() {
         "                                       Useful for seeing the effect of colored reductions, without unfolding\n"
         "  -c, --cpn-overapproximation          Over approximate query on Colored Petri Nets (CPN only)\n"
         "  -C                                   Use explicit colored engine to answer query (CPN only).\n"
-        "                                       Only supports -R, -t, --colored-successor-generator, --interactive-mode and -s options.\n"
+        "                                       Only supports -R, -t, --colored-successor-generator, --colored-encoded-waiting-list,\n"
+        "                                       --interactive-mode and -s options.\n"
         "  --colored-successor-generator        Sets the the successor generator used in the explicit colored engine\n"
         "                                       - fixed   transitions and bindings are traversed in a fixed order\n"
         "                                       - even    transitions and bindings are checked evenly (default)\n"
+        "  --colored-encoded-waiting-list       Keep only the ids of the encoded states in the waiting list of the explicit\n"
+        "                                       colored engine, and decode and fully expand a state when it is popped\n"
         "  --interactive-mode                   Gives the set of fireable transitions and bindings from a marking, the marking is read from stdin (CPN only)"
         "  --disable-cfp                        Disable the computation of possible colors in the Petri Net (CPN only)\n"
         "  --disable-partitioning               Disable the partitioning of colors in the Petri Net (CPN only)\n"
         "  --disable-symmetry-vars              Disable search for symmetric variables (CPN only)\n"
+        "  --lazy-unfolding                     Only unfold the bindings of transitions whose input places may be marked,\n"
+        "                                       leaving out the transitions which can never fire (CPN only)\n"
 #ifdef VERIFYPN_MC_Simplification
-        "  -z, --cores <number of cores>        Number of cores to use (currently only query simplification)\n"
+        "  -z, --cores <number of cores>        Number of cores to use (unfolding, query simplification, reachability, LTL and CTL search)\n"
+        "                                       Of the queries, only CTL queries are solved concurrently\n"
+        "  --portfolio                          Race the explicit search, random walk, TAR, siphon-trap and LP engines\n"
+        "                                       on each reachability query and report the first answer\n"
+        "  --portfolio-memory <megabytes>       Memory budget of each portfolio, exceeding it stops the race (default 0, unbounded)\n"
 #endif
         "  -tar, --trace-abstraction            Enables Trace Abstraction Refinement for reachability properties\n"
         "  --max-intervals <interval count>     The max amount of intervals kept when computing the color fixpoint\n"
@@ -246,6 +315,16 @@ void printHelp() {
         "                                       - 1 Input is binary, output is XML\n"
         "                                       - 2 Output is binary, input is XML\n"
         "                                       - 3 Input and Output is binary\n"
+        "  --binary-net-io <0,1,2,3>            Determines the format of the model-file and of the unfolded and reduced nets written\n"
+        "                                       - 0 PNML for Input and Output\n"
+        "                                       - 1 Input is binary, output is PNML\n"
+        "                                       - 2 Output is binary, input is PNML\n"
+        "                                       - 3 Input and Output is binary\n"
+        "                                       A binary net is loaded without unfolding and keeps what is needed to\n"
+        "                                       reconstruct traces of a reduced net\n"
+        "  --net-cache <directory>              Keep the unfolded and reduced nets in <directory>, keyed by a hash of\n"
+        "                                       the model and the options (and queries) they were computed from, and\n"
+        "                                       load them from there instead of unfolding and reducing again\n"
         "  --write-buchi <filename> [<format>]  Valid for LTL. Write the generated buchi automaton to file. Formats:\n"
         "                                       - dot   (default) Write the buchi in GraphViz Dot format\n"
         "                                       - hoa   Write the buchi in the Hanoi Omega-Automata Format\n"
@@ -467,6 +546,8 @@ bool options_t::parse(int argc, const char** argv) {
             if (sscanf(argv[++i], "%d", &reductionTimeout) != 1) {
                 throw base_error("Argument Error: Invalid reduction timeout argument ", std::quoted(argv[i]));
             }
+        } else if (std::strcmp(argv[i], "--reduce-per-query") == 0) {
+            reducePerQuery = true;
         } else if (std::strcmp(argv[i], "-D") == 0 || std::strcmp(argv[i], "--colreduction-timeout") == 0) {
             if (i == argc - 1) {
                 throw base_error("Missing number after ", std::quoted(argv[i]));
@@ -487,6 +568,70 @@ bool options_t::parse(int argc, const char** argv) {
             if (sscanf(argv[++i], "%u", &siphontrapTimeout) != 1) {
                 throw base_error("Argument Error: Invalid siphon-trap timeout ", std::quoted(argv[i]));
             }
+        } else if (std::strcmp(argv[i], "--state-compaction") == 0) {
+            if (i == argc - 1) {
+                throw base_error("Missing argument to --state-compaction");
+            }
+            if (std::strcmp(argv[i + 1], "hash") == 0) {
+                stateCompaction = StateCompaction::Hash;
+            } else if (std::strcmp(argv[i + 1], "bitstate") == 0) {
+                stateCompaction = StateCompaction::Bitstate;
+            } else {
+                throw base_error("Unknown --state-compaction value ", std::quoted(argv[i + 1]));
+            }
+            ++i;
+        } else if (std::strcmp(argv[i], "--bitstate-size") == 0) {
+            if (i == argc - 1) {
+                throw base_error("Missing number after ", std::quoted(argv[i]));
+            }
+            if (sscanf(argv[++i], "%zu", &bitstateSize) != 1 || bitstateSize == 0) {
+                throw base_error("Argument Error: Invalid bitstate size ", std::quoted(argv[i]));
+            }
+        } else if (std::strcmp(argv[i], "--bitstate-hashes") == 0) {
+            if (i == argc - 1) {
+                throw base_error("Missing number after ", std::quoted(argv[i]));
+            }
+            if (sscanf(argv[++i], "%u", &bitstateHashes) != 1 || bitstateHashes == 0) {
+                throw base_error("Argument Error: Invalid number of bitstate hashes ", std::quoted(argv[i]));
+            }
+        } else if (std::strcmp(argv[i], "--external-memory") == 0) {
+            if (i == argc - 1) {
+                throw base_error("Missing directory after ", std::quoted(argv[i]));
+            }
+            externalMemory = argv[++i];
+        } else if (std::strcmp(argv[i], "--external-memory-budget") == 0) {
+            if (i == argc - 1) {
+                throw base_error("Missing number after ", std::quoted(argv[i]));
+            }
+            if (sscanf(argv[++i], "%zu", &externalMemoryBudget) != 1 || externalMemoryBudget == 0) {
+                throw base_error("Argument Error: Invalid external memory budget ", std::quoted(argv[i]));
+            }
+        } else if (std::strcmp(argv[i], "--max-memory") == 0) {
+            if (i == argc - 1) {
+                throw base_error("Missing number after ", std::quoted(argv[i]));
+            }
+            if (sscanf(argv[++i], "%zu", &maxMemory) != 1) {
+                throw base_error("Argument Error: Invalid memory budget ", std::quoted(argv[i]));
+            }
+        } else if (std::strcmp(argv[i], "--memory-policy") == 0) {
+            if (i == argc - 1) {
+                throw base_error("Missing argument to --memory-policy");
+            }
+            if (std::strcmp(argv[i + 1], "compact") == 0) {
+                memoryPolicy = MemoryPolicy::Compact;
+            } else if (std::strcmp(argv[i + 1], "spill") == 0) {
+                memoryPolicy = MemoryPolicy::Spill;
+            } else if (std::strcmp(argv[i + 1], "stop") == 0) {
+                memoryPolicy = MemoryPolicy::Stop;
+            } else {
+                throw base_error("Unknown --memory-policy value ", std::quoted(argv[i + 1]));
+            }
+            ++i;
+        } else if (std::strcmp(argv[i], "--spill-directory") == 0) {
+            if (i == argc - 1) {
+                throw base_error("Missing directory after ", std::quoted(argv[i]));
+            }
+            spillDirectory = argv[++i];
         } else if (std::strcmp(argv[i], "--siphon-depth") == 0) {
             if (i == argc - 1) {
                 throw base_error("Missing number after ", std::quoted(argv[i]));
@@ -515,6 +660,15 @@ bool options_t::parse(int argc, const char** argv) {
             if (sscanf(argv[++i], "%u", &binary_query_io) != 1 || binary_query_io > 3) {
                 throw base_error("Argument Error: Invalid binary-query-io value ", std::quoted(argv[i]));
             }
+        } else if (std::strcmp(argv[i], "--binary-net-io") == 0) {
+            if (sscanf(argv[++i], "%u", &binary_net_io) != 1 || binary_net_io > 3) {
+                throw base_error("Argument Error: Invalid binary-net-io value ", std::quoted(argv[i]));
+            }
+        } else if (std::strcmp(argv[i], "--net-cache") == 0) {
+            if (i == argc - 1) {
+                throw base_error("Missing directory after ", std::quoted(argv[i]));
+            }
+            netCache = argv[++i];
         } else if (std::strcmp(argv[i], "--write-reduced") == 0) {
             model_out_file = std::string(argv[++i]);
         } else if (std::strcmp(argv[i], "--write-col-reduced") == 0) {
@@ -573,18 +727,29 @@ bool options_t::parse(int argc, const char** argv) {
                 throw base_error("Invalid argument ", std::quoted(argv[i + 1]), " to --colored-successor-generator");
             }
             ++i;
+        } else if (std::strcmp(argv[i], "--colored-encoded-waiting-list") == 0) {
+            colored_encoded_waiting_list = true;
         } else if (std::strcmp(argv[i], "--interactive-mode") == 0) {
             interactive_mode = true;
             ++i;
         }
 #ifdef VERIFYPN_MC_Simplification
-        else if (std::strcmp(argv[i], "-z") == 0) {
+        else if (std::strcmp(argv[i], "-z") == 0 || std::strcmp(argv[i], "--cores") == 0) {
             if (i == argc - 1) {
                 throw base_error("Missing number after ", std::quoted(argv[i]));
             }
-            if (sscanf(argv[++i], "%u", &cores) != 1) {
+            if (sscanf(argv[++i], "%u", &cores) != 1 || cores == 0) {
                 throw base_error("Argument Error: Invalid cores count ", std::quoted(argv[i]));
             }
+        } else if (std::strcmp(argv[i], "--portfolio") == 0) {
+            portfolio = true;
+        } else if (std::strcmp(argv[i], "--portfolio-memory") == 0) {
+            if (i == argc - 1) {
+                throw base_error("Missing number after ", std::quoted(argv[i]));
+            }
+            if (sscanf(argv[++i], "%zu", &portfolioMemory) != 1) {
+                throw base_error("Argument Error: Invalid portfolio memory budget ", std::quoted(argv[i]));
+            }
         }
 #endif
         else if (std::strcmp(argv[i], "--keep-solved") == 0)
@@ -657,6 +822,8 @@ bool options_t::parse(int argc, const char** argv) {
             computeCFP = false;
         } else if (std::strcmp(argv[i], "--disable-partitioning") == 0) {
             computePartition = false;
+        } else if (std::strcmp(argv[i], "--lazy-unfolding") == 0) {
+            lazyUnfolding = true;
         } else if (std::strcmp(argv[i], "--noverify") == 0) {
             doVerification = false;
         } else if (std::strcmp(argv[i], "--nounfold") == 0) {
@@ -757,6 +924,9 @@ bool options_t::parse(int argc, const char** argv) {
         if (siphonDepth != 0) {
             throw base_error("Argument Error: --siphon-depth is not compatible with LTL model checking.");
         }
+        if (portfolio) {
+            throw base_error("Argument Error: --portfolio is not compatible with LTL model checking.");
+        }
         if(strategy != Strategy::DFS &&
            strategy != Strategy::RDFS &&
            strategy != Strategy::HEUR &&
@@ -769,6 +939,35 @@ bool options_t::parse(int argc, const char** argv) {
         }
     }
 
+    if (portfolio && trace != TraceLevel::None) {
+        throw base_error("Argument Error: --portfolio is not compatible with trace generation.");
+    }
+
+    if (stateCompaction != StateCompaction::None) {
+        if (logic == TemporalLogic::LTL) {
+            throw base_error("Argument Error: --state-compaction is not compatible with LTL model checking.");
+        }
+        if (trace != TraceLevel::None) {
+            throw base_error("Argument Error: --state-compaction is not compatible with trace generation.");
+        }
+    }
+
+    if (!externalMemory.empty()) {
+        if (logic == TemporalLogic::LTL) {
+            throw base_error("Argument Error: --external-memory is not compatible with LTL model checking.");
+        }
+        if (trace != TraceLevel::None) {
+            throw base_error("Argument Error: --external-memory is not compatible with trace generation.");
+        }
+        if (stateCompaction != StateCompaction::None) {
+            throw base_error("Argument Error: --external-memory is not compatible with --state-compaction.");
+        }
+    }
+
+    if (maxMemory > 0 && portfolio) {
+        throw base_error("Argument Error: --max-memory is not compatible with --portfolio, see --portfolio-memory.");
+    }
+
     if (false && replay_trace && logic != TemporalLogic::LTL) {
         throw base_error("Argument Error: Trace replay_trace is only supported for LTL model checking.");
     }
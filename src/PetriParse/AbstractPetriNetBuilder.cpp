@@ -1,6 +1,7 @@
 
 #include "utils/errors.h"
 #include "PetriParse/PNMLParser.h"
+#include "utils/MappedFile.h"
 
 #include <fstream>
 #include <iomanip>
@@ -10,16 +11,16 @@
 namespace PetriEngine {
     void AbstractPetriNetBuilder::parse_model(const std::string& model)
     {
-        std::ifstream mfile(model, std::ifstream::in);
-        if (!mfile) {
+        MappedFile mfile(model);
+        if (!mfile.is_open()) {
             throw base_error("Model file ", std::quoted(model), " could not be opened");
         }
         try {
-            parse_model(mfile);
+            PNMLParser parser;
+            parser.parse(mfile, this);
         } catch(const base_error& err) {
             throw base_error("Model file ", std::quoted(model), "\n\t", err.what());
         }
-        mfile.close();
     }
 
     void AbstractPetriNetBuilder::parse_model(std::istream& model)
@@ -24,6 +24,7 @@
 #include <iostream>
 #include <limits>
 #include <cstring>
+#include <algorithm>
 
 
 #include "PetriParse/PNMLParser.h"
@@ -37,6 +38,43 @@ using namespace PetriEngine::Colored;
 
 void PNMLParser::parse(std::istream& xml,
         AbstractPetriNetBuilder* builder) {
+    std::vector<char> buffer((std::istreambuf_iterator<char>(xml)), std::istreambuf_iterator<char>());
+    buffer.push_back('\0');
+    parseDocument(&buffer[0], builder);
+}
+
+void PNMLParser::parse(MappedFile& file,
+        AbstractPetriNetBuilder* builder) {
+    if (streamable(file.data(), file.size())) {
+        //Clear any left overs
+        id2name.clear();
+        arcs.clear();
+        _transitions.clear();
+        colorTypes.clear();
+        placeTypeContext = "";
+        hasPartition = false;
+        isColored = false;
+
+        this->builder = builder;
+        parseStream(file.data(), file.size());
+        this->builder = nullptr;
+
+        id2name.clear();
+        arcs.clear();
+        _transitions.clear();
+        builder->sort();
+    } else if (file.terminated()) {
+        // rapidxml parses in place, which only copies the pages it writes to
+        parseDocument(file.data(), builder);
+    } else {
+        std::vector<char> buffer(file.data(), file.data() + file.size());
+        buffer.push_back('\0');
+        parseDocument(&buffer[0], builder);
+    }
+}
+
+void PNMLParser::parseDocument(char* text,
+        AbstractPetriNetBuilder* builder) {
     //Clear any left overs
     id2name.clear();
     arcs.clear();
@@ -50,9 +88,7 @@ void PNMLParser::parse(std::istream& xml,
 
     //Parse the xml
     rapidxml::xml_document<> doc;
-    std::vector<char> buffer((std::istreambuf_iterator<char>(xml)), std::istreambuf_iterator<char>());
-    buffer.push_back('\0');
-    doc.parse<0>(&buffer[0]);
+    doc.parse<0>(text);
 
     rapidxml::xml_node<>* root = doc.first_node();
     if(strcmp(root->name(), "pnml") != 0)
@@ -82,47 +118,8 @@ void PNMLParser::parse(std::istream& xml,
         }
 
     //Add all the arcs
-    for (auto & arc : arcs) {
-        auto a = arc;
-
-        //Check that source id exists
-        if (id2name.find(arc.source) == id2name.end()) {
-            fprintf(stderr,
-                    "XML Parsing error: Arc source with id=\"%s\" wasn't found!\n",
-                    arc.source.c_str());
-            continue;
-        }
-        //Check that target id exists
-        if (id2name.find(arc.target) == id2name.end()) {
-            fprintf(stderr,
-                    "XML Parsing error: Arc target with id=\"%s\" wasn't found!\n",
-                    arc.target.c_str());
-            continue;
-        }
-        //Find source and target
-        NodeName source = id2name[arc.source];
-        NodeName target = id2name[arc.target];
-
-        if (source.isPlace && !target.isPlace) {
-            if (!isColored) {
-                builder->addInputArc(source.id, target.id, arc.inhib, arc.weight);
-            } else {
-                builder->addInputArc(source.id, target.id, arc.expr, arc.inhib ? arc.weight : 0);
-            }
-
-        } else if (!source.isPlace && target.isPlace) {
-            if (!isColored) {
-                builder->addOutputArc(source.id, target.id, arc.weight);
-            } else {
-                builder->addOutputArc(source.id, target.id, arc.expr);
-            }
-        } else {
-            fprintf(stderr,
-                    "XML Parsing error: Arc from \"%s\" to \"%s\" is neither input nor output!\n",
-                    source.id.c_str(),
-                    target.id.c_str());
-        }
-    }
+    for (auto & arc : arcs)
+        addArc(arc);
 
     //Unset the builder
     this->builder = nullptr;
@@ -135,6 +132,46 @@ void PNMLParser::parse(std::istream& xml,
     builder->sort();
 }
 
+void PNMLParser::addArc(const Arc& arc) {
+    //Check that source id exists
+    if (id2name.find(arc.source) == id2name.end()) {
+        fprintf(stderr,
+                "XML Parsing error: Arc source with id=\"%s\" wasn't found!\n",
+                arc.source.c_str());
+        return;
+    }
+    //Check that target id exists
+    if (id2name.find(arc.target) == id2name.end()) {
+        fprintf(stderr,
+                "XML Parsing error: Arc target with id=\"%s\" wasn't found!\n",
+                arc.target.c_str());
+        return;
+    }
+    //Find source and target
+    NodeName source = id2name[arc.source];
+    NodeName target = id2name[arc.target];
+
+    if (source.isPlace && !target.isPlace) {
+        if (!isColored) {
+            builder->addInputArc(source.id, target.id, arc.inhib, arc.weight);
+        } else {
+            builder->addInputArc(source.id, target.id, arc.expr, arc.inhib ? arc.weight : 0);
+        }
+
+    } else if (!source.isPlace && target.isPlace) {
+        if (!isColored) {
+            builder->addOutputArc(source.id, target.id, arc.weight);
+        } else {
+            builder->addOutputArc(source.id, target.id, arc.expr);
+        }
+    } else {
+        fprintf(stderr,
+                "XML Parsing error: Arc from \"%s\" to \"%s\" is neither input nor output!\n",
+                source.id.c_str(),
+                target.id.c_str());
+    }
+}
+
 void PNMLParser::parseDeclarations(rapidxml::xml_node<>* element) {
     for (auto it = element->first_node(); it; it = it->next_sibling()) {
         if (strcmp(it->name(), "namedsort") == 0) {
@@ -1007,3 +1044,261 @@ const Color* PNMLParser::findColorForIntRange(const char* value, const char* sta
     }
     throw base_error("Could not find color: ", value, "\nCANNOT_COMPUTE\n");
 }
+
+bool PNMLParser::streamable(const char* data, size_t size) {
+    // colored nets are built from the DOM, a tag in a comment just means we do so needlessly
+    static const std::string_view colored[] = {"declaration", "hlinitialMarking", "hlinscription", "condition", "type"};
+    if (size == 0)
+        return true;
+    for (const char* it = data, *end = data + size;
+         (it = static_cast<const char*>(memchr(it, '<', end - it))) != nullptr; ++it) {
+        std::string_view tag(it + 1, std::min<size_t>(end - it - 1, 18));
+        for (auto& name : colored) {
+            if (tag.size() > name.size() && tag.compare(0, name.size(), name) == 0 &&
+                (std::isspace(tag[name.size()]) || tag[name.size()] == '>' || tag[name.size()] == '/'))
+                return false;
+        }
+    }
+    return true;
+}
+
+void PNMLParser::parseStream(const char* data, size_t size) {
+    XMLPullReader reader(data, data + size);
+    auto event = reader.next();
+    while (event == XMLPullReader::TEXT)
+        event = reader.next();
+    if (event != XMLPullReader::START || reader.name() != "pnml")
+    {
+        throw base_error("expecting <pnml> tag as root-node in xml tree.");
+    }
+
+    streamElement(reader);
+
+    // the arcs which came before their place or transition
+    for (auto & arc : arcs)
+        addArc(arc);
+}
+
+void PNMLParser::streamElement(XMLPullReader& reader) {
+    while (reader.child()) {
+        auto name = reader.name();
+        if (name == "place") {
+            streamPlace(reader);
+        } else if (name == "transition") {
+            streamTransition(reader);
+        } else if (name == "arc" || name == "inputArc" || name == "outputArc") {
+            streamArc(reader, false);
+        } else if (name == "transportArc") {
+            streamTransportArc(reader);
+        } else if (name == "inhibitorArc") {
+            streamArc(reader, true);
+        } else if (name == "variable") {
+            throw base_error("variable not supported");
+        } else if (name == "queries") {
+            streamQueries(reader);
+        } else if (name == "k-bound") {
+            throw base_error("k-bound should be given as command line option -k");
+        } else if (name == "query") {
+            throw base_error("query tag not supported, please use PQL or XML-style queries instead");
+        } else {
+            streamElement(reader);
+        }
+    }
+}
+
+static std::string requiredAttribute(const XMLPullReader& reader, const char* attribute) {
+    std::string value;
+    if (!reader.attribute(attribute, value))
+        throw base_error("Missing attribute '", attribute, "' on <", reader.name(), "> at offset ", reader.offset());
+    return value;
+}
+
+void PNMLParser::streamPlace(XMLPullReader& reader) {
+    double x = 0, y = 0;
+    std::string id = requiredAttribute(reader, "id");
+
+    std::string text;
+    uint64_t initialMarking = 0;
+    if (reader.attribute("initialMarking", text))
+        initialMarking = atoll(text.c_str());
+
+    while (reader.child()) {
+        // name element is ignored
+        if (reader.name() == "graphics") {
+            streamPosition(reader, x, y);
+        } else if (reader.name() == "initialMarking") {
+            text.clear();
+            streamValue(reader, text);
+            initialMarking = atoll(text.c_str());
+        } else {
+            reader.skip();
+        }
+    }
+
+    if(initialMarking > std::numeric_limits<uint32_t>::max())
+    {
+        throw base_error("Number of tokens in ", id, " exceeded ", std::numeric_limits<uint32_t>::max());
+    }
+    builder->addPlace(id, initialMarking, x, y);
+    NodeName nn;
+    nn.id = id;
+    nn.isPlace = true;
+    id2name[id] = std::move(nn);
+}
+
+void PNMLParser::streamTransition(XMLPullReader& reader) {
+    Transition t;
+    t.id = requiredAttribute(reader, "id");
+    std::string player;
+    if (reader.attribute("player", player))
+        t._player = atoi(player.c_str());
+
+    while (reader.child()) {
+        // name element is ignored
+        if (reader.name() == "graphics") {
+            streamPosition(reader, t.x, t.y);
+        } else if (reader.name() == "player") {
+            player.clear();
+            streamValue(reader, player);
+            t._player = atoi(player.c_str());
+        } else if (reader.name() == "conditions") {
+            throw base_error("conditions not supported");
+        } else if (reader.name() == "assignments") {
+            throw base_error("assignments not supported");
+        } else {
+            reader.skip();
+        }
+    }
+
+    // added right away, so the arcs after it need not wait
+    builder->addTransition(t.id, t._player, t.x, t.y);
+    NodeName nn;
+    nn.id = t.id;
+    nn.isPlace = false;
+    id2name[t.id] = std::move(nn);
+}
+
+void PNMLParser::streamArc(XMLPullReader& reader, bool inhibitor) {
+    Arc arc;
+    arc.source = requiredAttribute(reader, "source");
+    arc.target = requiredAttribute(reader, "target");
+    arc.weight = 1;
+
+    std::string text;
+    if (reader.attribute("type", text)) {
+        if (text == "timed")
+            throw base_error("timed arcs are not supported");
+        else if (text == "inhibitor")
+            inhibitor = true;
+    }
+    arc.inhib = inhibitor;
+
+    const bool weightTag = reader.attribute("weight", text);
+    if (weightTag)
+        arc.weight = atoi(text.c_str());
+
+    bool first = true;
+    while (reader.child()) {
+        if (weightTag || reader.name() != "inscription") {
+            reader.skip();
+            continue;
+        }
+        text.clear();
+        streamValue(reader, text);
+        arc.weight = atoi(text.c_str());
+        if(std::find_if(text.begin(), text.end(), [](char c) { return !std::isdigit(c) && !std::isblank(c); }) != text.end())
+        {
+            throw base_error("Found non-integer-text in inscription-tag (weight) on arc from ", arc.source, " to ", arc.target, " with value \"", text, "\". An integer was expected.");
+        }
+        if(!first)
+        {
+            throw base_error("Multiple inscription tags in xml of a arc from ", arc.source, " to ", arc.target, ".");
+        }
+        first = false;
+    }
+
+    if(arc.weight == 0)
+    {
+        throw base_error("Arc from ", arc.source, " to ", arc.target, " has non-sensible weight 0.");
+    }
+    addArcLazily(std::move(arc));
+}
+
+void PNMLParser::streamTransportArc(XMLPullReader& reader) {
+    std::string source = requiredAttribute(reader, "source"),
+           transition = requiredAttribute(reader, "transition"),
+           target = requiredAttribute(reader, "target");
+    int weight = 1;
+
+    while (reader.child()) {
+        if (reader.name() == "inscription") {
+            std::string text;
+            streamValue(reader, text);
+            weight = atoi(text.c_str());
+        } else {
+            reader.skip();
+        }
+    }
+
+    Arc inArc;
+    inArc.source = source;
+    inArc.target = transition;
+    inArc.weight = weight;
+    inArc.inhib = false;
+    addArcLazily(std::move(inArc));
+
+    Arc outArc;
+    outArc.source = transition;
+    outArc.target = target;
+    outArc.weight = weight;
+    outArc.inhib = false;
+    addArcLazily(std::move(outArc));
+}
+
+void PNMLParser::addArcLazily(Arc&& arc) {
+    if (id2name.count(arc.source) > 0 && id2name.count(arc.target) > 0)
+        addArc(arc);
+    else
+        arcs.push_back(std::move(arc));
+}
+
+void PNMLParser::streamQueries(XMLPullReader& reader) {
+    std::string name = requiredAttribute(reader, "name");
+    std::string query;
+    size_t children = 0;
+    while (reader.child()) {
+        ++children;
+        if (reader.name() == "value" || reader.name() == "text")
+            query = reader.content();
+        else
+            streamValue(reader, query);
+    }
+    // one per child, as parseQueries
+    for (size_t i = 0; i < children; ++i) {
+        Query q;
+        q.name = name;
+        q.text = query;
+        this->queries.push_back(q);
+    }
+}
+
+void PNMLParser::streamValue(XMLPullReader& reader, std::string& text) {
+    while (reader.child()) {
+        if (reader.name() == "value" || reader.name() == "text")
+            text = reader.content();
+        else
+            streamValue(reader, text);
+    }
+}
+
+void PNMLParser::streamPosition(XMLPullReader& reader, double& x, double& y) {
+    while (reader.child()) {
+        if (reader.name() == "position") {
+            x = atof(requiredAttribute(reader, "x").c_str());
+            y = atof(requiredAttribute(reader, "y").c_str());
+            reader.skip();
+        } else {
+            streamPosition(reader, x, y);
+        }
+    }
+}
@@ -0,0 +1,241 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PetriParse/XMLPullReader.h"
+#include "utils/errors.h"
+
+#include <cstdlib>
+#include <cstring>
+
+static bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+XMLPullReader::event_t XMLPullReader::next() {
+    if (_closing) {
+        // the end of a self-closing element
+        _closing = false;
+        return END;
+    }
+    while (_pos < _end) {
+        if (*_pos != '<') {
+            auto lt = static_cast<const char*>(memchr(_pos, '<', _end - _pos));
+            if (lt == nullptr)
+                lt = _end;
+            _text = std::string_view(_pos, lt - _pos);
+            _cdata = false;
+            _pos = lt;
+            return TEXT;
+        }
+        std::string_view rest(_pos, _end - _pos);
+        if (rest.compare(0, 2, "<?") == 0) {
+            _pos = find("?>") + 2;
+        } else if (rest.compare(0, 4, "<!--") == 0) {
+            _pos = find("-->") + 3;
+        } else if (rest.compare(0, 9, "<![CDATA[") == 0) {
+            _pos += 9;
+            auto close = find("]]>");
+            _text = std::string_view(_pos, close - _pos);
+            _cdata = true;
+            _pos = close + 3;
+            return TEXT;
+        } else if (rest.compare(0, 2, "<!") == 0) {
+            // the document type, possibly with an internal subset
+            int depth = 0;
+            for (_pos += 2; _pos < _end && (depth > 0 || *_pos != '>'); ++_pos) {
+                if (*_pos == '[') ++depth;
+                else if (*_pos == ']') --depth;
+            }
+            expect('>');
+        } else if (rest.compare(0, 2, "</") == 0) {
+            _pos += 2;
+            auto begin = _pos;
+            _name = std::string_view(begin, scanName() - begin);
+            skipSpace();
+            expect('>');
+            return END;
+        } else {
+            auto begin = ++_pos;
+            _name = std::string_view(begin, scanName() - begin);
+            _attributes.clear();
+            while (true) {
+                skipSpace();
+                if (_pos >= _end)
+                    fail("unterminated start tag");
+                if (*_pos == '/') {
+                    ++_pos;
+                    expect('>');
+                    _closing = true;
+                    return START;
+                }
+                if (*_pos == '>') {
+                    ++_pos;
+                    return START;
+                }
+                begin = _pos;
+                std::string_view attr(begin, scanName() - begin);
+                skipSpace();
+                expect('=');
+                skipSpace();
+                if (_pos >= _end || (*_pos != '"' && *_pos != '\''))
+                    fail("expected a quoted attribute value");
+                auto quote = *_pos++;
+                auto close = static_cast<const char*>(memchr(_pos, quote, _end - _pos));
+                if (close == nullptr)
+                    fail("unterminated attribute value");
+                _attributes.emplace_back(attr, std::string_view(_pos, close - _pos));
+                _pos = close + 1;
+            }
+        }
+    }
+    return DONE;
+}
+
+bool XMLPullReader::attribute(std::string_view name, std::string& value) const {
+    for (auto& [attr, raw] : _attributes) {
+        if (attr == name) {
+            value = decode(raw);
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string XMLPullReader::text() const {
+    return _cdata ? std::string(_text) : decode(_text);
+}
+
+bool XMLPullReader::child() {
+    while (true) {
+        switch (next()) {
+            case START: return true;
+            case END: return false;
+            case TEXT: break;
+            case DONE: fail("unexpected end of document");
+        }
+    }
+}
+
+void XMLPullReader::skip() {
+    for (size_t depth = 1; depth > 0;) {
+        switch (next()) {
+            case START: ++depth; break;
+            case END: --depth; break;
+            case TEXT: break;
+            case DONE: fail("unexpected end of document");
+        }
+    }
+}
+
+std::string XMLPullReader::content() {
+    std::string result;
+    for (size_t depth = 1; depth > 0;) {
+        switch (next()) {
+            case START: ++depth; break;
+            case END: --depth; break;
+            case TEXT:
+                if (depth == 1)
+                    result += text();
+                break;
+            case DONE: fail("unexpected end of document");
+        }
+    }
+    return result;
+}
+
+const char* XMLPullReader::find(const char* what) const {
+    std::string_view rest(_pos, _end - _pos);
+    auto at = rest.find(what);
+    if (at == std::string_view::npos)
+        fail("unexpected end of document");
+    return _pos + at;
+}
+
+const char* XMLPullReader::scanName() {
+    auto begin = _pos;
+    while (_pos < _end && !isSpace(*_pos) && *_pos != '/' && *_pos != '>' && *_pos != '=')
+        ++_pos;
+    if (_pos == begin)
+        fail("expected a name");
+    return _pos;
+}
+
+void XMLPullReader::skipSpace() {
+    while (_pos < _end && isSpace(*_pos))
+        ++_pos;
+}
+
+void XMLPullReader::expect(char c) {
+    if (_pos >= _end || *_pos != c)
+        fail(c == '>' ? "expected '>'" : "expected '='");
+    ++_pos;
+}
+
+void XMLPullReader::fail(const char* message) const {
+    throw base_error("XML parsing error at offset ", offset(), ": ", message);
+}
+
+std::string XMLPullReader::decode(std::string_view raw) {
+    if (raw.find('&') == std::string_view::npos)
+        return std::string(raw);
+    std::string result;
+    result.reserve(raw.size());
+    for (size_t i = 0; i < raw.size(); ++i) {
+        if (raw[i] != '&') {
+            result += raw[i];
+            continue;
+        }
+        auto semi = raw.find(';', i);
+        if (semi == std::string_view::npos) {
+            result += raw[i];
+            continue;
+        }
+        auto entity = raw.substr(i + 1, semi - i - 1);
+        if (entity == "lt") result += '<';
+        else if (entity == "gt") result += '>';
+        else if (entity == "amp") result += '&';
+        else if (entity == "quot") result += '"';
+        else if (entity == "apos") result += '\'';
+        else if (!entity.empty() && entity[0] == '#') {
+            std::string digits(entity.substr(1));
+            unsigned long code = (!digits.empty() && (digits[0] == 'x' || digits[0] == 'X'))
+                    ? strtoul(digits.c_str() + 1, nullptr, 16)
+                    : strtoul(digits.c_str(), nullptr, 10);
+            // as UTF-8
+            if (code < 0x80) {
+                result += (char)code;
+            } else if (code < 0x800) {
+                result += (char)(0xC0 | (code >> 6));
+                result += (char)(0x80 | (code & 0x3F));
+            } else if (code < 0x10000) {
+                result += (char)(0xE0 | (code >> 12));
+                result += (char)(0x80 | ((code >> 6) & 0x3F));
+                result += (char)(0x80 | (code & 0x3F));
+            } else {
+                result += (char)(0xF0 | (code >> 18));
+                result += (char)(0x80 | ((code >> 12) & 0x3F));
+                result += (char)(0x80 | ((code >> 6) & 0x3F));
+                result += (char)(0x80 | (code & 0x3F));
+            }
+        } else {
+            // not an entity we know, kept as is
+            result += raw.substr(i, semi - i + 1);
+        }
+        i = semi;
+    }
+    return result;
+}
@@ -45,13 +45,21 @@
  */
 
 #include "VerifyPN.h"
+#include "PetriEngine/BinaryNet.h"
+#include "utils/MappedFile.h"
 #include "PetriEngine/PQL/Analyze.h"
 #include "PetriEngine/PQL/ContainsVisitor.h"
 #include "PetriEngine/Colored/Reduction/ColoredReducer.h"
 #include "PetriEngine/PQL/ColoredUseVisitor.h"
 #include "LTL/LTLValidator.h"
 #include "LTL/Simplification/SpotToPQL.h"
+#include "LTL/LTLSearch.h"
+#include "PetriEngine/Synthesis/SimpleSynthesis.h"
+#include "PetriEngine/Reachability/ParallelReachabilitySearch.h"
+#include "PetriEngine/Reachability/PortfolioSearch.h"
 
+#include <chrono>
+#include <iomanip>
 #include <mutex>
 
 using namespace PetriEngine;
@@ -130,7 +138,8 @@ bool reduceColored(ColoredPetriNetBuilder &cpnBuilder, std::vector<std::shared_p
 
 std::tuple<PetriNetBuilder, shared_name_name_map, shared_place_color_map>
 unfold(ColoredPetriNetBuilder& cpnBuilder, bool compute_partiton, bool compute_symmetry, bool computed_fixed_point,
-    std::ostream& out, int32_t partitionTimeout, int32_t max_intervals, int32_t intervals_reduced, int32_t interval_timeout, bool over_approx, bool print_bindings) {
+    std::ostream& out, int32_t partitionTimeout, int32_t max_intervals, int32_t intervals_reduced, int32_t interval_timeout, bool over_approx, bool print_bindings,
+    uint32_t threads, bool lazy) {
     Colored::PartitionBuilder partition(cpnBuilder.transitions(), cpnBuilder.places());
 
     if(!cpnBuilder.isColored())
@@ -160,7 +169,7 @@ unfold(ColoredPetriNetBuilder& cpnBuilder, bool compute_partiton, bool compute_s
     }
     else
     {
-        auto r = unfolder.unfold();
+        auto r = unfolder.unfold(threads, lazy);
         if (computed_fixed_point) {
             out << "\nColor fixpoint computed in " << fixed_point.time() << " seconds" << std::endl;
             out << "Max intervals used: " << fixed_point.max_intervals() << std::endl;
@@ -494,6 +503,413 @@ void outputNet(const PetriNetBuilder &builder, std::string out_file) {
     unfoldedNet->toXML(file);
 }
 
+void outputBinaryNet(const PetriNetBuilder &builder, bool colored, const shared_name_name_map& transition_names,
+    const shared_place_color_map& place_names, std::string out_file) {
+    std::fstream file;
+    file.open(out_file, std::ios::binary | std::ios::out);
+    BinaryNet::write(file, builder, colored, transition_names, place_names);
+}
+
+bool unfoldingCacheKey(const options_t& options, std::vector<Condition_ptr>& queries, NetCache::Key& key) {
+    MappedFile model(options.modelfile);
+    if (!model.is_open())
+        return false;
+    std::string_view text(model.data(), model.size());
+    // another release may unfold or reduce differently with the same options
+    key.add(std::string_view("unfolded")).add(std::string_view(VERIFYPN_VERSION)).add(BinaryNet::VERSION).add(text);
+    key.add(options.computePartition).add(options.symmetricVariables).add(options.computeCFP)
+       .add(options.max_intervals).add(options.max_intervals_reduced)
+       .add(options.partitionTimeout).add(options.intervalTimeout).add(options.lazyUnfolding);
+    // colored reductions depend on the queries, a net without colors is never reduced by them
+    if (options.enablecolreduction != 0 && !PNMLParser::streamable(text.data(), text.size())) {
+        key.add(options.enablecolreduction).add(options.colReductionTimeout).add(options.logic);
+        key.add<uint64_t>(options.colreductions.size());
+        for (auto r : options.colreductions)
+            key.add(r);
+        for (auto& q : queries) {
+            std::stringstream ss;
+            q->toString(ss);
+            key.add(std::string_view(ss.str()));
+        }
+    }
+    return true;
+}
+
+NetCache::Key reductionCacheKey(NetCache::Key key, const options_t& options,
+                                std::vector<Condition_ptr>& queries,
+                                const std::vector<ResultPrinter::Result>& results) {
+    key.add(std::string_view("reduced")).add(std::string_view(VERIFYPN_VERSION))
+       .add(options.enablereduction).add(options.reductionTimeout)
+       .add(options.trace != TraceLevel::None);
+    key.add<uint64_t>(options.reductions.size());
+    for (auto r : options.reductions)
+        key.add(r);
+    // the reductions preserve the queries which are not answered yet
+    for (size_t i = 0; i < queries.size(); ++i) {
+        key.add(results[i]);
+        if (results[i] == ResultPrinter::Unknown || results[i] == ResultPrinter::CTL ||
+            results[i] == ResultPrinter::LTL) {
+            std::stringstream ss;
+            queries[i]->toString(ss);
+            key.add(std::string_view(ss.str()));
+        }
+    }
+    return key;
+}
+
+std::vector<std::vector<size_t>> reductionGroups(const PetriNetBuilder& builder, std::vector<Condition_ptr>& queries,
+                                                 const std::vector<ResultPrinter::Result>& results) {
+    std::vector<std::vector<size_t>> groups;
+    // synthesis queries are left to the shared reduction, which rejects them
+    if (std::find(results.begin(), results.end(), ResultPrinter::Synthesis) != results.end())
+        return groups;
+    // the reduction is given by the places the queries mention and the kind of the queries,
+    // queries agreeing on both get the same reduction when reduced together
+    using kind_t = std::tuple<std::vector<uint32_t>, bool, bool, bool, bool>;
+    std::map<kind_t, size_t> kinds;
+    for (size_t i = 0; i < queries.size(); ++i) {
+        if (results[i] != ResultPrinter::Unknown && results[i] != ResultPrinter::CTL &&
+            results[i] != ResultPrinter::LTL)
+            continue;
+        QueryPlaceAnalysisContext context(builder.getPlaceNames(), builder.getTransitionNames(), nullptr);
+        PetriEngine::PQL::analyze(queries[i], context);
+        std::vector<uint32_t> places;
+        for (uint32_t p = 0; p < builder.numberOfPlaces(); ++p) {
+            if (context.getQueryPlaceCount()[p] > 0)
+                places.push_back(p);
+        }
+        LTL::LTLValidator isLtl;
+        const bool is_reach = PetriEngine::PQL::isReachability(queries[i]);
+        kind_t kind(std::move(places), is_reach, is_reach || isLtl.isLTL(queries[i]),
+                    PetriEngine::PQL::isLoopSensitive(queries[i]),
+                    PetriEngine::PQL::containsNext(queries[i]) || PetriEngine::PQL::hasNestedDeadlock(queries[i]));
+        auto [it, inserted] = kinds.emplace(std::move(kind), groups.size());
+        if (inserted)
+            groups.emplace_back();
+        groups[it->second].push_back(i);
+    }
+    return groups;
+}
+
+std::vector<std::unique_ptr<PetriNetBuilder>>
+reducePerQuery(PetriNetBuilder& builder, std::vector<Condition_ptr>& queries,
+               const std::vector<ResultPrinter::Result>& results,
+               const std::vector<std::vector<size_t>>& groups, options_t& options) {
+    std::vector<std::unique_ptr<PetriNetBuilder>> reduced(groups.size());
+    // the copies only read the builder, each group has its own queries
+    auto reduce = [&](size_t g) {
+        auto copy = std::make_unique<PetriNetBuilder>(builder);
+        copy->getReducer()->copyTraces(*builder.getReducer());
+        // the queries of the other groups are seen as answered
+        std::vector<ResultPrinter::Result> groupResults(results.size(), ResultPrinter::Ignore);
+        for (auto i : groups[g])
+            groupResults[i] = results[i];
+        copy->startTimer();
+        copy->reduce(queries, groupResults, options.enablereduction, options.trace != TraceLevel::None, nullptr,
+                     options.reductionTimeout, options.reductions);
+        reduced[g] = std::move(copy);
+    };
+#ifdef VERIFYPN_MC_Simplification
+    std::atomic<size_t> next(0);
+    std::vector<std::thread> threads;
+    for (size_t c = 0; c < std::min<size_t>(options.cores, groups.size()); ++c) {
+        threads.emplace_back([&]() {
+            for (size_t g = next++; g < groups.size(); g = next++)
+                reduce(g);
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+#else
+    for (size_t g = 0; g < groups.size(); ++g)
+        reduce(g);
+#endif
+    return reduced;
+}
+
+int verify(PetriNetBuilder& builder, PetriNet* net, ResultPrinter& printer, options_t& options,
+           std::vector<Condition_ptr>& queries, std::vector<ResultPrinter::Result>& results,
+           std::vector<std::string>& querynames, const shared_name_name_map& transition_names,
+           const shared_place_color_map& place_names)
+{
+    auto verifStart = std::chrono::high_resolution_clock::now();
+    // When this ptr goes out of scope it will print the time spent during verification
+    std::shared_ptr<void> defer (nullptr, [&verifStart](...){
+        auto verifEnd = std::chrono::high_resolution_clock::now();
+        auto diff = std::chrono::duration_cast<std::chrono::microseconds>(verifEnd - verifStart).count() / 1000000.0;
+        std::cout << std::setprecision(6) << "Spent " << diff << " on verification" << std::endl;
+    });
+
+    //----------------------- Verify CTL queries -----------------------//
+    std::vector<size_t> ctl_ids;
+    std::vector<size_t> ltl_ids;
+    std::vector<size_t> synth_ids;
+    for (size_t i = 0; i < queries.size(); ++i) {
+        if (results[i] == ResultPrinter::CTL) {
+            ctl_ids.push_back(i);
+        } else if (results[i] == ResultPrinter::LTL) {
+            ltl_ids.push_back(i);
+        } else if (results[i] == ResultPrinter::Synthesis) {
+            synth_ids.push_back(i);
+        }
+    }
+
+    // Assign indexes
+    if (queries.empty() ||
+        contextAnalysis(options.isCPN && !options.cpnOverApprox, transition_names, place_names, builder, net, queries) != ReturnValue::ContinueCode) {
+        throw base_error("An error occurred while assigning indexes");
+    }
+
+    if (!ctl_ids.empty()) {
+        options.usedctl = true;
+        auto reachabilityStrategy = options.strategy;
+
+        if (options.strategy == Strategy::DEFAULT) options.strategy = Strategy::DFS;
+        auto v = CTLMain(net,
+                         options.ctlalgorithm,
+                         options.strategy,
+                         options.printstatistics,
+                         options.stubbornreduction,
+                         querynames,
+                         queries,
+                         ctl_ids,
+                         options);
+
+        // CTLMain prints the answers itself, like the other engines only a failure to run is returned
+        if (v != ReturnValue::SuccessCode || std::find(results.begin(), results.end(), ResultPrinter::Unknown) == results.end()) {
+            return to_underlying(v);
+        }
+        // go back to previous strategy if the program continues
+        options.strategy = reachabilityStrategy;
+    }
+
+    //----------------------- Verify LTL queries -----------------------//
+
+    if (!ltl_ids.empty() && options.ltlalgorithm != LTL::Algorithm::None) {
+        options.usedltl = true;
+
+        for (auto qid : ltl_ids) {
+            LTL::LTLSearch search(*net, queries[qid], options.buchiOptimization, options.ltl_compress_aps);
+            auto res = search.solve(options.trace != TraceLevel::None, options.kbound,
+                options.ltlalgorithm, options.stubbornreduction ? options.ltl_por : LTL::LTLPartialOrder::None,
+                options.strategy, options.ltlHeuristic, options.ltluseweak, options.seed_offset, options.cores);
+
+            if(options.printstatistics != StatisticsLevel::None)
+                search.print_stats(std::cout);
+
+            std::cout << "FORMULA " << querynames[qid]
+                << (res ? " TRUE" : " FALSE") << " TECHNIQUES EXPLICIT "
+                << LTL::to_string(options.ltlalgorithm)
+                << (search.is_weak() ? " WEAK_SKIP" : "")
+                << (search.used_partial_order() != LTL::LTLPartialOrder::None ? " STUBBORN" : "")
+                << (search.used_partial_order() == LTL::LTLPartialOrder::Visible ? " CLASSIC_STUB" : "")
+                << (search.used_partial_order() == LTL::LTLPartialOrder::Automaton ? " AUT_STUB" : "")
+                << (search.used_partial_order() == LTL::LTLPartialOrder::Liebke ? " LIEBKE_STUB" : "");
+            auto heur = search.heuristic_type();
+            if (!heur.empty())
+                std::cout << " HEURISTIC " << heur;
+            std::cout << " OPTIM-" << to_underlying(options.buchiOptimization) << std::endl;
+
+            std::cout << "\nQuery index " << qid << " was solved\n";
+            std::cout << "Query is " << (res ? "" : "NOT ") << "satisfied." << std::endl;
+
+            if(options.trace != TraceLevel::None)
+                search.print_trace(std::cerr, *builder.getReducer());
+        }
+
+        if (std::find(results.begin(), results.end(), ResultPrinter::Unknown) == results.end()) {
+            return to_underlying(ReturnValue::SuccessCode);
+        }
+    }
+
+
+    for (auto i : synth_ids) {
+        if(options.tar) {
+            throw base_error("TAR not supported for synthesis.");
+        }
+        Synthesis::SimpleSynthesis strategy(*net, *queries[i], options.kbound);
+
+        std::ostream *strategy_out = nullptr;
+
+        results[i] = strategy.synthesize(options.strategy, options.stubbornreduction, false);
+
+        strategy.result().print(querynames[i], options.printstatistics, i, options, std::cout);
+
+        if (options.strategy_output == "-")
+            strategy_out = &std::cout;
+        else if (options.strategy_output.size() > 0)
+            strategy_out = new std::ofstream(options.strategy_output);
+
+        if (strategy_out != nullptr)
+            strategy.print_strategy(*strategy_out);
+
+        if (strategy_out != nullptr && strategy_out != &std::cout)
+            delete strategy_out;
+        if (std::find(results.begin(), results.end(), ResultPrinter::Unknown) == results.end()) {
+            return to_underlying(ReturnValue::SuccessCode);
+        }
+    }
+
+
+#ifdef VERIFYPN_MC_Simplification
+    //------------------------ Portfolio -------------------------//
+
+    bool portfolio = options.portfolio && !options.statespaceexploration && options.externalMemory.empty();
+    for (uint32_t i = 0; i < results.size() && portfolio; ++i)
+        portfolio = results[i] != ResultPrinter::Unknown || !containsUpperBounds(queries[i]);
+    if (portfolio) {
+        for (uint32_t i = 0; i < results.size(); ++i) {
+            if (results[i] == ResultPrinter::Unknown)
+                queries[i] = prepareForReachability(queries[i]);
+        }
+        PortfolioSearch search(printer, *net, builder.getReducer(), options);
+        search.solve(queries, results);
+        return to_underlying(ReturnValue::SuccessCode);
+    }
+#endif
+
+    //----------------------- Siphon Trap ------------------------//
+
+    if (options.siphontrapTimeout > 0) {
+        for (uint32_t i = 0; i < results.size(); i++) {
+            bool isDeadlockQuery = std::dynamic_pointer_cast<DeadlockCondition>(queries[i]) != nullptr;
+
+            if (results[i] == ResultPrinter::Unknown && isDeadlockQuery) {
+                STSolver stSolver(printer, *net, queries[i].get(), options.siphonDepth);
+                stSolver.solve(options.siphontrapTimeout);
+                results[i] = stSolver.printResult();
+                if (results[i] != Reachability::ResultPrinter::Unknown && options.printstatistics == StatisticsLevel::Full) {
+                    std::cout << "Query solved by Siphon-Trap Analysis." << std::endl << std::endl;
+                }
+            }
+        }
+
+        if (std::find(results.begin(), results.end(), ResultPrinter::Unknown) == results.end()) {
+            return to_underlying(ReturnValue::SuccessCode);
+        }
+    }
+    options.siphontrapTimeout = 0;
+
+    //----------------------- Reachability -----------------------//
+
+    // remove the prefix EF/AF (LEGACY, should not be handled here)
+    for(uint32_t i = 0; i < results.size(); ++i)
+    {
+        if(results[i] == ResultPrinter::Unknown)
+            queries[i] = prepareForReachability(queries[i]);
+    }
+    if (options.tar && net->numberOfPlaces() > 0) {
+        //Create reachability search strategy
+        TarResultPrinter tar_printer(printer);
+        TARReachabilitySearch strategy(tar_printer, *net, builder.getReducer(), options.kbound);
+
+        // Change default place-holder to default strategy
+        fprintf(stdout, "Search strategy option was ignored as the TAR engine is called.\n");
+        options.strategy = Strategy::DFS;
+
+        //Reachability search
+        strategy.reachable(queries, results,
+                           options.printstatistics,
+                           options.trace != TraceLevel::None);
+    } else {
+#ifdef VERIFYPN_MC_Simplification
+        ParallelReachabilitySearch strategy(*net, printer, options.cores, options.kbound);
+#else
+        ReachabilitySearch strategy(*net, printer, options.kbound);
+#endif
+
+        strategy.setStateCompaction(options.stateCompaction, options.bitstateSize * 1024 * 1024,
+                                    options.bitstateHashes);
+        if (!options.externalMemory.empty())
+            strategy.setExternalMemory(options.externalMemory, options.externalMemoryBudget * 1024 * 1024);
+        strategy.setMemoryPolicy(options.memoryPolicy, options.spillDirectory);
+
+        // Change default place-holder to default strategy
+        if (options.strategy == Strategy::DEFAULT) options.strategy = Strategy::HEUR;
+
+        //Reachability search
+        if (options.initPotencyTimeout > 0 && (options.strategy == Strategy::RandomWalk || options.strategy == Strategy::RPFS)) {
+            std::vector<MarkVal> initialPotencies(net->numberOfTransitions(), 0);
+
+            {
+                std::unique_ptr<MarkVal[]> qm0(net->makeInitialMarking());
+                initialize_potency(qm0.get(), net, queries, options, std::cout, initialPotencies);
+            }
+
+            strategy.reachable(queries, results,
+                            options.strategy,
+                            options.stubbornreduction,
+                            options.statespaceexploration,
+                            options.printstatistics,
+                            options.trace != TraceLevel::None,
+                            options.seed(),
+                            options.depthRandomWalk,
+                            options.incRandomWalk,
+                            initialPotencies);
+        } else {
+            strategy.reachable(queries, results,
+                            options.strategy,
+                            options.stubbornreduction,
+                            options.statespaceexploration,
+                            options.printstatistics,
+                            options.trace != TraceLevel::None,
+                            options.seed(),
+                            options.depthRandomWalk,
+                            options.incRandomWalk);
+        }
+    }
+    return to_underlying(ReturnValue::SuccessCode);
+}
+
+int verifyPerQuery(PetriNetBuilder& builder, const std::vector<std::vector<size_t>>& groups, options_t& options,
+                   std::vector<Condition_ptr>& queries, std::vector<ResultPrinter::Result>& results,
+                   std::vector<std::string>& querynames, const shared_name_name_map& transition_names,
+                   const shared_place_color_map& place_names)
+{
+    // each group of queries is verified on its own reduction of the net, the groups are
+    // reduced a batch of --cores at a time so only that many copies of the net are alive
+    int ret = to_underlying(ReturnValue::SuccessCode);
+    const size_t batch = std::max<uint32_t>(options.cores, 1);
+    for (size_t first = 0; first < groups.size(); first += batch) {
+        std::vector<std::vector<size_t>> slice(groups.begin() + first,
+                                               groups.begin() + std::min(first + batch, groups.size()));
+        auto reduced = reducePerQuery(builder, queries, results, slice, options);
+        for (size_t g = 0; g < slice.size(); ++g) {
+            auto gbuilder = std::move(reduced[g]);
+            if (options.printstatistics == StatisticsLevel::Full) {
+                std::cout << "\nReduced net of the queries";
+                for (auto i : slice[g])
+                    std::cout << " " << querynames[i];
+                std::cout << std::endl;
+            }
+            printStats(*gbuilder, options);
+            auto net = std::unique_ptr<PetriNet>(gbuilder->makePetriNet());
+            if (options.strategy == Strategy::OverApprox || !options.doVerification)
+                continue;
+
+            // the queries of the other groups may mention places which are not in this net
+            std::vector<Condition_ptr> gqueries(queries.size(), BooleanCondition::TRUE_CONSTANT);
+            std::vector<ResultPrinter::Result> gresults(results.size(), ResultPrinter::Ignore);
+            for (auto i : slice[g]) {
+                gqueries[i] = queries[i];
+                gresults[i] = results[i];
+            }
+            // the engines change the options as they go, every group starts from the same
+            options_t goptions = options;
+            ResultPrinter gprinter(gbuilder.get(), &goptions, querynames);
+            gprinter.setReducer(gbuilder->getReducer());
+            auto gret = verify(*gbuilder, net.get(), gprinter, goptions, gqueries, gresults, querynames,
+                               transition_names, place_names);
+            for (auto i : slice[g])
+                results[i] = gresults[i];
+            // a later group must not hide the failure of an earlier one
+            if (ret == to_underlying(ReturnValue::SuccessCode))
+                ret = gret;
+        }
+    }
+    return ret;
+}
+
 void outputQueries(const PetriNetBuilder &builder, const std::vector<PetriEngine::PQL::Condition_ptr> &queries,
     std::vector<std::string> &querynames, std::string filename, uint32_t binary_query_io, bool keep_solved) {
     std::vector<uint32_t> reorder(queries.size());
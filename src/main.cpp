@@ -49,13 +49,14 @@
 #include <PetriEngine/ExplicitColored/ExplicitColoredInteractiveMode.h>
 #include <PetriEngine/ExplicitColored/ExplicitErrors.h>
 #include <utils/NullStream.h>
+#include <utils/MemoryBudget.h>
 #include "VerifyPN.h"
-#include "PetriEngine/Synthesis/SimpleSynthesis.h"
-#include "LTL/LTLSearch.h"
 #include "PetriEngine/PQL/PQL.h"
 #include "PetriEngine/ExplicitColored/ExplicitColoredPetriNetBuilder.h"
 #include "PetriEngine/ExplicitColored/Algorithms/ExplicitWorklist.h"
 #include "PetriEngine/ExplicitColored/ExplicitColoredModelChecker.h"
+#include "PetriEngine/BinaryNet.h"
+#include "PetriEngine/NetCache.h"
 using namespace PetriEngine;
 using namespace PetriEngine::PQL;
 using namespace PetriEngine::Reachability;
@@ -81,6 +82,7 @@ int main(int argc, const char** argv) {
             std::cout << std::endl;
         }
         options.print();
+        MemoryBudget::setLimit(options.maxMemory * 1024 * 1024);
 
         //----------------------- Parse Query -----------------------//
         std::vector<std::string> querynames;
@@ -89,10 +91,35 @@ int main(int argc, const char** argv) {
                        ? getCTLQueries(ctlStarQueries)
                        : getLTLQueries(ctlStarQueries);
 
+        // a binary net is already unfolded, the colored net is left empty
+        const bool binaryNet = (options.binary_net_io & 1) != 0;
+        if (binaryNet && (options.explicit_colored || options.cpnOverApprox || !options.model_col_out_file.empty())) {
+            std::cerr << "The explicit colored engine, CPN OverApproximation and --write-col-reduced need a PNML model" << std::endl;
+            return to_underlying(ReturnValue::UnknownCode);
+        }
+
+        std::string netImage = binaryNet ? options.modelfile : std::string();
+        std::unique_ptr<NetCache> netCache;
+        NetCache::Key unfoldingKey;
+        // a cached unfolded net is used like a binary net, one which cannot be read is unfolded again
+        std::unique_ptr<NetCache::net_t> cachedNet;
+        if (!options.netCache.empty() && !binaryNet && options.doUnfolding && !options.explicit_colored &&
+            !options.cpnOverApprox && !options.print_bindings && options.model_col_out_file.empty() &&
+            unfoldingCacheKey(options, queries, unfoldingKey)) {
+            netCache = std::make_unique<NetCache>(options.netCache);
+            cachedNet = netCache->load(unfoldingKey, string_set);
+            if (cachedNet && options.printstatistics == StatisticsLevel::Full) {
+                std::cout << "Loading the unfolded net from the net cache: " << cachedNet->file << std::endl;
+            }
+        }
+        const bool cachedUnfolding = cachedNet != nullptr;
+
         ColoredPetriNetBuilder cpnBuilder(string_set);
         try {
-            cpnBuilder.parse_model(options.modelfile);
-            options.isCPN = cpnBuilder.isColored(); // TODO: this is really nasty, should be moved in a refactor
+            if (netImage.empty() && !cachedUnfolding) {
+                cpnBuilder.parse_model(options.modelfile);
+                options.isCPN = cpnBuilder.isColored(); // TODO: this is really nasty, should be moved in a refactor
+            }
             if (options.explicit_colored) {
                 return explicitColored(string_set, options, queries, querynames);
             }
@@ -173,14 +200,35 @@ int main(int argc, const char** argv) {
             options.computePartition, options.symmetricVariables,
             options.computeCFP, out,
             options.partitionTimeout, options.max_intervals, options.max_intervals_reduced,
-            options.intervalTimeout, options.cpnOverApprox, options.print_bindings);
+            options.intervalTimeout, options.cpnOverApprox, options.print_bindings, options.cores,
+            options.lazyUnfolding);
+
+        if (!netImage.empty()) {
+            try {
+                options.isCPN = BinaryNet::read(netImage, builder, transition_names, place_names);
+            } catch (const base_error &err) {
+                throw base_error("CANNOT_COMPUTE\nError parsing the model\n", err.what());
+            }
+        } else if (cachedNet) {
+            builder.takeNet(std::move(cachedNet->builder));
+            options.isCPN = cachedNet->colored;
+            transition_names = std::move(cachedNet->transition_names);
+            place_names = std::move(cachedNet->place_names);
+            cachedNet = nullptr;
+        }
 
         builder.sort();
+        if (netCache && !cachedUnfolding) {
+            netCache->store(unfoldingKey, builder, options.isCPN, transition_names, place_names);
+        }
         std::vector<ResultPrinter::Result> results(queries.size(), ResultPrinter::Result::Unknown);
         ResultPrinter printer(&builder, &options, querynames);
 
         if (options.unfolded_out_file.size() > 0) {
-            outputNet(builder, options.unfolded_out_file);
+            if (options.binary_net_io & 2)
+                outputBinaryNet(builder, options.isCPN, transition_names, place_names, options.unfolded_out_file);
+            else
+                outputNet(builder, options.unfolded_out_file);
         }
 
         //----------------------- Query Simplification -----------------------//
@@ -202,7 +250,7 @@ int main(int argc, const char** argv) {
             }
 
             if (queries.empty() ||
-                contextAnalysis(cpnBuilder.isColored() && !options.cpnOverApprox, transition_names, place_names, b2, qnet.get(), queries) != ReturnValue::ContinueCode) {
+                contextAnalysis(options.isCPN && !options.cpnOverApprox, transition_names, place_names, b2, qnet.get(), queries) != ReturnValue::ContinueCode) {
                 throw base_error("Could not analyze the queries");
             }
 
@@ -310,19 +358,52 @@ int main(int argc, const char** argv) {
         }
 
         builder.freezeOriginalSize();
+
+        std::vector<std::vector<size_t>> groups;
+        // writing, replaying and caching the reduced net need a single net for all queries
+        if (options.reducePerQuery && options.enablereduction > 0 && !options.statespaceexploration &&
+            options.model_out_file.empty() && !options.replay_trace && !netCache)
+            groups = reductionGroups(builder, queries, results);
+        if (groups.size() > 1)
+            return verifyPerQuery(builder, groups, options, queries, results, querynames, transition_names, place_names);
+
         if (options.enablereduction > 0) {
             // Compute structural reductions
             builder.startTimer();
-            builder.reduce(queries, results, options.enablereduction, options.trace != TraceLevel::None, nullptr,
-                           options.reductionTimeout, options.reductions);
+            NetCache::Key reductionKey;
+            // a cached reduced net which cannot be read is reduced again
+            std::unique_ptr<NetCache::net_t> reducedNet;
+            if (netCache) {
+                reductionKey = reductionCacheKey(unfoldingKey, options, queries, results);
+                reducedNet = netCache->load(reductionKey, string_set);
+            }
+            if (reducedNet) {
+                if (options.printstatistics == StatisticsLevel::Full) {
+                    std::cout << "Loading the reduced net from the net cache: " << reducedNet->file << std::endl;
+                }
+                // the names of the colored net are those of the unfolded net
+                builder.takeNet(std::move(reducedNet->builder));
+                reducedNet = nullptr;
+            } else {
+                builder.reduce(queries, results, options.enablereduction, options.trace != TraceLevel::None, nullptr,
+                               options.reductionTimeout, options.reductions);
+                if (netCache) {
+                    netCache->store(reductionKey, builder, options.isCPN, transition_names, place_names);
+                }
+            }
             printer.setReducer(builder.getReducer());
         }
 
         printStats(builder, options);
 
+        // before makePetriNet, which renumbers the places and transitions of the builder
+        if (options.model_out_file.size() > 0 && (options.binary_net_io & 2)) {
+            outputBinaryNet(builder, options.isCPN, transition_names, place_names, options.model_out_file);
+        }
+
         auto net = std::unique_ptr<PetriNet>(builder.makePetriNet());
 
-        if (options.model_out_file.size() > 0) {
+        if (options.model_out_file.size() > 0 && (options.binary_net_io & 2) == 0) {
             std::fstream file;
             file.open(options.model_out_file, std::ios::out);
             net->toXML(file);
@@ -332,7 +413,7 @@ int main(int argc, const char** argv) {
             return to_underlying(ReturnValue::SuccessCode);
 
         if (options.replay_trace) {
-            if (contextAnalysis(cpnBuilder.isColored() && !options.cpnOverApprox, transition_names, place_names, builder, net.get(), queries) != ReturnValue::ContinueCode) {
+            if (contextAnalysis(options.isCPN && !options.cpnOverApprox, transition_names, place_names, builder, net.get(), queries) != ReturnValue::ContinueCode) {
                 throw base_error("Fatal error assigning indexes");
             }
             std::ifstream replay_file(options.replay_file, std::ifstream::in);
@@ -351,217 +432,8 @@ int main(int argc, const char** argv) {
         }
 
         if (options.doVerification) {
-
-            auto verifStart = std::chrono::high_resolution_clock::now();
-            // When this ptr goes out of scope it will print the time spent during verification
-            std::shared_ptr<void> defer (nullptr, [&verifStart](...){
-                auto verifEnd = std::chrono::high_resolution_clock::now();
-                auto diff = std::chrono::duration_cast<std::chrono::microseconds>(verifEnd - verifStart).count() / 1000000.0;
-                std::cout << std::setprecision(6) << "Spent " << diff << " on verification" << std::endl;
-            });
-
-            //----------------------- Verify CTL queries -----------------------//
-            std::vector<size_t> ctl_ids;
-            std::vector<size_t> ltl_ids;
-            std::vector<size_t> synth_ids;
-            for (size_t i = 0; i < queries.size(); ++i) {
-                if (results[i] == ResultPrinter::CTL) {
-                    ctl_ids.push_back(i);
-                } else if (results[i] == ResultPrinter::LTL) {
-                    ltl_ids.push_back(i);
-                } else if (results[i] == ResultPrinter::Synthesis) {
-                    synth_ids.push_back(i);
-                }
-            }
-
-            if (options.replay_trace) {
-                if (contextAnalysis(cpnBuilder.isColored() && !options.cpnOverApprox, transition_names, place_names, builder, net.get(), queries) != ReturnValue::ContinueCode) {
-                    throw base_error("Fatal error assigning indexes");
-                }
-                std::ifstream replay_file(options.replay_file, std::ifstream::in);
-                PetriEngine::TraceReplay replay{replay_file, net.get(), options};
-                for (int i: ltl_ids) {
-                    replay.replay(net.get(), queries[i]);
-                }
-                return to_underlying(ReturnValue::SuccessCode);
-            }
-
-            // Assign indexes
-            if (queries.empty() ||
-                contextAnalysis(cpnBuilder.isColored() && !options.cpnOverApprox, transition_names, place_names, builder, net.get(), queries) != ReturnValue::ContinueCode) {
-                throw base_error("An error occurred while assigning indexes");
-            }
-
-            if (!ctl_ids.empty()) {
-                options.usedctl = true;
-                auto reachabilityStrategy = options.strategy;
-
-                if (options.strategy == Strategy::DEFAULT) options.strategy = Strategy::DFS;
-                auto v = CTLMain(net.get(),
-                                 options.ctlalgorithm,
-                                 options.strategy,
-                                 options.printstatistics,
-                                 options.stubbornreduction,
-                                 querynames,
-                                 queries,
-                                 ctl_ids,
-                                 options);
-
-                if (std::find(results.begin(), results.end(), ResultPrinter::Unknown) == results.end()) {
-                    return to_underlying(v);
-                }
-                // go back to previous strategy if the program continues
-                options.strategy = reachabilityStrategy;
-            }
-
-            //----------------------- Verify LTL queries -----------------------//
-
-            if (!ltl_ids.empty() && options.ltlalgorithm != LTL::Algorithm::None) {
-                options.usedltl = true;
-
-                for (auto qid : ltl_ids) {
-                    LTL::LTLSearch search(*net, queries[qid], options.buchiOptimization, options.ltl_compress_aps);
-                    auto res = search.solve(options.trace != TraceLevel::None, options.kbound,
-                        options.ltlalgorithm, options.stubbornreduction ? options.ltl_por : LTL::LTLPartialOrder::None,
-                        options.strategy, options.ltlHeuristic, options.ltluseweak, options.seed_offset);
-
-                    if(options.printstatistics != StatisticsLevel::None)
-                        search.print_stats(std::cout);
-
-                    std::cout << "FORMULA " << querynames[qid]
-                        << (res ? " TRUE" : " FALSE") << " TECHNIQUES EXPLICIT "
-                        << LTL::to_string(options.ltlalgorithm)
-                        << (search.is_weak() ? " WEAK_SKIP" : "")
-                        << (search.used_partial_order() != LTL::LTLPartialOrder::None ? " STUBBORN" : "")
-                        << (search.used_partial_order() == LTL::LTLPartialOrder::Visible ? " CLASSIC_STUB" : "")
-                        << (search.used_partial_order() == LTL::LTLPartialOrder::Automaton ? " AUT_STUB" : "")
-                        << (search.used_partial_order() == LTL::LTLPartialOrder::Liebke ? " LIEBKE_STUB" : "");
-                    auto heur = search.heuristic_type();
-                    if (!heur.empty())
-                        std::cout << " HEURISTIC " << heur;
-                    std::cout << " OPTIM-" << to_underlying(options.buchiOptimization) << std::endl;
-
-                    std::cout << "\nQuery index " << qid << " was solved\n";
-                    std::cout << "Query is " << (res ? "" : "NOT ") << "satisfied." << std::endl;
-
-                    if(options.trace != TraceLevel::None)
-                        search.print_trace(std::cerr, *builder.getReducer());
-                }
-
-                if (std::find(results.begin(), results.end(), ResultPrinter::Unknown) == results.end()) {
-                    return to_underlying(ReturnValue::SuccessCode);
-                }
-            }
-
-
-            for (auto i : synth_ids) {
-                if(options.tar) {
-                    throw base_error("TAR not supported for synthesis.");
-                }
-                Synthesis::SimpleSynthesis strategy(*net, *queries[i], options.kbound);
-
-                std::ostream *strategy_out = nullptr;
-
-                results[i] = strategy.synthesize(options.strategy, options.stubbornreduction, false);
-
-                strategy.result().print(querynames[i], options.printstatistics, i, options, std::cout);
-
-                if (options.strategy_output == "-")
-                    strategy_out = &std::cout;
-                else if (options.strategy_output.size() > 0)
-                    strategy_out = new std::ofstream(options.strategy_output);
-
-                if (strategy_out != nullptr)
-                    strategy.print_strategy(*strategy_out);
-
-                if (strategy_out != nullptr && strategy_out != &std::cout)
-                    delete strategy_out;
-                if (std::find(results.begin(), results.end(), ResultPrinter::Unknown) == results.end()) {
-                    return to_underlying(ReturnValue::SuccessCode);
-                }
-            }
-
-
-            //----------------------- Siphon Trap ------------------------//
-
-            if (options.siphontrapTimeout > 0) {
-                for (uint32_t i = 0; i < results.size(); i++) {
-                    bool isDeadlockQuery = std::dynamic_pointer_cast<DeadlockCondition>(queries[i]) != nullptr;
-
-                    if (results[i] == ResultPrinter::Unknown && isDeadlockQuery) {
-                        STSolver stSolver(printer, *net, queries[i].get(), options.siphonDepth);
-                        stSolver.solve(options.siphontrapTimeout);
-                        results[i] = stSolver.printResult();
-                        if (results[i] != Reachability::ResultPrinter::Unknown && options.printstatistics == StatisticsLevel::Full) {
-                            std::cout << "Query solved by Siphon-Trap Analysis." << std::endl << std::endl;
-                        }
-                    }
-                }
-
-                if (std::find(results.begin(), results.end(), ResultPrinter::Unknown) == results.end()) {
-                    return to_underlying(ReturnValue::SuccessCode);
-                }
-            }
-            options.siphontrapTimeout = 0;
-
-            //----------------------- Reachability -----------------------//
-
-            // remove the prefix EF/AF (LEGACY, should not be handled here)
-            for(uint32_t i = 0; i < results.size(); ++i)
-            {
-                if(results[i] == ResultPrinter::Unknown)
-                    queries[i] = prepareForReachability(queries[i]);
-            }
-            if (options.tar && net->numberOfPlaces() > 0) {
-                //Create reachability search strategy
-                TarResultPrinter tar_printer(printer);
-                TARReachabilitySearch strategy(tar_printer, *net, builder.getReducer(), options.kbound);
-
-                // Change default place-holder to default strategy
-                fprintf(stdout, "Search strategy option was ignored as the TAR engine is called.\n");
-                options.strategy = Strategy::DFS;
-
-                //Reachability search
-                strategy.reachable(queries, results,
-                                   options.printstatistics,
-                                   options.trace != TraceLevel::None);
-            } else {
-                ReachabilitySearch strategy(*net, printer, options.kbound);
-
-                // Change default place-holder to default strategy
-                if (options.strategy == Strategy::DEFAULT) options.strategy = Strategy::HEUR;
-
-                //Reachability search
-                if (options.initPotencyTimeout > 0 && (options.strategy == Strategy::RandomWalk || options.strategy == Strategy::RPFS)) {
-                    std::vector<MarkVal> initialPotencies(net->numberOfTransitions(), 0);
-
-                    {
-                        std::unique_ptr<MarkVal[]> qm0(net->makeInitialMarking());
-                        initialize_potency(qm0.get(), net.get(), queries, options, std::cout, initialPotencies);
-                    }
-
-                    strategy.reachable(queries, results,
-                                    options.strategy,
-                                    options.stubbornreduction,
-                                    options.statespaceexploration,
-                                    options.printstatistics,
-                                    options.trace != TraceLevel::None,
-                                    options.seed(),
-                                    options.depthRandomWalk,
-                                    options.incRandomWalk,
-                                    initialPotencies);
-                } else {
-                    strategy.reachable(queries, results,
-                                    options.strategy,
-                                    options.stubbornreduction,
-                                    options.statespaceexploration,
-                                    options.printstatistics,
-                                    options.trace != TraceLevel::None,
-                                    options.seed(),
-                                    options.depthRandomWalk,
-                                    options.incRandomWalk);
-                }
-            }
+            return verify(builder, net.get(), printer, options, queries, results, querynames,
+                          transition_names, place_names);
         }
     } catch (base_error& e) {
         std::cerr << "ERROR: " << e.what() << std::endl;
@@ -575,7 +447,18 @@ int main(int argc, const char** argv) {
 int explicitColored(shared_string_set& stringSet, options_t& options, std::vector<Condition_ptr>& queries, const std::vector<std::string>& queryNames) {
     using namespace ExplicitColored;
 
-    if (!options.isCPN || queries.empty() || !isReachability(queries[0])) {
+    // all reachability queries are checked in one exploration of the state space
+    std::vector<Condition_ptr> reachabilityQueries;
+    std::vector<ColoredResultPrinter> resultPrinters;
+    for (size_t i = 0; options.isCPN && i < queries.size(); ++i) {
+        if (isReachability(queries[i])) {
+            reachabilityQueries.push_back(queries[i]);
+            resultPrinters.emplace_back(i, std::cout, queryNames[i], options.seed(), std::cerr);
+        } else {
+            std::cerr << "Query " << i << " is not a reachability query and is skipped by the explicit engine" << std::endl;
+        }
+    }
+    if (!options.isCPN || reachabilityQueries.empty()) {
         std::cerr << "Explicit state-space search is supported only for colored nets and reachability queries.";
         return to_underlying(ReturnValue::UnknownCode);
     }
@@ -588,18 +471,27 @@ int explicitColored(shared_string_set& stringSet, options_t& options, std::vecto
 
         ExplicitColoredModelChecker ecpnChecker(stringSet, fullStatisticsOut);
 
-        ColoredResultPrinter resultPrinter(0, std::cout, queryNames[0], options.seed(), std::cerr);
-        auto result = ecpnChecker.checkQuery(queries[0], options, &resultPrinter);
+        std::vector<IColoredResultPrinter*> printers;
+        for (auto& printer : resultPrinters) {
+            printers.push_back(&printer);
+        }
+        auto results = ecpnChecker.checkQueries(reachabilityQueries, options, printers);
 
-        if (result == ExplicitColoredModelChecker::Result::SATISFIED) {
-            return to_underlying(ReturnValue::SuccessCode);
+        // a skipped query is not answered either
+        if (reachabilityQueries.size() < queries.size()) {
+            return to_underlying(ReturnValue::UnknownCode);
+        }
+        for (auto result : results) {
+            if (result == ExplicitColoredModelChecker::Result::UNKNOWN) {
+                return to_underlying(ReturnValue::UnknownCode);
+            }
         }
 
-        if (result == ExplicitColoredModelChecker::Result::UNSATISFIED) {
+        // the answer of a single query is the return code, several answered queries succeed
+        if (results.size() == 1 && results[0] == ExplicitColoredModelChecker::Result::UNSATISFIED) {
             return to_underlying(ReturnValue::FailedCode);
         }
-
-        return to_underlying(ReturnValue::UnknownCode);
+        return to_underlying(ReturnValue::SuccessCode);
 
     } catch (const explicit_error& e) {
         std::cout << e << std::endl;